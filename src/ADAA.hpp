@@ -0,0 +1,138 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#pragma once
+#include "rack.hpp"
+#include "math.hpp"
+
+namespace Venom {
+
+// Pieces of an ADAA path that change by less than ADAA_EPS plus ADAA_REL_EPS times their magnitude are
+// integrated by Gauss-Legendre quadrature instead, because the closed form antiderivative differences
+// lose too much float precision on short pieces
+static const float ADAA_EPS = 1.f, ADAA_REL_EPS = 0.1f;
+
+// The input of a waveshaper between two samples, treated as a straight line over time t from 0 to 1.
+// The path is stored as points (t, y) with straight lines between them, and is passed through
+// the continuous piecewise linear stages of a waveshaper. Each stage splits the path wherever the
+// stage changes slope, so every piece remains a straight line that can be integrated exactly.
+struct ADAAPath {
+  static const int MAX_POINTS = 48;
+  int cnt = 0;
+  bool overflow = false;
+  float t[MAX_POINTS], y[MAX_POINTS];
+
+  void init(float y0, float y1) {
+    cnt = 2;
+    overflow = false;
+    t[0] = 0.f;
+    t[1] = 1.f;
+    y[0] = y0;
+    y[1] = y1;
+  }
+
+  // Split the path where it crosses any of the n ascending breakpoints bp, then map each point
+  // through the piecewise linear stage function f. If the path runs out of points then the
+  // remaining crossings are skipped and overflow is set, because the path no longer integrates correctly.
+  template <typename F>
+  void apply(F f, const float* bp, int n) {
+    float nt[MAX_POINTS], ny[MAX_POINTS];
+    int nc = 0;
+    for (int i=0; i<cnt; i++) {
+      if (i) {
+        float y0 = y[i-1], y1 = y[i], lo = std::fmin(y0, y1), hi = std::fmax(y0, y1);
+        for (int j=0; j<n; j++) {
+          float b = y1 > y0 ? bp[j] : bp[n-1-j];
+          if (b > lo && b < hi) {
+            if (nc >= MAX_POINTS-cnt+i) {
+              overflow = true;
+              break;
+            }
+            nt[nc] = t[i-1] + (t[i] - t[i-1]) * (b - y0) / (y1 - y0);
+            ny[nc++] = b;
+          }
+        }
+      }
+      nt[nc] = t[i];
+      ny[nc++] = y[i];
+    }
+    cnt = nc;
+    for (int i=0; i<cnt; i++) {
+      t[i] = nt[i];
+      y[i] = f(ny[i]);
+    }
+  }
+
+  // Integral of (w0 + w1*t) * g(y) over the path, where g provides the smooth final shaper g(y)
+  // and its first and second antiderivatives g.ad1(y) and g.ad2(y).
+  template <typename G>
+  float integrate(const G& g, float w0, float w1) const {
+    float sum = 0.f;
+    for (int i=1; i<cnt; i++) {
+      float dt = t[i] - t[i-1], dy = y[i] - y[i-1];
+      if (std::fabs(dy) < ADAA_EPS + ADAA_REL_EPS * std::fmax(std::fabs(y[i]), std::fabs(y[i-1]))) {
+        const float node = 0.5f * std::sqrt(0.6f);
+        float tm = (t[i] + t[i-1]) * 0.5f, ym = (y[i] + y[i-1]) * 0.5f;
+        sum += dt * (
+          (w0 + w1 * (tm - node * dt)) * g(ym - node * dy) * (5.f / 18.f) +
+          (w0 + w1 * tm) * g(ym) * (8.f / 18.f) +
+          (w0 + w1 * (tm + node * dt)) * g(ym + node * dy) * (5.f / 18.f)
+        );
+      } else {
+        float k = dt / dy, a1 = g.ad1(y[i-1]), b1 = g.ad1(y[i]);
+        sum += k * ((w0 + w1 * t[i-1]) * (b1 - a1) + w1 * k * (dy * b1 - (g.ad2(y[i]) - g.ad2(y[i-1]))));
+      }
+    }
+    return sum;
+  }
+};
+
+// Smooth final stage of an ADAA waveshaper: softClip(y * gain) / gain, or no clipping if gain is 0.
+// Waveshapers derive from this and add a linear(ADAAPath&) method that applies their piecewise linear stages.
+struct ADAASoftClip {
+  float gain = 0.f;
+
+  float operator()(float y) const {
+    return gain ? softClip(y * gain) / gain : y;
+  }
+  float ad1(float y) const {
+    return gain ? softClip_ad1(y * gain) / (gain * gain) : y * y * 0.5f;
+  }
+  float ad2(float y) const {
+    return gain ? softClip_ad2(y * gain) / (gain * gain * gain) : y * y * y * (1.f / 6.f);
+  }
+};
+
+// Plain output of waveshaper s for input x, without anti-aliasing
+template <typename S>
+float adaaShape(const S& s, float x) {
+  ADAAPath path;
+  path.init(x, x);
+  s.linear(path);
+  return s(path.y[0]);
+}
+
+// Antiderivative anti-aliased output of waveshaper s given its last three inputs, oldest first.
+// First order averages the shaper output over the last sample period (1/2 sample latency).
+// Second order applies a triangular window over the last two sample periods (1 sample latency).
+// A sample whose path has more breakpoint crossings than ADAAPath can hold falls back to the plain shaper
+// output at the same latency.
+template <typename S>
+float adaaProcess(const S& s, int order, float x0, float x1, float x2) {
+  ADAAPath path;
+  float out = 0.f;
+  if (order > 1) {
+    path.init(x0, x1);
+    s.linear(path);
+    if (path.overflow)
+      return adaaShape(s, x1);
+    out = path.integrate(s, 0.f, 1.f);
+  }
+  path.init(x1, x2);
+  s.linear(path);
+  if (path.overflow)
+    return order > 1 ? adaaShape(s, x1) : adaaShape(s, (x1 + x2) * 0.5f);
+  return order > 1 ? out + path.integrate(s, 1.f, -1.f) : path.integrate(s, 1.f, 0.f);
+}
+
+}
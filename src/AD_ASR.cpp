@@ -519,4 +519,4 @@ struct AD_ASRWidget : VenomWidget {
 
 }
 
-Model* modelVenomAD_ASR = createModel<Venom::AD_ASR, Venom::AD_ASRWidget>("AD_ASR");
+Model* modelVenomAD_ASR = Venom::createVenomModel<Venom::AD_ASR, Venom::AD_ASRWidget>("AD_ASR");
@@ -73,4 +73,4 @@ struct AuxCloneWidget : VenomWidget {
 
 }
 
-Model* modelVenomAuxClone = createModel<Venom::AuxClone, Venom::AuxCloneWidget>("AuxClone");
+Model* modelVenomAuxClone = Venom::createVenomModel<Venom::AuxClone, Venom::AuxCloneWidget>("AuxClone");
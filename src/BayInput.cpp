@@ -90,4 +90,4 @@ std::map<int64_t, BayInput*> BayModule::sources{};
 
 }
 
-Model* modelVenomBayInput = createModel<Venom::BayInput, Venom::BayInputWidget>("BayInput");
+Model* modelVenomBayInput = Venom::createVenomModel<Venom::BayInput, Venom::BayInputWidget>("BayInput");
@@ -81,4 +81,4 @@ struct BayNormWidget : BayOutputModuleWidget {
 
 }
 
-Model* modelVenomBayNorm = createModel<Venom::BayNorm, Venom::BayNormWidget>("BayNorm");
+Model* modelVenomBayNorm = Venom::createVenomModel<Venom::BayNorm, Venom::BayNormWidget>("BayNorm");
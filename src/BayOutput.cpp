@@ -68,4 +68,4 @@ struct BayOutputWidget : BayOutputModuleWidget {
 
 }
 
-Model* modelVenomBayOutput = createModel<Venom::BayOutput, Venom::BayOutputWidget>("BayOutput");
+Model* modelVenomBayOutput = Venom::createVenomModel<Venom::BayOutput, Venom::BayOutputWidget>("BayOutput");
@@ -28,11 +28,11 @@ struct BenjolinGatesExpanderWidget : BenjolinExpanderWidget {
     }
   };
 
-  struct GatePort : MonoPort {
+  struct GatePort : PolyPort {
     int portId;
     void appendContextMenu(Menu* menu) override {
       static_cast<BenjolinGatesExpander*>(this->module)->gateOutputMenu(menu,portId);
-      MonoPort::appendContextMenu(menu);
+      PolyPort::appendContextMenu(menu);
     }
   };
   
@@ -118,4 +118,4 @@ struct BenjolinGatesExpanderWidget : BenjolinExpanderWidget {
 
 }
 
-Model* modelVenomBenjolinGatesExpander = createModel<Venom::BenjolinGatesExpander, Venom::BenjolinGatesExpanderWidget>("BenjolinGatesExpander");
+Model* modelVenomBenjolinGatesExpander = Venom::createVenomModel<Venom::BenjolinGatesExpander, Venom::BenjolinGatesExpanderWidget>("BenjolinGatesExpander");
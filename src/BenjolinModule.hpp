@@ -75,8 +75,8 @@ struct BenjolinGatesExpander : BenjolinModule {
   };
   unsigned char gateBits[8]{1,2,4,8,16,32,64,128};
   int gateLogic[8]{};
-  unsigned char oldVal[8]{};
-  dsp::PulseGenerator trigGenerator[8];
+  unsigned char oldVal[8][16]{};
+  dsp::PulseGenerator trigGenerator[8][16];
 
   BenjolinGatesExpander() {
     venomConfig(GATES_PARAMS_LEN, GATES_INPUTS_LEN, GATES_OUTPUTS_LEN, GATES_LIGHTS_LEN);
@@ -159,6 +159,7 @@ struct BenjolinGatesExpander : BenjolinModule {
       setPortName(i);
   }
   
+#ifndef VENOM_HEADLESS
   void gateOutputMenu( Menu* menu, int portId ) {
     menu->addChild(new MenuSeparator);
     menu->addChild(createSubmenuItem("Gate bits","",
@@ -188,6 +189,7 @@ struct BenjolinGatesExpander : BenjolinModule {
       }
     ));
   }  
+#endif
 };
 
 
@@ -236,6 +238,7 @@ struct BenjolinVoltsExpander : BenjolinModule {
 };
 
 
+#ifndef VENOM_HEADLESS
 struct BenjolinExpanderWidget : VenomWidget {
   void step() override {
     bool connected = false;
@@ -274,5 +277,6 @@ struct BenjolinExpanderWidget : VenomWidget {
     VenomWidget::step();
   }  
 };
+#endif
 
 }
\ No newline at end of file
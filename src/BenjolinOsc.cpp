@@ -51,22 +51,24 @@ struct BenjolinOsc : BenjolinModule {
     LIGHTS_LEN
   };
 
-  bool oldTrig = false;  
+  using float_4 = simd::float_4;
+
   int oversample = -1;
   int dacMode=0, dacBit1=2, dacBit2=8, dacBit3=64, dacShift1=1, dacShift2=2, dacShift3=4;
+  int polyChannels = 1, oldChannels = 0;
   std::vector<int> oversampleValues = {1,2,4,8,16,32};
-  OversampleFilter_4 upSample, downSampleA, downSampleB;
-  dsp::SchmittTrigger clockTrig;
-  simd::float_4 osc{0.f,0.f,1.f,1.f}, triMask{1.f,1.f,0.f,0.f}, dir{1.f,1.f,0.f,0.f},
-                in{}, outA{}, outB{};
-  float *tri1=&osc[0], *tri2=&osc[1], *pul1=&osc[2], *pul2=&osc[3], *dir1=&dir[0], *dir2=&dir[1],
-        *tri1Out=&outA[0], *tri2Out=&outA[1], *pul1Out=&outA[2], *pul2Out=&outA[3], 
-        *xorOut=&outB[0], *pwmOut=&outB[1], *rungOut=&outB[2],
-        *cv1In=&in[0], *cv2In=&in[1], *clockIn=&in[2],
-        normScale=5.f,
-        xorVal=0, rung=0;
-  unsigned char asr = rack::random::uniform()*126+1;
-  bool origNormScale=false, chaosIn=false, dblIn=false, unipolarClock=false;
+  OversampleFilterBank<3> upSample; // CV1, CV2, and clock inputs
+  OversampleFilterBank<OUTPUTS_LEN> downSample; // indexed by output id
+  // lanes of the oversampled inputs and outputs in the filter bank blocks, updated when laneKey changes
+  float *upLane[3]{}, *downLane[OUTPUTS_LEN]{};
+  int upBlocks = 0, downBlocks = 0, laneKey = -1;
+  // Each SIMD group holds 4 independent Benjolins
+  float_4 tri1[4]{}, tri2[4]{}, dir1[4]{}, dir2[4]{}, pul1[4]{}, pul2[4]{},
+          clockHigh[4]{}, xorVal[4]{}, rung[4]{};
+  float normScale=5.f;
+  unsigned char asr[16]{};
+  bool oldTrig[16]{}, chaosFlip[16]{}, dblFlip[16]{},
+       origNormScale=false, chaosIn[16]{}, dblIn[16]{}, unipolarClock=false;
  
   BenjolinOsc() {
     venomConfig(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -94,6 +96,14 @@ struct BenjolinOsc : BenjolinModule {
     configOutput(RUNG_OUTPUT,"Rungler");
     
     oversampleStages = 5;
+    for (int s=0; s<4; s++) {
+      dir1[s] = dir2[s] = pul1[s] = pul2[s] = 1.f;
+      clockHigh[s] = float_4::mask();
+      xorVal[s] = -5.f;
+      rung[s] = 0.f;
+    }
+    for (int c=0; c<16; c++)
+      asr[c] = rack::random::uniform()*126+1;
   }
 
   void onSampleRateChange() override {
@@ -129,96 +139,315 @@ struct BenjolinOsc : BenjolinModule {
   
   void setOversample() override {
     upSample.setOversample(oversample, oversampleStages);
-    downSampleA.setOversample(oversample, oversampleStages);
-    downSampleB.setOversample(oversample, oversampleStages);
+    downSample.setOversample(oversample, oversampleStages, true);
+    if (oversample < 2) {
+      for (int i=0; i<3; i++)
+        upSample.release(i);
+      for (int i=0; i<OUTPUTS_LEN; i++)
+        downSample.release(i);
+    }
+    laneKey = -1;
+  }
+
+  // Shifts a new bit into the rungler of channel c, and updates its XOR and rungler outputs
+  void clockRungler(int c, bool chaos, float tri1Val) {
+    float ptrn = chaos ? 0.f : params[PATTERN_PARAM].getValue();
+    unsigned char data = (ptrn>tri1Val || ptrn>=1.f) ^ (chaos ? ((asr[c]&32)>>5)^((asr[c]&64)>>6) : (asr[c]&128)>>7);
+    asr[c] = (asr[c]<<1)|data;
+    xorVal[c/4][c%4] = asr[c]&1 ? 5.f : -5.f;
+    rung[c/4][c%4] = (((asr[c]&dacBit1)>>dacShift1)+((asr[c]&dacBit2)>>dacShift2)+((asr[c]&dacBit3)>>dacShift3)) * 1.428571f - 5.f;
+  }
+
+  // Points lanes[i] at the first lane of active port i in the blocks of bank, where each port spans stride lanes.
+  // Returns a bit mask of the blocks that hold active ports, and releases the other blocks.
+  // A port whose block has no bank slot gets a NULL lane, and is not oversampled until the lanes are laid out again.
+  template <int N>
+  int blockLanes(OversampleFilterBank<N>& bank, const bool* active, int ports, int stride, float** lanes) {
+    int used = 0;
+    for (int i=0; i<ports; i++) {
+      lanes[i] = NULL;
+      if (active[i]) {
+        float_4 (*buf)[4] = bank.block(i*stride/16);
+        if (!buf)
+          continue;
+        used |= 1 << (i*stride/16);
+        lanes[i] = reinterpret_cast<float*>(buf) + i*stride%16;
+      }
+    }
+    for (int f=0; f<N; f++) {
+      if (!(used>>f & 1))
+        bank.release(f);
+    }
+    return used;
+  }
+
+  // A monophonic trigger toggles the button for all channels, while a polyphonic trigger toggles the button
+  // state of its own channel. Returns true if the channel toggles apply.
+  bool toggleInput(int inputId, int paramId, bool* inState, bool* flip, int channels) {
+    Input& in = inputs[inputId];
+    bool poly = in.isPolyphonic();
+    for (int c=0; c<(poly ? std::min(in.getChannels(), channels) : 1); c++) {
+      if ((in.getVoltage(c)>=2.f) != inState[c]) {
+        inState[c] = !inState[c];
+        if (inState[c]) {
+          if (poly)
+            flip[c] = !flip[c];
+          else
+            params[paramId].setValue(!params[paramId].getValue());
+        }
+      }
+    }
+    return poly;
   }
 
   void process(const ProcessArgs& args) override {
     VenomModule::process(args);
-    if (oversample != oversampleValues[params[OVER_PARAM].getValue()]) {
-      oversample = oversampleValues[params[OVER_PARAM].getValue()];
+    if (oversample != governedOversample(oversampleValues[params[OVER_PARAM].getValue()])) {
+      oversample = governedOversample(oversampleValues[params[OVER_PARAM].getValue()]);
       setOversample();
     }
-    simd::float_4 k = triMask * 60.f * args.sampleTime / oversample;
-    bool cv1Connected = inputs[CV1_INPUT].isConnected(),
-         cv2Connected = inputs[CV2_INPUT].isConnected(),
-         clockConnected = inputs[CLOCK_INPUT].isConnected(),
-         chaos = params[CHAOS_PARAM].getValue(),
+    int channels = polyChannels;
+    for (int i=0; i<INPUTS_LEN; i++)
+      channels = std::max(channels, inputs[i].getChannels());
+    int simdCnt = (channels+3)/4;
+    bool channelsChanged = channels != oldChannels;
+    oldChannels = channels;
+
+    float k = 60.f * args.sampleTime / oversample,
+          freq1Param = params[FREQ1_PARAM].getValue() + 0.0001f,
+          freq2Param = params[FREQ2_PARAM].getValue(),
+          cv1Amt = 0.9f * params[CV1_PARAM].getValue(),
+          cv2Amt = 0.9f * params[CV2_PARAM].getValue(),
+          rung1Amt = 0.9f * params[RUNG1_PARAM].getValue(),
+          rung2Amt = 0.9f * params[RUNG2_PARAM].getValue(),
+          clockLow = unipolarClock ? 0.1f : -1.f;
+    bool connected[3] = {inputs[CV1_INPUT].isConnected(), inputs[CV2_INPUT].isConnected(), inputs[CLOCK_INPUT].isConnected()};
+    bool chaosPoly = toggleInput(CHAOS_INPUT, CHAOS_PARAM, chaosIn, chaosFlip, channels),
+         dblPoly = toggleInput(DOUBLE_INPUT, DOUBLE_PARAM, dblIn, dblFlip, channels);
+    bool chaos = params[CHAOS_PARAM].getValue(),
          dbl = params[DOUBLE_PARAM].getValue();
-    int trig=0;
-    *cv1In = inputs[CV1_INPUT].getVoltage();
-    *cv2In = inputs[CV2_INPUT].getVoltage();
-    *clockIn = inputs[CLOCK_INPUT].getVoltage();
-    if ((inputs[CHAOS_INPUT].getVoltage()>=2.f) != chaosIn) {
-      chaosIn = !chaosIn;
-      if (chaosIn) {
-        chaos = !chaos;
-        params[CHAOS_PARAM].setValue(chaos);
+
+    // Each input and output fills consecutive lanes of the filter bank blocks, one per channel, so a mono
+    // Benjolin filters its 3 inputs as one SIMD group and its 7 outputs as two.
+    // Lanes per port are rounded up to a divisor of 16 so that no port spans two blocks.
+    int stride = channels<=2 ? channels : channels<=4 ? 4 : channels<=8 ? 8 : 16;
+    int inputIds[3] = {CV1_INPUT, CV2_INPUT, CLOCK_INPUT};
+    float_4 in[3][4]{};
+    for (int i=0; i<3; i++) {
+      for (int s=0, c=0; s<simdCnt; s++, c+=4)
+        in[i][s] = inputs[inputIds[i]].getPolyVoltageSimd<float_4>(c);
+    }
+    bool upActive[3]{}, outActive[OUTPUTS_LEN]{};
+    int key = stride;
+    for (int i=0; i<3; i++) {
+      upActive[i] = oversample>1 && connected[i];
+      key |= upActive[i] << (5+i);
+    }
+    for (int i=0; i<OUTPUTS_LEN; i++) {
+      outActive[i] = oversample>1 && outputs[i].isConnected();
+      key |= outActive[i] << (8+i);
+    }
+    if (key != laneKey) {
+      laneKey = key;
+      upBlocks = blockLanes(upSample, upActive, 3, stride, upLane);
+      downBlocks = blockLanes(downSample, outActive, OUTPUTS_LEN, stride, downLane);
+    }
+    // Ports without a bank slot are read and written directly, and the lanes are laid out again next frame
+    for (int i=0; i<3; i++) {
+      if (upActive[i] && !upLane[i]) {
+        upActive[i] = false;
+        laneKey = -1;
+      }
+    }
+    for (int i=0; i<OUTPUTS_LEN; i++) {
+      if (outActive[i] && !downLane[i]) {
+        outActive[i] = false;
+        laneKey = -1;
       }
     }
-    if ((inputs[DOUBLE_INPUT].getVoltage()>=2.f) != dblIn) {
-      dblIn = !dblIn;
-      if (dblIn) {
-        dbl = !dbl;
-        params[DOUBLE_PARAM].setValue(dbl);
+    if (upBlocks) {
+      for (int f=0; f<3; f++) {
+        if (upBlocks>>f & 1) {
+          float_4 (*buf)[4] = upSample.block(f);
+          for (int o=0; o<oversample; o++) {
+            for (int g=0; g<4; g++)
+              buf[o][g] = float_4::zero();
+          }
+          upSample.queue(f, std::min((3*stride - f*16 + 3)/4, 4));
+        }
+      }
+      for (int i=0; i<3; i++) {
+        if (upActive[i]) {
+          for (int c=0; c<channels; c++)
+            upLane[i][c] = in[i][c/4][c%4] * oversample;
+        }
       }
+      upSample.process(oversample);
     }
-    for (int o=0; o<oversample; o++){
-      if (oversample>1 && (cv1Connected || cv2Connected || clockConnected)){
-        in = upSample.process(o ? simd::float_4::zero() : in * oversample);
+
+    if (channels == 1) {
+      // A mono Benjolin packs both oscillators and their pulses into one vector
+      float_4 osc{tri1[0][0], tri2[0][0], pul1[0][0], pul2[0][0]}, dir{dir1[0][0], dir2[0][0], 0.f, 0.f}, oscOut;
+      bool high = simd::movemask(clockHigh[0]) & 1,
+           monoChaos = chaos != (chaosPoly && chaosFlip[0]),
+           monoDbl = dbl != (dblPoly && dblFlip[0]);
+      float monoOut[OUTPUTS_LEN];
+      for (int o=0; o<oversample; o++){
+        float inVal[3];
+        for (int i=0; i<3; i++)
+          inVal[i] = upActive[i] ? upLane[i][o*16] : in[i][0][0];
+        float_4 freq = {
+          freq1Param + (connected[0] ? inVal[0] : osc[1]*normScale) * cv1Amt + rung[0][0] * rung1Amt,
+          freq2Param + (connected[1] ? inVal[1] : osc[0]*normScale) * cv2Amt + rung[0][0] * rung2Amt,
+          0.f,0.f
+        };
+        freq = simd::clamp(freq, -9.3f, 9.7f);
+        osc += dsp::exp2_taylor5(freq) * k * dir;
+        if (osc[0] > 1.f || osc[0] < -1.f) {
+          osc[0] = dir[0] + dir[0] - osc[0];
+          dir[0] *= -1.f;
+        }
+        if (osc[1] > 1.f || osc[1] < -1.f) {
+          osc[1] = dir[1] + dir[1] - osc[1];
+          dir[1] *= -1.f;
+        }
+        if (osc[2] != math::sgn(osc[0])) osc[2]*=-1.f;
+        if (osc[3] != math::sgn(osc[1])) osc[3]*=-1.f;
+        float clock = connected[2] ? inVal[2] : osc[3]*normScale;
+        if (!high && clock >= 1.f) {
+          high = true;
+          clockRungler(0, monoChaos, osc[0]);
+        }
+        else if (high && clock <= clockLow) {
+          high = false;
+          if (monoDbl)
+            clockRungler(0, monoChaos, osc[0]);
+        }
+        oscOut = osc*5.f;
+        monoOut[TRI1_OUTPUT] = oscOut[0];
+        monoOut[TRI2_OUTPUT] = oscOut[1];
+        monoOut[PULSE1_OUTPUT] = oscOut[2];
+        monoOut[PULSE2_OUTPUT] = oscOut[3];
+        monoOut[XOR_OUTPUT] = xorVal[0][0];
+        monoOut[PWM_OUTPUT] = osc[1] > osc[0] ? 5.f : -5.f;
+        monoOut[RUNG_OUTPUT] = rung[0][0];
+        for (int i=0; i<OUTPUTS_LEN; i++) {
+          if (outActive[i])
+            downLane[i][o*16] = monoOut[i];
+        }
       }
-      simd::float_4 freq = {
-        params[FREQ1_PARAM].getValue() + 0.0001f + (cv1Connected ? *cv1In : *tri2*normScale) * 0.9f * params[CV1_PARAM].getValue() + rung * 0.9f * params[RUNG1_PARAM].getValue(),
-        params[FREQ2_PARAM].getValue() + (cv2Connected ? *cv2In : *tri1*normScale) * 0.9f * params[CV2_PARAM].getValue() + rung * 0.9f * params[RUNG2_PARAM].getValue(),
-        0.f,0.f
-      };
-      freq = simd::clamp(freq, -9.3f, 9.7f);
-      osc += dsp::exp2_taylor5(freq) * k * dir;
-      if (*tri1 > 1.f || *tri1 < -1.f) {
-        *tri1 = *dir1 + *dir1 - *tri1;
-        *dir1 *= -1.f;
-      }  
-      if (*tri2 > 1.f || *tri2 < -1.f) {
-        *tri2 = *dir2 + *dir2 - *tri2;
-        *dir2 *= -1.f;
+      for (int i=0; i<OUTPUTS_LEN; i++) {
+        if (!outActive[i])
+          outputs[i].setVoltage(monoOut[i]);
+      }
+      tri1[0][0] = osc[0];
+      tri2[0][0] = osc[1];
+      pul1[0][0] = osc[2];
+      pul2[0][0] = osc[3];
+      dir1[0][0] = dir[0];
+      dir2[0][0] = dir[1];
+      clockHigh[0] = high ? float_4::mask() : float_4::zero();
+    }
+    else {
+      float_4 out[OUTPUTS_LEN]{};
+      for (int o=0; o<oversample; o++){
+        for (int s=0; s<simdCnt; s++){
+          float_4 inVal[3];
+          for (int i=0; i<3; i++)
+            inVal[i] = upActive[i] ? float_4::load(upLane[i] + o*16 + s*4) : in[i][s];
+          float_4 cv1 = connected[0] ? inVal[0] : tri2[s]*normScale,
+                  cv2 = connected[1] ? inVal[1] : tri1[s]*normScale,
+                  freq1 = simd::clamp(freq1Param + cv1*cv1Amt + rung[s]*rung1Amt, -9.3f, 9.7f),
+                  freq2 = simd::clamp(freq2Param + cv2*cv2Amt + rung[s]*rung2Amt, -9.3f, 9.7f);
+          tri1[s] += dsp::exp2_taylor5(freq1) * k * dir1[s];
+          tri2[s] += dsp::exp2_taylor5(freq2) * k * dir2[s];
+          float_4 fold = (tri1[s] > 1.f) | (tri1[s] < -1.f);
+          tri1[s] = simd::ifelse(fold, dir1[s] + dir1[s] - tri1[s], tri1[s]);
+          dir1[s] = simd::ifelse(fold, -dir1[s], dir1[s]);
+          fold = (tri2[s] > 1.f) | (tri2[s] < -1.f);
+          tri2[s] = simd::ifelse(fold, dir2[s] + dir2[s] - tri2[s], tri2[s]);
+          dir2[s] = simd::ifelse(fold, -dir2[s], dir2[s]);
+          pul1[s] = simd::ifelse(pul1[s] != simd::sgn(tri1[s]), -pul1[s], pul1[s]);
+          pul2[s] = simd::ifelse(pul2[s] != simd::sgn(tri2[s]), -pul2[s], pul2[s]);
+
+          // clock Schmitt trigger, with the rare edges handled per channel
+          float_4 clock = connected[2] ? inVal[2] : pul2[s]*normScale,
+                  rise = ~clockHigh[s] & (clock >= 1.f),
+                  fall = clockHigh[s] & (clock <= clockLow);
+          clockHigh[s] = ~fall & (clockHigh[s] | rise);
+          int riseBits = simd::movemask(rise), fallBits = simd::movemask(fall);
+          if (riseBits | fallBits) {
+            for (int i=0, c=s*4; i<4 && c<channels; i++, c++) {
+              if ((riseBits>>i & 1) || ((fallBits>>i & 1) && dbl != (dblPoly && dblFlip[c])))
+                clockRungler(c, chaos != (chaosPoly && chaosFlip[c]), tri1[s][i]);
+            }
+          }
+
+          out[TRI1_OUTPUT] = tri1[s]*5.f;
+          out[TRI2_OUTPUT] = tri2[s]*5.f;
+          out[PULSE1_OUTPUT] = pul1[s]*5.f;
+          out[PULSE2_OUTPUT] = pul2[s]*5.f;
+          out[XOR_OUTPUT] = xorVal[s];
+          out[PWM_OUTPUT] = simd::ifelse(tri2[s] > tri1[s], 5.f, -5.f);
+          out[RUNG_OUTPUT] = rung[s];
+          for (int i=0; i<OUTPUTS_LEN; i++) {
+            if (!outActive[i])
+              continue;
+            float* lane = downLane[i] + o*16 + s*4;
+            if (stride < 4) {
+              for (int c=0; c<channels; c++)
+                lane[c] = out[i][c];
+            }
+            else
+              out[i].store(lane);
+          }
+          if (oversample == 1 || o == oversample-1) {
+            for (int i=0; i<OUTPUTS_LEN; i++) {
+              if (!outActive[i])
+                outputs[i].setVoltageSimd(out[i], s*4);
+            }
+          }
+        }
       }
-      if (*pul1 != math::sgn(*tri1)) *pul1*=-1.f;
-      if (*pul2 != math::sgn(*tri2)) *pul2*=-1.f;
-      *pwmOut = *tri2>*tri1 ? 5.f : -5.f;
-      trig = clockTrig.processEvent( clockConnected ? *clockIn : *pul2*normScale, unipolarClock?0.1f:-1.f, 1.f);
-      if (trig>0 || (trig && dbl)){
-        float ptrn = chaos ? 0.f : params[PATTERN_PARAM].getValue();
-        unsigned char data = (ptrn>*tri1 || ptrn>=1.f) ^ (chaos ? ((asr&32)>>5)^((asr&64)>>6) : (asr&128)>>7);
-        asr = (asr<<1)|data;
-        xorVal = asr&1 ? 5.f : -5.f;
-        rung = (((asr&dacBit1)>>dacShift1)+((asr&dacBit2)>>dacShift2)+((asr&dacBit3)>>dacShift3)) * 1.428571f - 5.f;
+    }
+    // Downsample the connected outputs in a single pass of the filter bank
+    if (downBlocks) {
+      for (int f=0; f<OUTPUTS_LEN; f++) {
+        if (downBlocks>>f & 1)
+          downSample.queue(f, std::min((OUTPUTS_LEN*stride - f*16 + 3)/4, 4));
       }
-      *xorOut = xorVal;
-      *rungOut = rung;
-      if (oversample>1) {
-        outA = downSampleA.process(osc*5.f);
-        outB = downSampleB.process(outB);
+      downSample.process(oversample);
+      for (int i=0; i<OUTPUTS_LEN; i++) {
+        if (outActive[i]) {
+          for (int c=0; c<channels; c++)
+            outputs[i].setVoltage(downLane[i][(oversample-1)*16 + c], c);
+        }
       }
-      else
-        outA = osc*5.f;
     }
+    for (int i=0; i<OUTPUTS_LEN; i++)
+      outputs[i].setChannels(channels);
 
-    lights[RUNGLER_LIGHT+0].setBrightnessSmooth(asr&1   ? LIGHT_DIM : LIGHT_OFF, args.sampleTime);
-    lights[RUNGLER_LIGHT+1].setBrightnessSmooth(asr&2   ? (dacMode?LIGHT_DIM:LIGHT_ON) : 0.f, args.sampleTime);
-    lights[RUNGLER_LIGHT+2].setBrightnessSmooth(asr&4   ? LIGHT_DIM : 0.f, args.sampleTime);
-    lights[RUNGLER_LIGHT+3].setBrightnessSmooth(asr&8   ? (dacMode?LIGHT_DIM:LIGHT_ON) : 0.f, args.sampleTime);
-    lights[RUNGLER_LIGHT+4].setBrightnessSmooth(asr&16  ? LIGHT_DIM : 0.f, args.sampleTime);
-    lights[RUNGLER_LIGHT+5].setBrightnessSmooth(asr&32  ? (dacMode?LIGHT_ON:LIGHT_DIM) : 0.f, args.sampleTime);
-    lights[RUNGLER_LIGHT+6].setBrightnessSmooth(asr&64  ? LIGHT_ON : 0.f, args.sampleTime);
-    lights[RUNGLER_LIGHT+7].setBrightnessSmooth(asr&128 ? (dacMode?LIGHT_ON:LIGHT_DIM) : 0.f, args.sampleTime);
+    lights[RUNGLER_LIGHT+0].setBrightnessSmooth(asr[0]&1   ? LIGHT_DIM : LIGHT_OFF, args.sampleTime);
+    lights[RUNGLER_LIGHT+1].setBrightnessSmooth(asr[0]&2   ? (dacMode?LIGHT_DIM:LIGHT_ON) : 0.f, args.sampleTime);
+    lights[RUNGLER_LIGHT+2].setBrightnessSmooth(asr[0]&4   ? LIGHT_DIM : 0.f, args.sampleTime);
+    lights[RUNGLER_LIGHT+3].setBrightnessSmooth(asr[0]&8   ? (dacMode?LIGHT_DIM:LIGHT_ON) : 0.f, args.sampleTime);
+    lights[RUNGLER_LIGHT+4].setBrightnessSmooth(asr[0]&16  ? LIGHT_DIM : 0.f, args.sampleTime);
+    lights[RUNGLER_LIGHT+5].setBrightnessSmooth(asr[0]&32  ? (dacMode?LIGHT_ON:LIGHT_DIM) : 0.f, args.sampleTime);
+    lights[RUNGLER_LIGHT+6].setBrightnessSmooth(asr[0]&64  ? LIGHT_ON : 0.f, args.sampleTime);
+    lights[RUNGLER_LIGHT+7].setBrightnessSmooth(asr[0]&128 ? (dacMode?LIGHT_ON:LIGHT_DIM) : 0.f, args.sampleTime);
 
-    trig = 0;
-    if (clockTrig.isHigh() != oldTrig){
-      trig = clockTrig.isHigh() ? 1 : -1;
-      oldTrig = clockTrig.isHigh();
+    int trig[16]{};
+    bool anyTrig = channelsChanged;
+    for (int c=0; c<channels; c++) {
+      bool high = simd::movemask(clockHigh[c/4]) >> (c%4) & 1;
+      if (high != oldTrig[c]){
+        trig[c] = high ? 1 : -1;
+        oldTrig[c] = high;
+        anyTrig = true;
+      }
     }
     for (BenjolinModule* expndr = rightExpander; expndr; expndr = expndr->rightExpander){
-      if (!expndr->isBypassed() && expndr->model == modelVenomBenjolinGatesExpander && (trig || expndr->expanderTrig)){
+      if (!expndr->isBypassed() && expndr->model == modelVenomBenjolinGatesExpander && (anyTrig || expndr->expanderTrig)){
         expndr->expanderTrig = false;
         BenjolinGatesExpander* gates = static_cast<BenjolinGatesExpander*>(expndr);
         float hi = gates->params[GATES_POLARITY_PARAM].getValue() ? 5.f : 10.f;
@@ -226,75 +455,77 @@ struct BenjolinOsc : BenjolinModule {
         int mode = static_cast<int>(gates->params[GATES_MODE_PARAM].getValue());
         unsigned char val;
         for (int i=0; i<8; i++){
-          val = asr & gates->gateBits[i];
-          switch (gates->gateLogic[i]){
-            case BenjolinGatesExpander::AND:
-              if (val != gates->gateBits[i]) val = 0;
-              break;
-            case BenjolinGatesExpander::XOR:
-              val = gates->setCount(val) == 1;
-              break;
+          for (int c=0; c<channels; c++){
+            val = asr[c] & gates->gateBits[i];
+            switch (gates->gateLogic[i]){
+              case BenjolinGatesExpander::AND:
+                if (val != gates->gateBits[i]) val = 0;
+                break;
+              case BenjolinGatesExpander::XOR:
+                val = gates->setCount(val) == 1;
+                break;
+            }
+            bool clockIsHigh = oldTrig[c];
+            switch (mode){
+              // case 0: gate do nothing
+              case 1: // clock gate
+                val = (val && clockIsHigh);
+                break;
+              case 2: // inverse clock gate
+                val = (val && !clockIsHigh);
+                break;
+              case 3: // trigger
+                if (val != gates->oldVal[i][c]) {
+                  if (val) gates->trigGenerator[i][c].trigger();
+                  gates->oldVal[i][c] = val;
+                }
+                break;
+              case 4: // clock rise trigger
+                if (val && trig[c]>0) gates->trigGenerator[i][c].trigger();
+                break;
+              case 5: // clock fall trigger
+                if (val && trig[c]<0) gates->trigGenerator[i][c].trigger();
+                break;
+              case 6: // clock edge trigger
+                if (val && trig[c]) gates->trigGenerator[i][c].trigger();
+                break;
+            }
+            if (mode >= 3 /*trigger*/) {
+              if (gates->trigGenerator[i][c].remaining)
+                gates->expanderTrig = true;
+              if (val)
+                val = gates->trigGenerator[i][c].process(args.sampleTime);
+              else
+                gates->trigGenerator[i][c].reset();
+            }
+            gates->outputs[i].setVoltage(val ? hi : lo, c);
+            if (!c)
+              gates->lights[GATE_LIGHT+i].setBrightnessSmooth(val!=0, args.sampleTime);
           }
-          switch (mode){
-            // case 0: gate do nothing
-            case 1: // clock gate
-              val = (val && clockTrig.isHigh());
-              break;
-            case 2: // inverse clock gate
-              val = (val && !clockTrig.isHigh());
-              break;
-            case 3: // trigger
-              if (val != gates->oldVal[i]) {
-                if (val) gates->trigGenerator[i].trigger();
-                gates->oldVal[i] = val;
-              }
-              break;
-            case 4: // clock rise trigger
-              if (val && trig>0) gates->trigGenerator[i].trigger();
-              break;
-            case 5: // clock fall trigger
-              if (val && trig<0) gates->trigGenerator[i].trigger();
-              break;
-            case 6: // clock edge trigger
-              if (val && trig) gates->trigGenerator[i].trigger();
-              break;
-          }
-          if (mode >= 3 /*trigger*/) {
-            if (gates->trigGenerator[i].remaining)
-              gates->expanderTrig = true;
-            if (val)
-              val = gates->trigGenerator[i].process(args.sampleTime);
-            else
-              gates->trigGenerator[i].reset();
-          }
-          gates->outputs[i].setVoltage(val ? hi : lo);
-          gates->lights[GATE_LIGHT+i].setBrightnessSmooth(val!=0, args.sampleTime);
+          gates->outputs[i].setChannels(channels);
         }
       }
-      if (!expndr->isBypassed() && expndr->model == modelVenomBenjolinVoltsExpander && (trig || expndr->expanderTrig)){
+      if (!expndr->isBypassed() && expndr->model == modelVenomBenjolinVoltsExpander && (anyTrig || expndr->expanderTrig)){
         expndr->expanderTrig = false;
         BenjolinVoltsExpander* volts = static_cast<BenjolinVoltsExpander*>(expndr);
-        float val = 0.f;
-        float div = 0.f;
+        float bitVal[8], div = 0.f;
         for (int i=0; i<8; i++){
-          float v = volts->getBitValue(VOLT_PARAM+i);
-          div += v;
-          if (asr & (1<<i)){
-            val += v;
+          bitVal[i] = volts->getBitValue(VOLT_PARAM+i);
+          div += bitVal[i];
+        }
+        for (int c=0; c<channels; c++){
+          float val = 0.f;
+          for (int i=0; i<8; i++){
+            if (asr[c] & (1<<i))
+              val += bitVal[i];
           }
+          if (div)
+            val = (val/div - 0.5f) * volts->params[VOLTS_RANGE_PARAM].getValue();
+          volts->outputs[VOLTS_OUTPUT].setVoltage(val + volts->params[VOLTS_OFFSET_PARAM].getValue(), c);
         }
-        if (div)
-          val = (val/div - 0.5f) * volts->params[VOLTS_RANGE_PARAM].getValue();
-        volts->outputs[VOLTS_OUTPUT].setVoltage(val + volts->params[VOLTS_OFFSET_PARAM].getValue());
+        volts->outputs[VOLTS_OUTPUT].setChannels(channels);
       }
     }
-    outputs[TRI1_OUTPUT].setVoltage(*tri1Out);
-    outputs[TRI2_OUTPUT].setVoltage(*tri2Out);
-    outputs[PULSE1_OUTPUT].setVoltage(*pul1Out);
-    outputs[PULSE2_OUTPUT].setVoltage(*pul2Out);
-    outputs[XOR_OUTPUT].setVoltage(*xorOut);
-    outputs[PWM_OUTPUT].setVoltage(*pwmOut);
-    outputs[RUNG_OUTPUT].setVoltage(*rungOut);
   }
   
   json_t* dataToJson() override {
@@ -302,6 +533,7 @@ struct BenjolinOsc : BenjolinModule {
     json_object_set_new(rootJ, "origNormScale", json_boolean(origNormScale));
     json_object_set_new(rootJ, "unipolarClock", json_boolean(unipolarClock));
     json_object_set_new(rootJ, "dacMode", json_integer(dacMode));
+    json_object_set_new(rootJ, "polyChannels", json_integer(polyChannels));
     return rootJ;
   }
 
@@ -324,6 +556,8 @@ struct BenjolinOsc : BenjolinModule {
       dacShift2 = dacMode ? 5 : 2;
       dacShift3 = dacMode ? 5 : 4;
     }
+    if ((val = json_object_get(rootJ, "polyChannels")))
+      polyChannels = clamp(static_cast<int>(json_integer_value(val)), 1, 16);
   }
 
   void setDacMode(int mode) {
@@ -338,6 +572,7 @@ struct BenjolinOsc : BenjolinModule {
 
 };
 
+#ifndef VENOM_HEADLESS
 struct BenjolinOscWidget : VenomWidget {
 
   struct OverSwitch : GlowingSvgSwitchLockable {
@@ -364,18 +599,18 @@ struct BenjolinOscWidget : VenomWidget {
     addParam(createLockableParamCentered<RoundSmallBlackKnobLockable>(Vec(63.288,202.602), module, BenjolinOsc::CV2_PARAM));
     addParam(createLockableLightParamCentered<VCVLightButtonLatchLockable<MediumSimpleLight<WhiteLight>>>(Vec(101.712,202.602), module, BenjolinOsc::CHAOS_PARAM, BenjolinOsc::CHAOS_LIGHT));
     addParam(createLockableLightParamCentered<VCVLightButtonLatchLockable<MediumSimpleLight<WhiteLight>>>(Vec(140.135,202.602), module, BenjolinOsc::DOUBLE_PARAM, BenjolinOsc::DOUBLE_LIGHT));
-    addInput(createInputCentered<MonoPort>(Vec(24.865,235.665), module, BenjolinOsc::CV1_INPUT));
-    addInput(createInputCentered<MonoPort>(Vec(63.288,235.665), module, BenjolinOsc::CV2_INPUT));
-    addInput(createInputCentered<MonoPort>(Vec(101.712,235.665), module, BenjolinOsc::CHAOS_INPUT));
-    addInput(createInputCentered<MonoPort>(Vec(140.135,235.665), module, BenjolinOsc::DOUBLE_INPUT));
-    addOutput(createOutputCentered<MonoPort>(Vec(24.865,288.931), module, BenjolinOsc::TRI1_OUTPUT));
-    addOutput(createOutputCentered<MonoPort>(Vec(63.288,288.931), module, BenjolinOsc::TRI2_OUTPUT));
-    addOutput(createOutputCentered<MonoPort>(Vec(101.712,288.931), module, BenjolinOsc::XOR_OUTPUT));
-    addInput(createInputCentered<MonoPort>(Vec(140.135,288.931), module, BenjolinOsc::CLOCK_INPUT));
-    addOutput(createOutputCentered<MonoPort>(Vec(24.865,330.368), module, BenjolinOsc::PULSE1_OUTPUT));
-    addOutput(createOutputCentered<MonoPort>(Vec(63.288,330.368), module, BenjolinOsc::PULSE2_OUTPUT));
-    addOutput(createOutputCentered<MonoPort>(Vec(101.712,330.368), module, BenjolinOsc::PWM_OUTPUT));
-    addOutput(createOutputCentered<MonoPort>(Vec(140.135,330.368), module, BenjolinOsc::RUNG_OUTPUT));
+    addInput(createInputCentered<PolyPort>(Vec(24.865,235.665), module, BenjolinOsc::CV1_INPUT));
+    addInput(createInputCentered<PolyPort>(Vec(63.288,235.665), module, BenjolinOsc::CV2_INPUT));
+    addInput(createInputCentered<PolyPort>(Vec(101.712,235.665), module, BenjolinOsc::CHAOS_INPUT));
+    addInput(createInputCentered<PolyPort>(Vec(140.135,235.665), module, BenjolinOsc::DOUBLE_INPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(24.865,288.931), module, BenjolinOsc::TRI1_OUTPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(63.288,288.931), module, BenjolinOsc::TRI2_OUTPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(101.712,288.931), module, BenjolinOsc::XOR_OUTPUT));
+    addInput(createInputCentered<PolyPort>(Vec(140.135,288.931), module, BenjolinOsc::CLOCK_INPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(24.865,330.368), module, BenjolinOsc::PULSE1_OUTPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(63.288,330.368), module, BenjolinOsc::PULSE2_OUTPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(101.712,330.368), module, BenjolinOsc::PWM_OUTPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(140.135,330.368), module, BenjolinOsc::RUNG_OUTPUT));
 
     {
       int i;
@@ -399,6 +634,12 @@ struct BenjolinOscWidget : VenomWidget {
       }
     ));
     menu->addChild(createBoolPtrMenuItem("Unipolar clock input", "", &module->unipolarClock));
+    menu->addChild(createIndexSubmenuItem(
+      "Polyphony channels",
+      {"1","2","3","4","5","6","7","8","9","10","11","12","13","14","15","16"},
+      [=]() {return module->polyChannels-1;},
+      [=](int val) {module->polyChannels = val+1;}
+    ));
     menu->addChild(createIndexSubmenuItem(
       "Rungler DAC configuration",
       {"bits 2,4,7","bits 6,7,8 (Rob Hordijks original design)"},
@@ -419,7 +660,10 @@ struct BenjolinOscWidget : VenomWidget {
     }
   }
 };
+#endif
 
 }
 
-Model* modelVenomBenjolinOsc = createModel<Venom::BenjolinOsc, Venom::BenjolinOscWidget>("BenjolinOsc");
+#ifndef VENOM_HEADLESS
+Model* modelVenomBenjolinOsc = Venom::createVenomModel<Venom::BenjolinOsc, Venom::BenjolinOscWidget>("BenjolinOsc");
+#endif
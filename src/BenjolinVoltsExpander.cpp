@@ -28,7 +28,7 @@ struct BenjolinVoltsExpanderWidget : BenjolinExpanderWidget {
     }
     addParam(createLockableParamCentered<RoundSmallBlackKnobLockable>(Vec(22.5f, 265.f), module, BenjolinModule::VOLTS_RANGE_PARAM));
     addParam(createLockableParamCentered<RoundSmallBlackKnobLockable>(Vec(22.5f, 299.f), module, BenjolinModule::VOLTS_OFFSET_PARAM));
-    addOutput(createOutputCentered<MonoPort>(Vec(22.5f,339.5f), module, BenjolinModule::VOLTS_OUTPUT));
+    addOutput(createOutputCentered<PolyPort>(Vec(22.5f,339.5f), module, BenjolinModule::VOLTS_OUTPUT));
     addChild(createLightCentered<SmallLight<YellowLight>>(Vec(6.f, 33.f), module, 0));
   }
   
@@ -46,4 +46,4 @@ struct BenjolinVoltsExpanderWidget : BenjolinExpanderWidget {
 
 }
 
-Model* modelVenomBenjolinVoltsExpander = createModel<Venom::BenjolinVoltsExpander, Venom::BenjolinVoltsExpanderWidget>("BenjolinVoltsExpander");
+Model* modelVenomBenjolinVoltsExpander = Venom::createVenomModel<Venom::BenjolinVoltsExpander, Venom::BenjolinVoltsExpanderWidget>("BenjolinVoltsExpander");
@@ -71,6 +71,7 @@ struct BernoulliSwitch : VenomModule {
 
   BernoulliSwitch() {
     venomConfig(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+    noiseUsed = true;
     configParam(PROB_PARAM, 0.f, 1.f, 0.5f, "Probability", "%", 0.f, 100.f, 0.f);
     configButton(TRIG_PARAM, "Manual 10V Trigger");
     configSwitch<FixedSwitchQuantity>(MODE_PARAM, 0, 2, 1, "Probability Mode", {"Toggle", "Swap", "Gate"});
@@ -219,7 +220,7 @@ struct BernoulliSwitch : VenomModule {
         for (int j=0; j<4 && c+j<channels; j++) {
           int cj = c + j;
           if(trig[cj].process(invTrig ? -trigIn.s[j] : trigIn.s[j], fall, rise)){
-            bool toss = (prob.s[j] == 1.0f || random::uniform() < prob.s[j]);
+            bool toss = (prob.s[j] == 1.0f || noise.uniform().s[j] < prob.s[j]);
             switch(mode) {
               case TOGGLE_MODE:
                 if (toss) swap[cj] = !swap[cj];
@@ -377,4 +378,4 @@ struct BernoulliSwitchWidget : VenomWidget {
 
 }
 
-Model* modelVenomBernoulliSwitch = createModel<Venom::BernoulliSwitch, Venom::BernoulliSwitchWidget>("BernoulliSwitch");
+Model* modelVenomBernoulliSwitch = Venom::createVenomModel<Venom::BernoulliSwitch, Venom::BernoulliSwitchWidget>("BernoulliSwitch");
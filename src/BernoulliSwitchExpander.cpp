@@ -66,4 +66,4 @@ struct BernoulliSwitchExpanderWidget : VenomWidget {
 
 }
 
-Model* modelVenomBernoulliSwitchExpander = createModel<Venom::BernoulliSwitchExpander, Venom::BernoulliSwitchExpanderWidget>("BernoulliSwitchExpander");
+Model* modelVenomBernoulliSwitchExpander = Venom::createVenomModel<Venom::BernoulliSwitchExpander, Venom::BernoulliSwitchExpanderWidget>("BernoulliSwitchExpander");
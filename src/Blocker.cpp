@@ -55,4 +55,4 @@ struct BlockerWidget : VenomWidget {
 
 }
 
-Model* modelVenomBlocker = createModel<Venom::Blocker, Venom::BlockerWidget>("Blocker");
+Model* modelVenomBlocker = Venom::createVenomModel<Venom::Blocker, Venom::BlockerWidget>("Blocker");
@@ -221,4 +221,4 @@ struct BypassWidget : VenomWidget {
 
 }
 
-Model* modelVenomBypass = createModel<Venom::Bypass, Venom::BypassWidget>("Bypass");
+Model* modelVenomBypass = Venom::createVenomModel<Venom::Bypass, Venom::BypassWidget>("Bypass");
@@ -112,4 +112,4 @@ struct CloneMergeWidget : CloneModuleWidget {
 
 }
 
-Model* modelVenomCloneMerge = createModel<Venom::CloneMerge, Venom::CloneMergeWidget>("CloneMerge");
+Model* modelVenomCloneMerge = Venom::createVenomModel<Venom::CloneMerge, Venom::CloneMergeWidget>("CloneMerge");
@@ -120,16 +120,17 @@ struct Compare2 : VenomModule {
     configOut(LSS_FF_OUTPUT,"XOR less flip flop");
 
     oversampleStages = 5;
+    oversampleFIR = true;
   }
 
   void setOversample() override {
-    oversample = oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())];
+    oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]);
     if (oversample > 1) {
       for (int s=0; s<4; s++){
         for (int i=0; i<INPUTS_LEN; i++)
           upSample[s][i].setOversample(oversample, oversampleStages);
         for (int i=0; i<OUTPUTS_LEN; i++)
-          downSample[s][i].setOversample(oversample, oversampleStages);
+          downSample[s][i].setOversample(oversample, oversampleStages, true);
       }
     }
   }
@@ -142,7 +143,7 @@ struct Compare2 : VenomModule {
     float_4 f4_0=float_4::zero(), f4_1=1.f, f4_2=2.f;
     
     // update oversample configuration
-    if (oversample != oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())])
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]))
       setOversample();
     // compute channel count
     int channels = 1;
@@ -350,4 +351,4 @@ struct Compare2Widget : VenomWidget {
 
 }
 
-Model* modelVenomCompare2 = createModel<Venom::Compare2, Venom::Compare2Widget>("Compare2");
+Model* modelVenomCompare2 = Venom::createVenomModel<Venom::Compare2, Venom::Compare2Widget>("Compare2");
@@ -206,4 +206,4 @@ struct CrossFade3DWidget : VenomWidget {
 
 }
 
-Model* modelVenomCrossFade3D = createModel<Venom::CrossFade3D, Venom::CrossFade3DWidget>("CrossFade3D");
+Model* modelVenomCrossFade3D = Venom::createVenomModel<Venom::CrossFade3D, Venom::CrossFade3DWidget>("CrossFade3D");
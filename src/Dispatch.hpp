@@ -0,0 +1,50 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#pragma once
+
+namespace Venom {
+
+// Runtime CPU dispatch for hot block kernels.
+// The plugin is built for the baseline instruction set, so a kernel that processes a block of data is
+// written once as an always inline function, and VENOM_DISPATCH compiles it again for AVX2 and AVX-512.
+// initSimdDispatch() sets simdLevel from the CPU features at plugin init, and the dispatcher calls the
+// best supported build. Kernels should loop over plain float arrays so the compiler can vectorize
+// them to the full width of each instruction set.
+enum SimdLevel {
+  SIMD_SSE,
+  SIMD_AVX2,
+  SIMD_AVX512
+};
+
+extern int simdLevel;
+void initSimdDispatch();
+const char* simdLevelName();
+
+#define VENOM_KERNEL __attribute__((always_inline)) inline
+
+// MinGW cannot align the stack for spilled AVX registers, so Windows builds stay on the baseline kernels
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(_WIN32)
+  #define VENOM_SIMD_DISPATCH 1
+  #define VENOM_TARGET_AVX2 __attribute__((target("avx2,fma")))
+  #define VENOM_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+
+  // Defines NAME as a dispatcher of NAME##Kernel built for each instruction set.
+  // PARAMS is the parenthesized parameter list and ARGS the matching parenthesized argument list.
+  #define VENOM_DISPATCH(NAME, PARAMS, ARGS) \
+    inline void NAME##SSE PARAMS { NAME##Kernel ARGS; } \
+    VENOM_TARGET_AVX2 inline void NAME##AVX2 PARAMS { NAME##Kernel ARGS; } \
+    VENOM_TARGET_AVX512 inline void NAME##AVX512 PARAMS { NAME##Kernel ARGS; } \
+    inline void NAME PARAMS { \
+      switch (simdLevel) { \
+        case SIMD_AVX512: NAME##AVX512 ARGS; break; \
+        case SIMD_AVX2: NAME##AVX2 ARGS; break; \
+        default: NAME##SSE ARGS; \
+      } \
+    }
+#else
+  #define VENOM_DISPATCH(NAME, PARAMS, ARGS) \
+    inline void NAME PARAMS { NAME##Kernel ARGS; }
+#endif
+
+}
@@ -3,14 +3,209 @@
 
 #pragma once
 #include "rack.hpp"
+#include "Dispatch.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
 
 namespace Venom {
 
+// oversampleStages value that selects the polyphase FIR instead of a biquad cascade
+static const int OVERSAMPLE_FIR = 6;
+
+// Linear phase half-band FIR used for a single 2x interpolation or decimation step.
+// Half of the half-band taps are zero, and the center tap is 0.5, so only the K symmetric
+// coefficient pairs of the odd phase are stored (normalized to sum to 0.25 for exact unity DC gain).
+// The interpolator never multiplies the zero stuffed samples, and the decimator only computes
+// the samples that are kept.
+template <typename T, int K>
+class HalfBandStage {
+  public:
+    void setKernel(const float* kernel) {
+      a = kernel;
+      reset();
+    }
+
+    void reset() {
+      for (int i=0; i<2*K; i++)
+        x[i] = T(0.f);
+      for (int i=0; i<K; i++)
+        center[i] = T(0.f);
+      centerPos = 0;
+    }
+
+    // one input sample produces two output samples
+    void upsample(T in, T* out) {
+      push(in);
+      out[0] = convolve() * 2.f;
+      out[1] = x[K-1];
+    }
+
+    // two input samples produce one output sample
+    T downsample(T in0, T in1) {
+      center[centerPos] = in0;
+      if (++centerPos == K)
+        centerPos = 0;
+      push(in1);
+      return convolve() + center[centerPos] * 0.5f;
+    }
+
+  private:
+    const float* a = NULL;
+    T x[2*K]{};
+    T center[K]{};
+    int centerPos = 0;
+
+    void push(T in) {
+      for (int i=2*K-1; i>0; i--)
+        x[i] = x[i-1];
+      x[0] = in;
+    }
+
+    T convolve() {
+      T sum = a[0] * (x[K-1] + x[K]);
+      for (int j=1; j<K; j++)
+        sum += a[j] * (x[K-1-j] + x[K+j]);
+      return sum;
+    }
+};
+
+// Half-band kernels designed with the Parks-McClellan algorithm for at least 62 dB stop band rejection
+static const float halfBandLongKernel[10] = { // passband to 0.4 of the lower sample rate
+  3.163484131e-01f, -9.979273190e-02f, 5.354785220e-02f, -3.222676845e-02f, 1.979503952e-02f,
+  -1.189069448e-02f, 6.778207119e-03f, -3.552198805e-03f, 1.631809133e-03f, -6.389273996e-04f
+};
+static const float halfBandMidKernel[3] = { // passband to 0.2 of the lower sample rate
+  2.983731596e-01f, -5.807118454e-02f, 9.698024972e-03f
+};
+static const float halfBandShortKernel[2] = { // passband to 0.1 of the lower sample rate or less
+  2.836824630e-01f, -3.368246305e-02f
+};
+
+// Cascade of 2x half-band stages supporting 2x through 32x oversampling.
+// The first stage (adjacent to the base sample rate) has a passband to 80% of the base Nyquist
+// and about 63 dB stop band rejection. Later stages have much wider transition bands, so they get
+// by with far shorter kernels at similar rejection.
+//
+// process() is a drop-in for the biquad cascades, called once per oversample step:
+//  - An interpolator follows the zero stuffing convention used throughout Venom, where the
+//    caller passes input*oversample on step 0 and zero on all other steps. The zero steps are skipped.
+//  - A decimator accepts every step, but only produces a new output on the final step of each
+//    group. The earlier steps return the prior output.
+// upsample() and downsample() are block alternatives that process a full group at once.
+template <typename T>
+class PolyphaseFIR {
+  public:
+    void setOversample(int oversample, bool decimate = false) {
+      down = decimate;
+      stageCnt = 0;
+      while ((1 << stageCnt) < oversample && stageCnt < 5)
+        stageCnt++;
+      inScale = 1.f / (1 << stageCnt);
+      long0.setKernel(halfBandLongKernel);
+      mid1.setKernel(halfBandMidKernel);
+      for (int i=0; i<3; i++)
+        short2[i].setKernel(halfBandShortKernel);
+      for (int i=0; i<5; i++) {
+        phase[i] = false;
+        held[i] = T(0.f);
+      }
+      out = T(0.f);
+    }
+
+    T process(T x) {
+      if (!stageCnt)
+        return x;
+      if (down) {
+        pushDown(0, x);
+        return out;
+      }
+      return pullUp(stageCnt-1, x);
+    }
+
+    void upsample(T x, T* dest) {
+      int n = 1 << stageCnt;
+      for (int i=0; i<n; i++)
+        dest[i] = process(i ? T(0.f) : x * static_cast<float>(n));
+    }
+
+    T downsample(const T* src) {
+      int n = 1 << stageCnt;
+      for (int i=0; i<n; i++)
+        process(src[i]);
+      return out;
+    }
+
+  private:
+    // stages are indexed by distance from the base rate: 0 = base <-> 2x, 1 = 2x <-> 4x, etc.
+    HalfBandStage<T, 10> long0;
+    HalfBandStage<T, 3> mid1;
+    HalfBandStage<T, 2> short2[3];
+    bool down = false;
+    int stageCnt = 0;
+    float inScale = 1.f;
+    bool phase[5]{};
+    T held[5]{};
+    T out{};
+
+    void upStage(int r, T in, T* dest) {
+      switch (r) {
+        case 0: long0.upsample(in, dest); break;
+        case 1: mid1.upsample(in, dest); break;
+        default: short2[r-2].upsample(in, dest);
+      }
+    }
+
+    T downStage(int r, T in0, T in1) {
+      switch (r) {
+        case 0: return long0.downsample(in0, in1);
+        case 1: return mid1.downsample(in0, in1);
+        default: return short2[r-2].downsample(in0, in1);
+      }
+    }
+
+    // returns the next output of stage r, only pulling from the stage below when a new input is needed
+    T pullUp(int r, T x) {
+      if (phase[r]) {
+        phase[r] = false;
+        return held[r];
+      }
+      T pair[2];
+      upStage(r, r ? pullUp(r-1, x) : x * inScale, pair);
+      held[r] = pair[1];
+      phase[r] = true;
+      return pair[0];
+    }
+
+    // feeds one sample into the decimator stage at position i (0 = highest rate)
+    void pushDown(int i, T x) {
+      if (!phase[i]) {
+        held[i] = x;
+        phase[i] = true;
+        return;
+      }
+      phase[i] = false;
+      T y = downStage(stageCnt-1-i, held[i], x);
+      if (i == stageCnt-1)
+        out = y;
+      else
+        pushDown(i+1, y);
+    }
+};
+
 class OversampleFilter {
   public:
     int stages = 3;
-    void setOversample(int oversample, int stageCnt = 3) {
+    // decimate is only relevant to OVERSAMPLE_FIR, which must know the filter direction
+    void setOversample(int oversample, int stageCnt = 3, bool decimate = false) {
       stages = stageCnt;
+      if (stages == OVERSAMPLE_FIR) {
+        fir.setOversample(oversample, decimate);
+        return;
+      }
       float cutoff = 1.f / oversample;
       switch (stages) {
         case 3:
@@ -37,6 +232,8 @@ class OversampleFilter {
     }
 
     float process(float x) {
+      if (stages == OVERSAMPLE_FIR)
+        return fir.process(x);
       for (int i=0; i<stages; i++)
         x = f[i].process(x);
       return x;
@@ -44,14 +241,231 @@ class OversampleFilter {
 
   private:
     rack::dsp::TBiquadFilter<float> f[5]{};
+    PolyphaseFIR<float> fir;
+};
+
+// Reserve functions of the FilterArena types in use, which refillFilterArenas() calls on the UI thread
+inline std::mutex& filterArenaMutex() {
+  static std::mutex m;
+  return m;
+}
+
+inline std::vector<void (*)()>& filterArenaReservers() {
+  static std::vector<void (*)()> list;
+  return list;
+}
+
+// Plugin wide pool of T objects for filter state that is only needed while a module oversamples.
+// Slots are carved from 64 KB chunks that are never returned to the system, and a released slot is
+// reused by the next acquire() of any module, so the state of active filters stays packed together
+// in memory while idle filters cost nothing but a pointer.
+// acquire() and release() use a lock free free list and never allocate, so they are safe on the audio thread.
+// The filter constructors, and refillFilterArenas() on every UI frame, call reserve() to keep a full chunk of
+// spare slots ready. If a burst of new filters drains every spare slot, acquire() returns NULL and the filter
+// is bypassed until the UI thread refills the pool.
+template <typename T>
+class FilterArena {
+  public:
+    // Returns a newly constructed T, or NULL if no slot is spare
+    static T* acquire() {
+      Slot* slot = pop();
+      return slot ? new (slot->data) T() : NULL;
+    }
+
+    static void release(T* obj) {
+      if (!obj)
+        return;
+      obj->~T();
+      push(reinterpret_cast<Slot*>(obj));
+    }
+
+    // Grows the pool if fewer than a chunk of slots are spare. Call off the audio thread.
+    static void reserve() {
+      static bool listed = addReserver();
+      (void)listed;
+      if (spare().load(std::memory_order_relaxed) < static_cast<int>(CHUNK_SLOTS))
+        grow(CHUNK_SLOTS);
+    }
+
+  private:
+    struct alignas(64) Slot {
+      unsigned char data[sizeof(T)];
+      uint32_t index;
+      std::atomic<uint32_t> next;
+    };
+
+    static const uint32_t CHUNK_SLOTS = sizeof(Slot) < 65536 ? 65536 / sizeof(Slot) : 1;
+    static const uint32_t MAX_CHUNKS = 4096;
+
+    static bool addReserver() {
+      std::lock_guard<std::mutex> lock(filterArenaMutex());
+      filterArenaReservers().push_back(&reserve);
+      return true;
+    }
+
+    static std::mutex& growMutex() {
+      static std::mutex m;
+      return m;
+    }
+
+    static std::atomic<Slot*>* chunks() {
+      static std::atomic<Slot*> table[MAX_CHUNKS];
+      return table;
+    }
+
+    static uint32_t& chunkCnt() {
+      static uint32_t cnt = 0;
+      return cnt;
+    }
+
+    // Free list head, holding a change count in the upper 32 bits so that a stale compare exchange
+    // fails even if the same slot is back on top, and the slot index + 1 (0 = empty) in the lower 32 bits
+    static std::atomic<uint64_t>& head() {
+      static std::atomic<uint64_t> h{0};
+      return h;
+    }
+
+    static std::atomic<int>& spare() {
+      static std::atomic<int> cnt{0};
+      return cnt;
+    }
+
+    static Slot* pop() {
+      uint64_t oldHead = head().load(std::memory_order_acquire);
+      while (uint32_t i = static_cast<uint32_t>(oldHead)) {
+        i--;
+        Slot* slot = chunks()[i / CHUNK_SLOTS].load(std::memory_order_acquire) + i % CHUNK_SLOTS;
+        uint64_t newHead = ((oldHead >> 32) + 1) << 32 | slot->next.load(std::memory_order_relaxed);
+        if (head().compare_exchange_weak(oldHead, newHead, std::memory_order_acq_rel, std::memory_order_acquire)) {
+          spare().fetch_sub(1, std::memory_order_relaxed);
+          return slot;
+        }
+      }
+      return NULL;
+    }
+
+    static void push(Slot* slot) {
+      uint64_t oldHead = head().load(std::memory_order_relaxed), newHead;
+      do {
+        slot->next.store(static_cast<uint32_t>(oldHead), std::memory_order_relaxed);
+        newHead = ((oldHead >> 32) + 1) << 32 | (slot->index + 1);
+      } while (!head().compare_exchange_weak(oldHead, newHead, std::memory_order_release, std::memory_order_relaxed));
+      spare().fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Adds a chunk unless another thread has already left at least minSpare slots spare
+    static void grow(int minSpare) {
+      std::lock_guard<std::mutex> lock(growMutex());
+      if (spare().load(std::memory_order_relaxed) >= minSpare)
+        return;
+      if (chunkCnt() >= MAX_CHUNKS)
+        throw std::bad_alloc();
+      unsigned char* raw = static_cast<unsigned char*>(std::malloc(CHUNK_SLOTS * sizeof(Slot) + 64));
+      if (!raw)
+        throw std::bad_alloc();
+      Slot* chunk = reinterpret_cast<Slot*>(raw + (64 - reinterpret_cast<uintptr_t>(raw) % 64) % 64);
+      uint32_t first = chunkCnt() * CHUNK_SLOTS;
+      for (uint32_t i=0; i<CHUNK_SLOTS; i++) {
+        new (&chunk[i].next) std::atomic<uint32_t>(0);
+        chunk[i].index = first + i;
+      }
+      chunks()[chunkCnt()++].store(chunk, std::memory_order_release);
+      for (uint32_t i=0; i<CHUNK_SLOTS; i++)
+        push(&chunk[i]);
+    }
 };
 
+// The state of an OversampleFilter_4 is acquired from a FilterArena the first time the filter processes
+// a sample, and released when the oversample rate drops to 1 or the owner calls release(), so filters
+// for unpatched inputs and disabled oversampling use no memory.
+// While the arena has no spare slot the filter outputs the running mean of the steps of the current frame,
+// which holds a zero stuffed input when upsampling and averages the steps when decimating, and it tries
+// again to acquire its state at the start of each frame.
 class OversampleFilter_4 {
   public:
     int stages = 3;
-    void setOversample(int oversample, int stageCnt = 3) {
+
+    OversampleFilter_4() {
+      FilterArena<State>::reserve();
+    }
+    OversampleFilter_4(const OversampleFilter_4&) = delete;
+    OversampleFilter_4& operator=(const OversampleFilter_4&) = delete;
+    ~OversampleFilter_4() {
+      release();
+    }
+
+    // decimate is only relevant to OVERSAMPLE_FIR, which must know the filter direction
+    void setOversample(int oversample, int stageCnt = 3, bool decimate = false) {
       stages = stageCnt;
-      float cutoff = 1.f / oversample;
+      rate = oversample;
+      down = decimate;
+      step = 0;
+      if (oversample < 2)
+        release();
+      else if (state)
+        configure();
+    }
+
+    rack::simd::float_4 process(rack::simd::float_4 x) {
+      if (!state && (step || !acquire())) {
+        sum = step ? sum + x : x;
+        if (++step >= rate)
+          step = 0;
+        return sum * (1.f / rate);
+      }
+      if (stages == OVERSAMPLE_FIR)
+        return state->fir.process(x);
+      for (int i=0; i<stages; i++)
+        x = state->f[i].process(x);
+      return x;
+    }
+
+    void release() {
+      FilterArena<State>::release(state);
+      state = NULL;
+    }
+
+    // Stores pointers to the biquad state values in dest (at most 20) and returns the count, so that a module can move
+    // channels between SIMD lanes. Returns 0 when not oversampling or when using the linear phase FIR.
+    int laneState(rack::simd::float_4** dest) {
+      if (rate < 2 || stages == OVERSAMPLE_FIR || (!state && !acquire()))
+        return 0;
+      int cnt = 0;
+      for (int i=0; i<stages; i++) {
+        rack::dsp::TBiquadFilter<rack::simd::float_4>& f = state->f[i];
+        dest[cnt++] = &f.x[0];
+        dest[cnt++] = &f.x[1];
+        dest[cnt++] = &f.y[0];
+        dest[cnt++] = &f.y[1];
+      }
+      return cnt;
+    }
+
+  private:
+    struct State {
+      rack::dsp::TBiquadFilter<rack::simd::float_4> f[5]{};
+      PolyphaseFIR<rack::simd::float_4> fir;
+    };
+    State* state = NULL;
+    int rate = 1;
+    bool down = false;
+    rack::simd::float_4 sum{}; // bypass running sum
+    int step = 0; // bypass step within the frame
+
+    bool acquire() {
+      state = FilterArena<State>::acquire();
+      if (state)
+        configure();
+      return state != NULL;
+    }
+
+    void configure() {
+      rack::dsp::TBiquadFilter<rack::simd::float_4>* f = state->f;
+      if (stages == OVERSAMPLE_FIR) {
+        state->fir.setOversample(rate, down);
+        return;
+      }
+      float cutoff = 1.f / rate;
       switch (stages) {
         case 3:
           cutoff *= 0.25f;
@@ -75,15 +489,274 @@ class OversampleFilter_4 {
           f[4].setParameters(rack::dsp::TBiquadFilter<rack::simd::float_4>::LOWPASS, cutoff, 3.1970f, 1);
       }
     }
+};
 
-    rack::simd::float_4 process(rack::simd::float_4 x) {
-      for (int i=0; i<stages; i++)
-        x = f[i].process(x);
-      return x;
+// Cascade of S biquads applied in place to the first L lanes of a block of oversample steps,
+// where each step of buf holds 16 lanes. Coefficients are b0, b1, b2, a1, a2 per stage, and state
+// holds x1, x2, y1, y2 per stage and lane. All L lanes are processed together so that the compiler
+// can split them into as many independent vectors as the target instruction set needs.
+template <int L, int S>
+VENOM_KERNEL void wideBiquadKernel(const float (*coef)[5], float (*state)[4][16], float* buf, int steps) {
+  float k[S][5], v[L];
+  for (int i=0; i<S; i++) {
+    for (int j=0; j<5; j++)
+      k[i][j] = coef[i][j];
+  }
+  for (int o=0; o<steps; o++, buf+=16) {
+    for (int l=0; l<L; l++)
+      v[l] = buf[l];
+    for (int i=0; i<S; i++) {
+      float *x1 = state[i][0], *x2 = state[i][1], *y1 = state[i][2], *y2 = state[i][3];
+      for (int l=0; l<L; l++) {
+        float out = k[i][0]*v[l] + k[i][1]*x1[l] + k[i][2]*x2[l] - k[i][3]*y1[l] - k[i][4]*y2[l];
+        x2[l] = x1[l];
+        x1[l] = v[l];
+        y2[l] = y1[l];
+        y1[l] = out;
+        v[l] = out;
+      }
+    }
+    for (int l=0; l<L; l++)
+      buf[l] = v[l];
+  }
+}
+
+template <int L>
+VENOM_KERNEL void wideBiquadStages(const float (*coef)[5], float (*state)[4][16], int stages, float* buf, int steps) {
+  switch (stages) {
+    case 3: wideBiquadKernel<L, 3>(coef, state, buf, steps); break;
+    case 4: wideBiquadKernel<L, 4>(coef, state, buf, steps); break;
+    default: wideBiquadKernel<L, 5>(coef, state, buf, steps);
+  }
+}
+
+// Biquad cascade over the first lanes (a multiple of 4) of a block.
+// AVX2 and AVX-512 split the lanes into as few 8 or 16 lane vectors as they can.
+VENOM_KERNEL void wideBiquadBlockKernel(const float (*coef)[5], float (*state)[4][16], int stages, float* buf, int steps, int lanes) {
+  switch (lanes) {
+    case 4: wideBiquadStages<4>(coef, state, stages, buf, steps); break;
+    case 8: wideBiquadStages<8>(coef, state, stages, buf, steps); break;
+    case 12: wideBiquadStages<12>(coef, state, stages, buf, steps); break;
+    default: wideBiquadStages<16>(coef, state, stages, buf, steps);
+  }
+}
+VENOM_DISPATCH(wideBiquadBlock, (const float (*coef)[5], float (*state)[4][16], int stages, float* buf, int steps, int lanes),
+               (coef, state, stages, buf, steps, lanes))
+
+// Biquad cascade for an OversampleFilter_4 with 3, 4, or 5 stages, stored as b0, b1, b2, a1, a2 per stage
+inline void oversampleCoefficients(float (*coef)[5], int oversample, int stages) {
+  static const float q[3][5] = {
+    {0.51763809f, 0.70710678f, 1.9318517f},
+    {0.5098f, 0.6013f, 0.9000f, 2.5268f},
+    {0.5062f, 0.5612f, 0.7071f, 1.1013f, 3.1970f}
+  };
+  float cutoff = (stages == 3 ? 0.25f : 0.4f) / oversample;
+  const float* stageQ = q[stages == 3 ? 0 : stages == 4 ? 1 : 2];
+  rack::dsp::TBiquadFilter<float> f;
+  for (int i=0; i<stages; i++) {
+    f.setParameters(rack::dsp::TBiquadFilter<float>::LOWPASS, cutoff, stageQ[i], 1);
+    coef[i][0] = f.b[0];
+    coef[i][1] = f.b[1];
+    coef[i][2] = f.b[2];
+    coef[i][3] = f.a[0];
+    coef[i][4] = f.a[1];
+  }
+}
+
+// Replaces each oversample step of the first simdCnt SIMD groups of a block with the mean of the steps up to it,
+// which stands in for an oversample filter without state: it holds a zero stuffed input when upsampling,
+// and leaves the mean of the block in the last step when decimating.
+inline void bypassOversampleBlock(rack::simd::float_4 (*buf)[4], int steps, int simdCnt) {
+  float k = 1.f / steps;
+  for (int s=0; s<simdCnt; s++) {
+    rack::simd::float_4 sum = 0.f;
+    for (int o=0; o<steps; o++) {
+      sum += buf[o][s];
+      buf[o][s] = sum * k;
+    }
+  }
+}
+
+// Oversample filter for up to 16 channels (4 float_4 SIMD groups) that filters a complete block of
+// oversample steps at once. The biquad coefficients are shared by all channels, and the state of each
+// channel is stored contiguously, so all active channels are processed with the widest vectors the CPU
+// supports (see Dispatch.hpp). A full 16 channel block runs as a single AVX-512 or two AVX2 iterations per stage and step.
+// The Linear phase FIR filter quality uses a PolyphaseFIR per SIMD group.
+// Like OversampleFilter_4, the state is acquired from a FilterArena on first use and released at oversample 1,
+// and the block is bypassed with bypassOversampleBlock() while the arena has no spare slot.
+class WideOversampleFilter {
+  public:
+    int stages = 3;
+
+    WideOversampleFilter() {
+      FilterArena<State>::reserve();
+    }
+    WideOversampleFilter(const WideOversampleFilter&) = delete;
+    WideOversampleFilter& operator=(const WideOversampleFilter&) = delete;
+    ~WideOversampleFilter() {
+      release();
+    }
+
+    // decimate is only relevant to OVERSAMPLE_FIR, which must know the filter direction
+    void setOversample(int oversample, int stageCnt = 3, bool decimate = false) {
+      stages = stageCnt;
+      rate = oversample;
+      down = decimate;
+      if (oversample < 2)
+        release();
+      else if (stages == OVERSAMPLE_FIR) {
+        if (state) {
+          for (int s=0; s<4; s++)
+            state->fir[s].setOversample(rate, down);
+        }
+      }
+      else
+        oversampleCoefficients(coef, oversample, stages);
+    }
+
+    // Filters a block in place, where buf[o][s] holds SIMD group s of oversample step o
+    void processBlock(rack::simd::float_4 (*buf)[4], int steps, int simdCnt) {
+      if (!state) {
+        if (!(state = FilterArena<State>::acquire())) {
+          bypassOversampleBlock(buf, steps, simdCnt);
+          return;
+        }
+        for (int s=0; s<4; s++)
+          state->fir[s].setOversample(rate, down);
+      }
+      if (stages == OVERSAMPLE_FIR) {
+        for (int o=0; o<steps; o++) {
+          for (int s=0; s<simdCnt; s++)
+            buf[o][s] = state->fir[s].process(buf[o][s]);
+        }
+        return;
+      }
+      wideBiquadBlock(coef, state->biquad, stages, reinterpret_cast<float*>(buf), steps, simdCnt * 4);
+    }
+
+    void release() {
+      FilterArena<State>::release(state);
+      state = NULL;
     }
 
   private:
-    rack::dsp::TBiquadFilter<rack::simd::float_4> f[5]{};
+    struct State {
+      alignas(64) float biquad[5][4][16]{};
+      PolyphaseFIR<rack::simd::float_4> fir[4];
+    };
+    float coef[5][5]{};
+    State* state = NULL;
+    int rate = 1;
+    bool down = false;
+};
+
+typedef float WideBiquadState[4][16];
+
+// Biquad cascades of several filters that share one set of coefficients, where filter i uses
+// state[i] and the first lanes[i] lanes of its own block of 32 steps by 16 lanes at buf[i]
+VENOM_KERNEL void wideBiquadBankKernel(const float (*coef)[5], int stages, int steps,
+                                       WideBiquadState* const* state, float* const* buf, const int* lanes, int cnt) {
+  for (int i=0; i<cnt; i++)
+    wideBiquadBlockKernel(coef, state[i], stages, buf[i], steps, lanes[i]);
+}
+VENOM_DISPATCH(wideBiquadBank, (const float (*coef)[5], int stages, int steps,
+                                WideBiquadState* const* state, float* const* buf, const int* lanes, int cnt),
+               (coef, stages, steps, state, buf, lanes, cnt))
+
+// Bank of N oversample filters for up to 16 channels each, such as all the CV input upsamplers of a module.
+// The biquad coefficients are stored once for the whole bank, and each filter keeps its state and block
+// together in one FilterArena slot, acquired the first time the module asks for its block and held until
+// the module releases it. A module fills the blocks of the filters it needs, queues them, and then
+// filters all of them in a single pass.
+// block() returns NULL while the arena has no spare slot, and the module then bypasses that filter for the block.
+// The Linear phase FIR filter quality uses a PolyphaseFIR per filter and SIMD group.
+template <int N>
+class OversampleFilterBank {
+  public:
+    int stages = 3;
+
+    OversampleFilterBank() {
+      FilterArena<Slot>::reserve();
+    }
+    OversampleFilterBank(const OversampleFilterBank&) = delete;
+    OversampleFilterBank& operator=(const OversampleFilterBank&) = delete;
+    ~OversampleFilterBank() {
+      for (int i=0; i<N; i++)
+        release(i);
+    }
+
+    // decimate is only relevant to OVERSAMPLE_FIR, which must know the filter direction
+    void setOversample(int oversample, int stageCnt = 3, bool decimate = false) {
+      stages = stageCnt;
+      rate = oversample;
+      down = decimate;
+      if (stages == OVERSAMPLE_FIR) {
+        for (int i=0; i<N; i++) {
+          for (int s=0; s<4 && slot[i]; s++)
+            slot[i]->fir[s].setOversample(rate, down);
+        }
+        return;
+      }
+      oversampleCoefficients(coef, oversample, stages);
+    }
+
+    // Block of filter i, where block(i)[o][s] holds SIMD group s of oversample step o, or NULL if it has no slot
+    rack::simd::float_4 (*block(int i))[4] {
+      if (!slot[i]) {
+        if (!(slot[i] = FilterArena<Slot>::acquire()))
+          return NULL;
+        for (int s=0; s<4; s++)
+          slot[i]->fir[s].setOversample(rate, down);
+      }
+      return slot[i]->buf;
+    }
+
+    // Returns the state and block of filter i to the arena
+    void release(int i) {
+      FilterArena<Slot>::release(slot[i]);
+      slot[i] = NULL;
+    }
+
+    // Adds filter i with simdCnt SIMD groups to the next process() pass, unless it has no slot
+    void queue(int i, int simdCnt) {
+      if (!slot[i])
+        return;
+      queued[cnt] = i;
+      state[cnt] = slot[i]->biquad;
+      buf[cnt] = reinterpret_cast<float*>(slot[i]->buf);
+      lanes[cnt++] = simdCnt * 4;
+    }
+
+    // Filters the blocks of all queued filters in place, then empties the queue
+    void process(int steps) {
+      if (stages == OVERSAMPLE_FIR) {
+        for (int i=0; i<cnt; i++) {
+          Slot* f = slot[queued[i]];
+          for (int o=0; o<steps; o++) {
+            for (int s=0; s<lanes[i]/4; s++)
+              f->buf[o][s] = f->fir[s].process(f->buf[o][s]);
+          }
+        }
+      }
+      else if (cnt)
+        wideBiquadBank(coef, stages, steps, state, buf, lanes, cnt);
+      cnt = 0;
+    }
+
+  private:
+    struct Slot {
+      alignas(64) float biquad[5][4][16]{};
+      alignas(64) rack::simd::float_4 buf[32][4]{};
+      PolyphaseFIR<rack::simd::float_4> fir[4];
+    };
+    float coef[5][5]{};
+    Slot* slot[N]{};
+    int rate = 1;
+    bool down = false;
+    // queue for the next process() pass
+    int queued[N]{}, lanes[N]{}, cnt = 0;
+    WideBiquadState* state[N]{};
+    float* buf[N]{};
 };
 
 class HighBlockFilter {
@@ -155,31 +828,101 @@ class DCBlockFilter {
     double r = 1. - 100. / static_cast<double>(APP->engine->getSampleRate ());
 };
 
+// The 4 lanes are filtered in double precision as two packed pairs, because the pole is too close
+// to 1 for float at high sample rates.
 class DCBlockFilter_4 {
   public:
   
     void init(int sampleRate, int oversample = 1){
-      r = 1. - 100. / static_cast<double>(sampleRate) / static_cast<double>(oversample);
+      r = _mm_set1_pd(1. - 100. / static_cast<double>(sampleRate) / static_cast<double>(oversample));
     }
   
     rack::simd::float_4 val() {
       return rtn;
     }
+
+    // Previous input and output of each lane, so that a module can move channels between SIMD lanes
+    void getState(double* x, double* y) {
+      _mm_storeu_pd(x, prevX[0]);
+      _mm_storeu_pd(x+2, prevX[1]);
+      _mm_storeu_pd(y, prevY[0]);
+      _mm_storeu_pd(y+2, prevY[1]);
+    }
+
+    void setState(const double* x, const double* y) {
+      prevX[0] = _mm_loadu_pd(x);
+      prevX[1] = _mm_loadu_pd(x+2);
+      prevY[0] = _mm_loadu_pd(y);
+      prevY[1] = _mm_loadu_pd(y+2);
+    }
     
     rack::simd::float_4 process( rack::simd::float_4 x, int over = 1 ) {
-      for (int i=0; i<4; i++){
-        double y = static_cast<double>(x[i]) - prevX[i] + r * prevY[i];
-        prevX[i] = static_cast<double>(x[i]);
-        prevY[i] = y;
-        rtn[i] = static_cast<float>(y);
-      }
+      __m128d xLo = _mm_cvtps_pd(x.v), xHi = _mm_cvtps_pd(_mm_movehl_ps(x.v, x.v));
+      __m128d yLo = _mm_add_pd(_mm_sub_pd(xLo, prevX[0]), _mm_mul_pd(r, prevY[0])),
+              yHi = _mm_add_pd(_mm_sub_pd(xHi, prevX[1]), _mm_mul_pd(r, prevY[1]));
+      prevX[0] = xLo;
+      prevX[1] = xHi;
+      prevY[0] = yLo;
+      prevY[1] = yHi;
+      rtn = rack::simd::float_4(_mm_movelh_ps(_mm_cvtpd_ps(yLo), _mm_cvtpd_ps(yHi)));
       return rtn;
     }
   
   private:
-    double prevX[4]{};
-    double prevY[4]{};
+    __m128d prevX[2]{_mm_setzero_pd(), _mm_setzero_pd()};
+    __m128d prevY[2]{_mm_setzero_pd(), _mm_setzero_pd()};
     rack::simd::float_4 rtn = rack::simd::float_4::zero();
+    __m128d r = _mm_set1_pd(1. - 100. / static_cast<double>(APP->engine->getSampleRate ()));
+};
+
+// DC block over the first lanes of a block of oversample steps, where each step of buf holds 16 lanes
+template <int L>
+VENOM_KERNEL void wideDCBlockKernel(double r, double (*state)[16], float* buf, int steps) {
+  double px[L], py[L];
+  for (int l=0; l<L; l++) {
+    px[l] = state[0][l];
+    py[l] = state[1][l];
+  }
+  for (int o=0; o<steps; o++, buf+=16) {
+    for (int l=0; l<L; l++) {
+      double x = buf[l], y = x - px[l] + r * py[l];
+      px[l] = x;
+      py[l] = y;
+      buf[l] = static_cast<float>(y);
+    }
+  }
+  for (int l=0; l<L; l++) {
+    state[0][l] = px[l];
+    state[1][l] = py[l];
+  }
+}
+
+VENOM_KERNEL void wideDCBlockBlockKernel(double r, double (*state)[16], float* buf, int steps, int lanes) {
+  switch (lanes) {
+    case 4: wideDCBlockKernel<4>(r, state, buf, steps); break;
+    case 8: wideDCBlockKernel<8>(r, state, buf, steps); break;
+    case 12: wideDCBlockKernel<12>(r, state, buf, steps); break;
+    default: wideDCBlockKernel<16>(r, state, buf, steps);
+  }
+}
+VENOM_DISPATCH(wideDCBlockBlock, (double r, double (*state)[16], float* buf, int steps, int lanes), (r, state, buf, steps, lanes))
+
+// DC block filter for up to 16 channels (4 float_4 SIMD groups) that filters a complete block of
+// oversample steps at once, with the same response as DCBlockFilter_4.
+// AVX2 and AVX-512 process 4 or 8 double lanes per instruction.
+class WideDCBlockFilter {
+  public:
+    void init(int sampleRate, int oversample = 1){
+      r = 1. - 100. / static_cast<double>(sampleRate) / static_cast<double>(oversample);
+    }
+
+    // Filters a block in place, where buf[o][s] holds SIMD group s of oversample step o
+    void processBlock(rack::simd::float_4 (*buf)[4], int steps, int simdCnt) {
+      wideDCBlockBlock(r, state, reinterpret_cast<float*>(buf), steps, simdCnt * 4);
+    }
+
+  private:
+    alignas(64) double state[2][16]{};
     double r = 1. - 100. / static_cast<double>(APP->engine->getSampleRate ());
 };
 
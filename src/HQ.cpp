@@ -328,4 +328,4 @@ struct HQWidget : VenomWidget {
 
 }
 
-Model* modelVenomHQ = createModel<Venom::HQ, Venom::HQWidget>("HQ");
+Model* modelVenomHQ = Venom::createVenomModel<Venom::HQ, Venom::HQWidget>("HQ");
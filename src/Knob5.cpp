@@ -406,4 +406,4 @@ struct Knob5Widget : VenomWidget {
 
 }
 
-Model* modelVenomKnob5 = createModel<Venom::Knob5, Venom::Knob5Widget>("Knob5");
+Model* modelVenomKnob5 = Venom::createVenomModel<Venom::Knob5, Venom::Knob5Widget>("Knob5");
@@ -209,4 +209,4 @@ struct LinearBeatsWidget : VenomWidget {
 
 }
 
-Model* modelVenomLinearBeats = createModel<Venom::LinearBeats, Venom::LinearBeatsWidget>("LinearBeats");
+Model* modelVenomLinearBeats = Venom::createVenomModel<Venom::LinearBeats, Venom::LinearBeatsWidget>("LinearBeats");
@@ -97,4 +97,4 @@ struct LinearBeatsExpanderWidget : VenomWidget {
 
 }
 
-Model* modelVenomLinearBeatsExpander = createModel<Venom::LinearBeatsExpander, Venom::LinearBeatsExpanderWidget>("LinearBeatsExpander");
+Model* modelVenomLinearBeatsExpander = Venom::createVenomModel<Venom::LinearBeatsExpander, Venom::LinearBeatsExpanderWidget>("LinearBeatsExpander");
@@ -95,6 +95,7 @@ struct Logic : VenomModule {
     }
     
     oversampleStages = 5;
+    oversampleFIR = true;
   }
   
   void setOversample() override {
@@ -104,7 +105,7 @@ struct Logic : VenomModule {
       for (int pi=0; pi<4; pi++){
         aUpSample[c][pi].setOversample(oversample, oversampleStages);
         bUpSample[c][pi].setOversample(oversample, oversampleStages);
-        outDownSample[c][pi].setOversample(oversample, oversampleStages);
+        outDownSample[c][pi].setOversample(oversample, oversampleStages, true);
       }
     }
   }
@@ -113,8 +114,8 @@ struct Logic : VenomModule {
     VenomModule::process(args);
     using float_4 = simd::float_4;
     using int32_4 = simd::int32_4;
-    if (oversample != oversampleValues[params[OVER_PARAM].getValue()]) {
-      oversample = oversampleValues[params[OVER_PARAM].getValue()];
+    if (oversample != governedOversample(oversampleValues[params[OVER_PARAM].getValue()])) {
+      oversample = governedOversample(oversampleValues[params[OVER_PARAM].getValue()]);
       setOversample();
       sampleRate = 0;
     }
@@ -371,4 +372,4 @@ struct LogicWidget : VenomWidget {
 
 }
 
-Model* modelVenomLogic = createModel<Venom::Logic, Venom::LogicWidget>("Logic");
+Model* modelVenomLogic = Venom::createVenomModel<Venom::Logic, Venom::LogicWidget>("Logic");
@@ -116,4 +116,4 @@ struct Merge4x2Widget : VenomWidget {
 
 }
 
-Model* modelVenomMerge4x2 = createModel<Venom::Merge4x2, Venom::Merge4x2Widget>("Merge4x2");
+Model* modelVenomMerge4x2 = Venom::createVenomModel<Venom::Merge4x2, Venom::Merge4x2Widget>("Merge4x2");
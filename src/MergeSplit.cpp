@@ -173,4 +173,4 @@ struct MergeSplitWidget : VenomWidget {
 
 }
 
-Model* modelVenomMergeSplit = createModel<Venom::MergeSplit, Venom::MergeSplitWidget>("MergeSplit");
+Model* modelVenomMergeSplit = Venom::createVenomModel<Venom::MergeSplit, Venom::MergeSplitWidget>("MergeSplit");
@@ -8,6 +8,8 @@
 
 namespace Venom {
 
+std::atomic<int> mixChainVersion{0};
+
 struct Mix4 : MixBaseModule {
   enum ParamId {
     ENUMS(LEVEL_PARAMS, 4),
@@ -309,4 +311,4 @@ struct Mix4Widget : MixBaseWidget {
 
 }
 
-Model* modelVenomMix4 = createModel<Venom::Mix4, Venom::Mix4Widget>("Mix4");
+Model* modelVenomMix4 = Venom::createVenomModel<Venom::Mix4, Venom::Mix4Widget>("Mix4");
@@ -394,6 +394,7 @@ struct Mix4Stereo : MixBaseModule {
 
 };
 
+#ifndef VENOM_HEADLESS
 struct Mix4StereoWidget : MixBaseWidget {
   
   Mix4StereoWidget(Mix4Stereo* module) {
@@ -423,7 +424,10 @@ struct Mix4StereoWidget : MixBaseWidget {
   }
 
 };
+#endif
 
 }
 
-Model* modelVenomMix4Stereo = createModel<Venom::Mix4Stereo, Venom::Mix4StereoWidget>("Mix4Stereo");
+#ifndef VENOM_HEADLESS
+Model* modelVenomMix4Stereo = Venom::createVenomModel<Venom::Mix4Stereo, Venom::Mix4StereoWidget>("Mix4Stereo");
+#endif
@@ -57,4 +57,4 @@ struct MixFadeWidget : MixExpanderWidget {
 
 }
 
-Model* modelVenomMixFade = createModel<Venom::MixFade, Venom::MixFadeWidget>("MixFade");
+Model* modelVenomMixFade = Venom::createVenomModel<Venom::MixFade, Venom::MixFadeWidget>("MixFade");
@@ -64,4 +64,4 @@ struct MixFade2Widget : MixExpanderWidget {
 
 }
 
-Model* modelVenomMixFade2 = createModel<Venom::MixFade2, Venom::MixFade2Widget>("MixFade2");
+Model* modelVenomMixFade2 = Venom::createVenomModel<Venom::MixFade2, Venom::MixFade2Widget>("MixFade2");
@@ -1,5 +1,9 @@
 namespace Venom {
 
+// Incremented whenever any mixer module gains or loses a neighbour or is bypassed or unbypassed,
+// so base modules only rebuild their expander plan after the chain topology may have changed.
+extern std::atomic<int> mixChainVersion;
+
 struct MixModule : VenomModule {
   
   enum MixTypeId {
@@ -166,6 +170,15 @@ struct MixModule : VenomModule {
       rightExpander = dynamic_cast<MixModule*>(getRightExpander().module);
     else
       leftExpander = dynamic_cast<MixModule*>(getLeftExpander().module);
+    mixChainVersion++;
+  }
+
+  void onBypass(const BypassEvent& e) override {
+    mixChainVersion++;
+  }
+
+  void onUnBypass(const UnBypassEvent& e) override {
+    mixChainVersion++;
   }
 
 };
@@ -185,10 +198,19 @@ struct MixBaseModule : MixModule {
   MixModule* fadeExpander = NULL;
   MixModule* expanders[16]{};
   unsigned int expandersCnt = 0;
+  int planVersion = -1;
 
   void process(const ProcessArgs& args) override {
     VenomModule::process(args);
+    if (planVersion != mixChainVersion.load(std::memory_order_acquire)) {
+      planVersion = mixChainVersion.load(std::memory_order_acquire);
+      buildExpanderPlan();
+    }
+  }
 
+  // Resolves the ordered list of active expanders to the right, which process() of the derived mixer
+  // then executes every sample without walking the chain again.
+  void buildExpanderPlan() {
     mutePresent = false;
     offsetPresent = false;
     panPresent = false;
@@ -268,6 +290,7 @@ struct MixBaseModule : MixModule {
 
 };
 
+#ifndef VENOM_HEADLESS
 struct MixBaseWidget : VenomWidget {
 
   struct ModeSwitch : GlowingSvgSwitchLockable {
@@ -431,5 +454,6 @@ struct MixExpanderWidget : VenomWidget {
     VenomWidget::step();
   }  
 };
+#endif
 
 }
\ No newline at end of file
@@ -63,4 +63,4 @@ struct MixMuteWidget : MixExpanderWidget {
 
 }
 
-Model* modelVenomMixMute = createModel<Venom::MixMute, Venom::MixMuteWidget>("MixMute");
+Model* modelVenomMixMute = Venom::createVenomModel<Venom::MixMute, Venom::MixMuteWidget>("MixMute");
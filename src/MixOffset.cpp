@@ -48,4 +48,4 @@ struct MixOffsetWidget : MixExpanderWidget {
 
 }
 
-Model* modelVenomMixOffset = createModel<Venom::MixOffset, Venom::MixOffsetWidget>("MixOffset");
+Model* modelVenomMixOffset = Venom::createVenomModel<Venom::MixOffset, Venom::MixOffsetWidget>("MixOffset");
@@ -49,4 +49,4 @@ struct MixPanWidget : MixExpanderWidget {
 
 }
 
-Model* modelVenomMixPan = createModel<Venom::MixPan, Venom::MixPanWidget>("MixPan");
+Model* modelVenomMixPan = Venom::createVenomModel<Venom::MixPan, Venom::MixPanWidget>("MixPan");
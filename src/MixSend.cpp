@@ -73,4 +73,4 @@ struct MixSendWidget : MixExpanderWidget {
 
 }
 
-Model* modelVenomMixSend = createModel<Venom::MixSend, Venom::MixSendWidget>("MixSend");
+Model* modelVenomMixSend = Venom::createVenomModel<Venom::MixSend, Venom::MixSendWidget>("MixSend");
@@ -58,4 +58,4 @@ struct MixSoloWidget : MixExpanderWidget {
 
 }
 
-Model* modelVenomMixSolo = createModel<Venom::MixSolo, Venom::MixSoloWidget>("MixSolo");
+Model* modelVenomMixSolo = Venom::createVenomModel<Venom::MixSolo, Venom::MixSoloWidget>("MixSolo");
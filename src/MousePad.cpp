@@ -193,4 +193,4 @@ struct MousePadWidget : VenomWidget {
 
 }
 
-Model* modelVenomMousePad = createModel<Venom::MousePad, Venom::MousePadWidget>("MousePad");
+Model* modelVenomMousePad = Venom::createVenomModel<Venom::MousePad, Venom::MousePadWidget>("MousePad");
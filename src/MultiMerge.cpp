@@ -206,4 +206,4 @@ struct MultiMergeWidget : VenomWidget {
 
 }
 
-Model* modelVenomMultiMerge = createModel<Venom::MultiMerge, Venom::MultiMergeWidget>("MultiMerge");
+Model* modelVenomMultiMerge = Venom::createVenomModel<Venom::MultiMerge, Venom::MultiMergeWidget>("MultiMerge");
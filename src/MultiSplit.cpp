@@ -223,4 +223,4 @@ struct MultiSplitWidget : VenomWidget {
 
 }
 
-Model* modelVenomMultiSplit = createModel<Venom::MultiSplit, Venom::MultiSplitWidget>("MultiSplit");
+Model* modelVenomMultiSplit = Venom::createVenomModel<Venom::MultiSplit, Venom::MultiSplitWidget>("MultiSplit");
@@ -515,4 +515,4 @@ struct NORS_IQWidget : VenomWidget {
 
 }
 
-Model* modelVenomNORS_IQ = createModel<Venom::NORS_IQ, Venom::NORS_IQWidget>("NORS_IQ");
+Model* modelVenomNORS_IQ = Venom::createVenomModel<Venom::NORS_IQ, Venom::NORS_IQWidget>("NORS_IQ");
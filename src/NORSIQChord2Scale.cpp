@@ -103,4 +103,4 @@ struct NORSIQChord2ScaleWidget : VenomWidget {
 
 }
 
-Model* modelVenomNORSIQChord2Scale = createModel<Venom::NORSIQChord2Scale, Venom::NORSIQChord2ScaleWidget>("NORSIQChord2Scale");
+Model* modelVenomNORSIQChord2Scale = Venom::createVenomModel<Venom::NORSIQChord2Scale, Venom::NORSIQChord2ScaleWidget>("NORSIQChord2Scale");
@@ -0,0 +1,71 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#pragma once
+#include "rack.hpp"
+#include <cstdint>
+
+namespace Venom {
+
+// Vectorized xoshiro128+ pseudo random generator with 4 independent lanes, so each call fills a whole float_4
+// for about the cost of a single scalar random::uniform(). The sequence depends only on the seed, so a module
+// can replay identical noise by saving its seed with the patch.
+// Block kernels that need more than 4 lanes at once can use fill().
+class SimdNoise {
+  public:
+    SimdNoise(uint64_t seedVal = 0x9E3779B97F4A7C15ull) {
+      seed(seedVal);
+    }
+
+    // Expands the 64 bit seed into the 4 lane state with splitmix64
+    void seed(uint64_t seedVal) {
+      alignas(16) uint32_t st[4][4];
+      for (int i=0; i<4; i++) {
+        for (int l=0; l<4; l+=2) {
+          uint64_t z = (seedVal += 0x9E3779B97F4A7C15ull);
+          z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+          z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+          z ^= z >> 31;
+          st[i][l] = static_cast<uint32_t>(z);
+          st[i][l+1] = static_cast<uint32_t>(z >> 32);
+        }
+        s[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(st[i]));
+      }
+    }
+
+    // 32 random bits per lane
+    __m128i next() {
+      __m128i rtn = _mm_add_epi32(s[0], s[3]),
+              t = _mm_slli_epi32(s[1], 9);
+      s[2] = _mm_xor_si128(s[2], s[0]);
+      s[3] = _mm_xor_si128(s[3], s[1]);
+      s[1] = _mm_xor_si128(s[1], s[2]);
+      s[0] = _mm_xor_si128(s[0], s[3]);
+      s[2] = _mm_xor_si128(s[2], t);
+      s[3] = _mm_or_si128(_mm_slli_epi32(s[3], 11), _mm_srli_epi32(s[3], 21));
+      return rtn;
+    }
+
+    // Uniform in [0, 1) per lane, using the top 23 bits as the mantissa of a float in [1, 2)
+    rack::simd::float_4 uniform() {
+      __m128i bits = _mm_or_si128(_mm_srli_epi32(next(), 9), _mm_set1_epi32(0x3F800000));
+      return rack::simd::float_4(_mm_castsi128_ps(bits)) - 1.f;
+    }
+
+    // Uniform in [-1, 1) per lane
+    rack::simd::float_4 bipolar() {
+      __m128i bits = _mm_or_si128(_mm_srli_epi32(next(), 9), _mm_set1_epi32(0x40000000));
+      return rack::simd::float_4(_mm_castsi128_ps(bits)) - 3.f;
+    }
+
+    // Fills cnt floats (a multiple of 4) with uniform values in [0, 1)
+    void fill(float* dest, int cnt) {
+      for (int i=0; i<cnt; i+=4)
+        uniform().store(dest + i);
+    }
+
+  private:
+    __m128i s[4];
+};
+
+}
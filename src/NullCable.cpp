@@ -160,4 +160,4 @@ struct NullCableWidget : VenomWidget {
 
 }
 
-Model* modelVenomNullCable = createModel<Venom::NullCable, Venom::NullCableWidget>("NullCable");
+Model* modelVenomNullCable = Venom::createVenomModel<Venom::NullCable, Venom::NullCableWidget>("NullCable");
@@ -106,8 +106,8 @@ struct Octaver : VenomModule {
 
   void process(const ProcessArgs& args) override {
     VenomModule::process(args);
-    if (oversample != overVals[static_cast<int>(params[OVER_PARAM].getValue())]){
-      oversample = overVals[static_cast<int>(params[OVER_PARAM].getValue())];
+    if (oversample != governedOversample(overVals[static_cast<int>(params[OVER_PARAM].getValue())], overVals, 3)){
+      oversample = governedOversample(overVals[static_cast<int>(params[OVER_PARAM].getValue())], overVals, 3);
       setOversample();
       sampleRate = 0.f;
     }
@@ -182,6 +182,7 @@ struct Octaver : VenomModule {
   
 };
 
+#ifndef VENOM_HEADLESS
 struct OctaverWidget : VenomWidget {
 
   struct ModeSwitch : GlowingSvgSwitchLockable {
@@ -231,7 +232,10 @@ struct OctaverWidget : VenomWidget {
   }
   
 };
+#endif
 
 }
 
-Model* modelVenomOctaver = createModel<Venom::Octaver, Venom::OctaverWidget>("Octaver");
+#ifndef VENOM_HEADLESS
+Model* modelVenomOctaver = Venom::createVenomModel<Venom::Octaver, Venom::OctaverWidget>("Octaver");
+#endif
@@ -4,6 +4,8 @@
 #include "Venom.hpp"
 #include "Filter.hpp"
 #include "math.hpp"
+#include "PolyBLEP.hpp"
+#include "Wavetable.hpp"
 #include <float.h>
 
 #define GRID_PARAM  SIN_SHAPE_PARAM
@@ -185,6 +187,8 @@ struct Oscillator : VenomModule {
 
   bool clampLevel = true;
   bool disableDPW = false;
+  bool polyBLEP = false;
+  bool wavetable = false;
   bool disableOver[INPUTS_LEN]{};
   bool unity5[5]{};
   bool bipolar[5]{};
@@ -196,14 +200,23 @@ struct Oscillator : VenomModule {
   bool softSync = false;
   bool alternate = false;
   bool aliasSuppress = false;
+  bool blepActive = false;
+  bool subSampleSync = true; // off for patches saved before the option existed
+  bool subSample = false; // sync and reverse events are timed within the step (PolyBLEP or subSampleSync in audio frequency modes)
+  bool tableActive = false; // sine, triangle and saw read band limited wavetables (audio frequency modes)
+  enum AntiAlias { AA_NONE, AA_DPW, AA_BLEP, AA_TABLE };
+  const MipmapWavetable* shapeTable[4]{}; // Sin, Tri, unused, Saw
+  int antiAlias = AA_NONE;
   using float_4 = simd::float_4;
   int oversample = -1, sampleRate = 0;
   std::vector<int> oversampleValues = {1,2,4,8,16,32};
-  OversampleFilter_4 expUpSample[4]{}, linUpSample[4]{}, revUpSample[4]{}, syncUpSample[4]{},
-                     shapeUpSample[4][5]{}, phaseUpSample[4][5]{}, offsetUpSample[4][5]{}, levelUpSample[4][5]{},
-                     outDownSample[4][5]{};
+  OversampleFilterBank<INPUTS_LEN> upSample; // indexed by input id
+  OversampleFilterBank<5> outDownSample; // Sin, Tri, Sqr, Saw, Mix
+  float_4 outDirect[5][4]{}; // output of each waveform and SIMD group without oversampling
+  float_4 (*outBuf[5])[4]{}; // block of final output values of each waveform, see prepareOutputs()
   float_4 phasor[4]{}, phasorDir[4]{{1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}};
-  DCBlockFilter_4 dcBlockFilter[4][6]{}; // Sin, Tri, Sqr, Saw, Mix, Lin FM Input
+  DCBlockFilter_4 linDcBlockFilter[4]{};
+  WideDCBlockFilter outDcBlockFilter[5]{}; // Sin, Tri, Sqr, Saw, Mix
   bool linDCCouple = false;
   bool linNoThru0 = false;
   dsp::SchmittTrigger syncTrig[16], revTrig[16];
@@ -215,6 +228,30 @@ struct Oscillator : VenomModule {
   bool gated = false;
   float_4 onceActive[4]{};
   int modeDefaultOver[3] = {2, 0, 2};
+  bool procOver[INPUTS_LEN]{};
+  bool heldIn[INPUTS_LEN]{}; // inputs read once per frame and held for every oversample step
+  bool dcBlock = false;
+  float_4 syncPrev[4]{}, revPrev[4]{}, blepRaw[4][4]{};
+  PolyBLEP<float_4> blep[4][4]{};
+
+  // Values handed from the main phasor loop to the waveform kernels, indexed by oversample step and SIMD group.
+  // Every value a kernel reads is written earlier in the same process() call, so all instances share one
+  // scratch block per engine thread instead of each holding its own.
+  struct Block {
+    float_4 globalPhasor[32][4]{}, basePhaseDelta[32][4]{}, lowFreq[32][4]{}, denInv[32][4]{}, active[32][4]{},
+            mixOut[32][4]{}, mixDiv[32][4]{}, out[5][4]{};
+    // Output blocks of waveforms whose downsampling filter has no bank slot, which are decimated by their mean
+    float_4 bypass[5][32][4]{};
+    // PolyBLEP only: phase change (also wavetables), sync and reverse events with the fraction of the step since each event,
+    // and the phase jump of each sync reset
+    float_4 phaseDelta[32][4]{}, sync[32][4]{}, syncD[32][4]{}, syncJump[32][4]{}, rev[32][4]{}, revD[32][4]{};
+  };
+  Block* blk = NULL;
+
+  static Block& scratchBlock() {
+    static thread_local Block block;
+    return block;
+  }
   
   struct SinQuantity : ParamQuantity {
     float getDisplayValue() override {
@@ -386,9 +423,10 @@ struct Oscillator : VenomModule {
     }
     
     oversampleStages = 5;
+    oversampleFIR = true;
   }
 
-  float_4 sinSimd_1000(float_4 t) {
+  static float_4 sinSimd_1000(float_4 t) {
     t = simd::ifelse(t > 500.f, 1000.f - t, t) * 0.002f - 0.5f;
     float_4 t2 = t * t;
     return -(((-0.540347 * t2 + 2.53566) * t2 - 5.16651) * t2 + 3.14159) * t;
@@ -406,7 +444,11 @@ struct Oscillator : VenomModule {
   void setMode(bool shortCircuit = false) {
     currentMode = static_cast<int>(params[MODE_PARAM].getValue());
     mode = currentMode>5 ? 1 : currentMode>2 ? 0 : currentMode;
-    aliasSuppress = !mode && !disableDPW;
+    blepActive = mode!=1 && polyBLEP;
+    subSample = mode!=1 && (polyBLEP || subSampleSync);
+    tableActive = mode!=1 && wavetable;
+    aliasSuppress = !mode && !disableDPW && !polyBLEP;
+    antiAlias = blepActive ? AA_BLEP : aliasSuppress ? AA_DPW : AA_NONE;
     paramQuantities[FREQ_PARAM]->unit = mode==1 && lfoAsBPM ? " BPM" : " Hz";
     if (shortCircuit)
       return;
@@ -437,19 +479,10 @@ struct Oscillator : VenomModule {
   }
   
   void setOversample() override {
-    for (int i=0; i<4; i++){
-      expUpSample[i].setOversample(oversample, oversampleStages);
-      linUpSample[i].setOversample(oversample, oversampleStages);
-      revUpSample[i].setOversample(oversample, oversampleStages);
-      syncUpSample[i].setOversample(oversample, oversampleStages);
-      for (int j=0; j<5; j++){
-        shapeUpSample[i][j].setOversample(oversample, oversampleStages);
-        phaseUpSample[i][j].setOversample(oversample, oversampleStages);
-        offsetUpSample[i][j].setOversample(oversample, oversampleStages);
-        levelUpSample[i][j].setOversample(oversample, oversampleStages);
-        outDownSample[i][j].setOversample(oversample, oversampleStages);
-      }
-    }
+    upSample.setOversample(oversample, oversampleStages);
+    outDownSample.setOversample(oversample, oversampleStages, true);
+    for (int i=0; i<INPUTS_LEN; i++)
+      upSample.release(i);
   }    
   
   void loadPhases(float_4* phases, float_4 phasor, float_4 delta){
@@ -478,24 +511,507 @@ struct Oscillator : VenomModule {
     return ((buffer[0] - buffer[1] - buffer[1] + buffer[2])*denInv + 1.f) / 2.f;
   }
 
+  // Loads the oversample steps of every CV input that the current block upsamples, and filters them
+  // all in a single pass of the filter bank. The filters of inputs that are not upsampled are released,
+  // while those of inputs that are only unused for now keep their slot. An input whose filter has no
+  // slot is held for the block instead.
+  void upsampleInputs(int simdCnt, const bool* procWave, bool mixShape) {
+    bool used[INPUTS_LEN]{};
+    for (int w=0; w<5; w++)
+      used[SIN_SHAPE_INPUT+w] = used[SIN_PHASE_INPUT+w] = used[SIN_OFFSET_INPUT+w] = used[SIN_LEVEL_INPUT+w] = procWave[w];
+    used[MIX_SHAPE_INPUT] = procWave[MIX] && mixShape;
+    used[EXP_INPUT] = !alternate;
+    used[LIN_INPUT] = used[REV_INPUT] = used[SYNC_INPUT] = used[MIX_PHASE_INPUT] = true;
+    for (int id=0; id<INPUTS_LEN; id++) {
+      if (!procOver[id])
+        upSample.release(id);
+      if (!procOver[id] || !used[id])
+        continue;
+      int groups = inputs[id].isPolyphonic() ? simdCnt : 1;
+      float_4 (*buf)[4] = upSample.block(id);
+      if (!buf) {
+        procOver[id] = false;
+        heldIn[id] = true;
+        continue;
+      }
+      for (int s=0, c=0; s<groups; s++, c+=4) {
+        buf[0][s] = inputs[id].getPolyVoltageSimd<float_4>(c) * static_cast<float>(oversample);
+        for (int o=1; o<oversample; o++)
+          buf[o][s] = float_4::zero();
+      }
+      upSample.queue(id, groups);
+    }
+    upSample.process(oversample);
+  }
+
+  // Reads a CV input for one oversample step and SIMD group from the upsampled block or directly.
+  // A monophonic input preserves the prior value for SIMD groups after the first.
+  void upsampleInput(float_4& val, int id, int o, int s, int c) {
+    if (s==0 || inputs[id].isPolyphonic()) {
+      if (procOver[id])
+        val = upSample.block(id)[o][s];
+      else
+        val = (o && !heldIn[id]) ? float_4::zero() : inputs[id].getPolyVoltageSimd<float_4>(c);
+    }
+  }
+
+  // Picks the block of final output values of each waveform for the current block: its filter bank block
+  // while oversampling, or the scratch bypass block if the filter has no slot
+  void prepareOutputs(const bool* procWave) {
+    for (int w=0; w<5; w++) {
+      outBuf[w] = oversample<2 ? &outDirect[w] : procWave[w] ? outDownSample.block(w) : NULL;
+      if (!outBuf[w])
+        outBuf[w] = blk->bypass[w];
+    }
+  }
+
+  // Block of final output values of one waveform
+  float_4 (*outBlock(int w))[4] {
+    return outBuf[w];
+  }
+
+  // Applies one shot gating to a final output value
+  void finishOutput(int w, int o, int s, float_4 out) {
+    if (once)
+      out = simd::ifelse(blk->active[o][s]==float_4::zero(), float_4::zero(), out);
+    outBlock(w)[o][s] = out;
+  }
+
+  // Applies DC removal to the final output values of one waveform for the whole block,
+  // and queues the block for downsampling
+  void finishBlock(int w, int simdCnt) {
+    if (dcBlock && outputs[SIN_OUTPUT+w].isConnected())
+      outDcBlockFilter[w].processBlock(outBlock(w), oversample, simdCnt);
+    if (oversample>1 && outputs[SIN_OUTPUT+w].isConnected())
+      outDownSample.queue(w, simdCnt);
+  }
+
+  // Downsamples the queued waveform outputs in a single pass of the filter bank,
+  // and releases the blocks of unused waveforms
+  void downsampleOutputs(int simdCnt, const bool* procWave) {
+    outDownSample.process(oversample);
+    for (int w=0; w<5; w++) {
+      if (procWave[w] && oversample>1) {
+        if (outBuf[w] == blk->bypass[w])
+          bypassOversampleBlock(outBuf[w], oversample, simdCnt);
+        for (int s=0; s<simdCnt; s++)
+          blk->out[w][s] = outBuf[w][oversample-1][s];
+      }
+      else {
+        for (int s=0; procWave[w] && s<simdCnt; s++)
+          blk->out[w][s] = outDirect[w][s];
+        outDownSample.release(w);
+      }
+    }
+  }
+
+  // Waveform shapers, specialized by shape mode (and alias suppression for square and saw).
+  // raw is the unwrapped waveform phasor, shapeRaw is the unclamped shape value.
+  template <int MODE>
+  static float_4 sinShape(float_4 raw, float_4 shapeRaw) {
+    float_4 shape = clamp(shapeRaw, -1.f, 1.f), out{};
+    float_4 sinPhasor = simd::fmod(raw, 1000.f);
+    sinPhasor = simd::ifelse(sinPhasor<0.f, sinPhasor+1000.f, sinPhasor);
+    if (MODE < 6)
+      sinPhasor = sinSimd_1000(sinPhasor + simd::ifelse(sinPhasor>250.f, -250.f, 750.f));
+    if (MODE == 0) { // exp/log
+      out = crossfade(sinPhasor, ifelse(shape>0.f, 11.f*sinPhasor/(10.f*simd::abs(sinPhasor)+1.f), simd::sgn(sinPhasor)*simd::pow(sinPhasor,4)), ifelse(shape>0.f, shape, -shape))*5.f;
+    } else if (MODE == 1) { // J curve
+      out = (normSigmoid((sinPhasor+1.f)/2.f, -shape*0.9f)*2.f-1.f) * 5.f;
+    } else if (MODE == 2) { // S curve
+      out = normSigmoid(sinPhasor, -shape*0.9f) * 5.f;
+    } else if (MODE < 5) { // Rectify or Normalized Rectify
+      shape = -shape;
+      float_4 shapeSign = simd::sgn(shape);
+      out = simd::ifelse(shapeSign==0, sinPhasor, -(shapeSign*simd::abs(-sinPhasor+shapeSign-shape)-shapeSign+shape));
+      if (MODE == 4) // Normalized Rectify
+        out = -((1+simd::abs(shape))*-out-shape);
+      out *= 5.f;
+    } else if (MODE == 5) { // morph square <--> sine <--> saw
+      out = sinPhasor * 5.f * (1.f - simd::abs(shape)); // sine component
+      // square and saw components
+      sinPhasor = simd::fmod(raw + simd::ifelse(raw<0.f, 0.f, 500.f), 1000.f);
+      sinPhasor = simd::ifelse(sinPhasor<0.f, sinPhasor+1000.f, sinPhasor);
+      out += simd::ifelse( shape<=0.f,
+                           simd::ifelse(sinPhasor<500.f, 5.f, -5.f) * shape, // square component
+                           (sinPhasor*0.01f - 5.f) * shape // saw component
+                         );
+    } else { // PWM or Skew
+      float_4 flip = (shape + 1.f) * 500.f;
+      flip = clamp( flip, 30.f, 970.f );
+      if (MODE == 7) // Skew
+        sinPhasor += simd::ifelse(sinPhasor>250.f, -250.f, 750.f);
+      sinPhasor = 1000.f*simd::ifelse(sinPhasor<flip, sinPhasor/flip/2.f, (sinPhasor-flip)/(1000.f-flip)/2.f+0.5f);
+      if (MODE == 6) // Pulse width
+        sinPhasor += simd::ifelse(sinPhasor>250.f, -250.f, 750.f);
+      out = sinSimd_1000(sinPhasor) * 5.f;
+    }
+    return out;
+  }
+
+  template <int MODE>
+  static float_4 triShape(float_4 raw, float_4 shapeRaw) {
+    float_4 shape = clamp(shapeRaw, -1.f, 1.f), out{};
+    float_4 triPhasor = simd::fmod(raw, 1000.f);
+    triPhasor = simd::ifelse(triPhasor<0.f, triPhasor+1000.f, triPhasor);
+    if (MODE < 6)
+      triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
+    if (MODE < 3)
+      shape = simd::ifelse(triPhasor<500.f, shape, -shape);
+    if (MODE < 6)
+      triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
+    if (MODE == 0) { // exp/log
+      out = crossfade(triPhasor, ifelse(shape>0.f, 11.f*triPhasor/(10.f*simd::abs(triPhasor)+1.f), simd::sgn(triPhasor)*simd::pow(triPhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
+    } else if (MODE == 1) { // J curve
+      out = normSigmoid(triPhasor, -shape*0.8) * 10.f - 5.f;
+    } else if (MODE == 2) { // S curve
+      out = normSigmoid(triPhasor*2.f-1.f, -shape*0.8) * 5.f;
+    } else if (MODE < 5) { // Rectify or Normalized Rectify
+      shape = -shape;
+      float_4 shapeSign = simd::sgn(shape);
+      out = triPhasor*2.f-1.f;
+      out = simd::ifelse(shapeSign==0, out, -(shapeSign*simd::abs(-out+shapeSign-shape)-shapeSign+shape));
+      if (MODE == 4) // Normalized Rectify
+        out = -((1+simd::abs(shape))*-out-shape);
+      out *= 5.f;
+    } else if (MODE == 5) { // morph sine <--> triangle <--> square
+      out = (triPhasor*10.f - 5.f) * (1.f - simd::abs(shape)); // triangle component
+      // sine and square components
+      triPhasor = simd::fmod(raw - simd::ifelse(shape<=0.f, 250.f, 0.f), 1000.f);
+      triPhasor = simd::ifelse(triPhasor<0.f, triPhasor+1000.f, triPhasor);
+      out += simd::ifelse( shape<=0.f,
+                           sinSimd_1000(triPhasor)*5.f * -shape, // sine component
+                           simd::ifelse(triPhasor<500.f, 5.f, -5.f) * shape // square component
+                         );
+    } else { // PWM or skew
+      float_4 flip = (shape + 1.f) * 500.f;
+      flip = clamp( flip, 30.f, 970.f );
+      if (MODE == 7) // skew
+        triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
+      triPhasor = 1000.f*simd::ifelse(triPhasor<flip, triPhasor/flip/2.f, (triPhasor-flip)/(1000.f-flip)/2.f+0.5f);
+      if (MODE == 6) // PWM
+        triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
+      triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
+      out = triPhasor * 10.f - 5.f;
+    }
+    return out;
+  }
+
+  template <int MODE, bool DPW>
+  float_4 sqrShape(float_4 raw, float_4 shapeRaw, int o, int s) {
+    float_4 out{};
+    float_4 sqrPhasor = simd::fmod(raw, 1000.f);
+    sqrPhasor = simd::ifelse(sqrPhasor<0.f, sqrPhasor+1000.f, sqrPhasor);
+    if (MODE == 2) { // morph tri <--> sqr <--> saw
+      float_4 shape = clamp(shapeRaw, -1.f, 1.f);
+      out = simd::ifelse(sqrPhasor<500.f, 5.f, -5.f) * (1.f - simd::abs(shape)); // square component
+      // triangle and saw components
+      sqrPhasor = simd::fmod(raw + simd::ifelse(shape<=0.f, 250.f, 500.f), 1000.f);
+      sqrPhasor = simd::ifelse(sqrPhasor<0.f, sqrPhasor+1000.f, sqrPhasor);
+      out += simd::ifelse( shape<=0.f,
+                           (simd::ifelse(sqrPhasor<500.f, sqrPhasor, (1000.f-sqrPhasor))*.02f - 5.f) * -shape, // triangle component
+                           (sqrPhasor*0.01f - 5.f) * shape // saw component
+                         );
+    } else { // PWM
+      float_4 flip = (shapeRaw + 1.f) * 500.f;
+      if (MODE == 0) flip = clamp( flip, 30.f, 970.f );
+      out = simd::ifelse(sqrPhasor<flip, 5.f, -5.f);
+      if (DPW) {
+        float_4 phases[3];
+        loadPhases(phases, sqrPhasor * 0.001f, blk->basePhaseDelta[o][s]);
+        float_4 sawPhasor = aliasSuppressedSaw(phases, blk->denInv[o][s]);
+        float_4 offsetSawPhasor = aliasSuppressedOffsetSaw(phases, 1.f - flip*0.001f, blk->denInv[o][s]);
+        out = ifelse(blk->lowFreq[o][s], out, (offsetSawPhasor - sawPhasor + flip*0.001f - 0.5f) * 10.f);
+      }
+    }
+    return out;
+  }
+
+  template <int MODE, bool DPW>
+  float_4 sawShape(float_4 raw, float_4 shapeRaw, int o, int s) {
+    float_4 sawPhasor = simd::fmod(raw, 1000.f);
+    sawPhasor = simd::ifelse(sawPhasor<0.f, sawPhasor+1000.f, sawPhasor);
+    sawPhasor *= 0.001f;
+    if (DPW && MODE < 3) {
+      float_4 phases[3];
+      loadPhases(phases, sawPhasor, blk->basePhaseDelta[o][s]);
+      sawPhasor = ifelse(blk->lowFreq[o][s], sawPhasor, aliasSuppressedSaw(phases, blk->denInv[o][s]));
+    }
+    return sawCurve<MODE>(raw, sawPhasor, shapeRaw);
+  }
+
+  template <int MODE>
+  static float_4 naiveSawShape(float_4 raw, float_4 shapeRaw) {
+    float_4 sawPhasor = simd::fmod(raw, 1000.f);
+    sawPhasor = simd::ifelse(sawPhasor<0.f, sawPhasor+1000.f, sawPhasor);
+    return sawCurve<MODE>(raw, sawPhasor * 0.001f, shapeRaw);
+  }
+
+  // Saw shaper given the normalized (and possibly alias suppressed) saw phasor
+  template <int MODE>
+  static float_4 sawCurve(float_4 raw, float_4 sawPhasor, float_4 shapeRaw) {
+    float_4 shape = clamp(shapeRaw, -1.f, 1.f), out{};
+    if (MODE == 0) { // exp/log
+      out = crossfade(sawPhasor, ifelse(shape>0.f, 11.f*sawPhasor/(10.f*simd::abs(sawPhasor)+1.f), simd::sgn(sawPhasor)*simd::pow(sawPhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
+    } else if (MODE == 1) { // J Curve
+      out = normSigmoid(sawPhasor, -shape*0.90) * 10.f - 5.f;
+    } else if (MODE == 2) { // S Curve
+      out = normSigmoid(sawPhasor*2.f-1.f, -shape*0.85) * 5.f;
+    } else if (MODE < 5) { // Rectify or Normalized Rectify
+      shape = -shape;
+      float_4 shapeSign = simd::sgn(shape);
+      out = sawPhasor*2.f-1.f;
+      out = simd::ifelse(shapeSign==0, out, -(shapeSign*simd::abs(-out+shapeSign-shape)-shapeSign+shape));
+      if (MODE == 4) // Normalized Rectify
+        out = -((1+simd::abs(shape))*-out-shape);
+      out *= 5.f;
+    } else if (MODE == 5) { // morph square <--> saw <--> even
+      out = (sawPhasor*10.f - 5.f) * simd::ifelse(shape<0.f, 1.f + shape, 1.f); // saw component
+      // square component
+      sawPhasor = simd::fmod(raw + simd::ifelse(shape<=0.f, 500.f, 0.f), 1000.f);
+      sawPhasor = simd::ifelse(sawPhasor<0.f, sawPhasor+1000.f, sawPhasor);
+      out += simd::ifelse(sawPhasor<500.f, 5.f, -5.f) * simd::abs(shape) * simd::ifelse(shape<0.f, 1.f, 0.5f);
+      // sine component
+      sawPhasor = simd::fmod(raw, 1000.f);
+      sawPhasor = simd::ifelse(sawPhasor<0.f, sawPhasor+1000.f, sawPhasor);
+      out += simd::ifelse(shape<0.f, 0.f, sinSimd_1000(sawPhasor) * 3.175 * shape);
+    } else { // PWM
+      float_4 flip = (-shape + 1.f) * .5f;
+      if (MODE == 6)
+        flip = clamp( flip, .03f, .97f );
+      sawPhasor = simd::ifelse(sawPhasor<flip, sawPhasor/flip/2.f, (sawPhasor-flip)/(1.f-flip)/2.f+0.5f);
+      out = sawPhasor * 10.f - 5.f;
+    }
+    return out;
+  }
+
+  // Band limited wavetable lookup in place of the shape math.
+  // The mipmap level of each channel keeps its harmonics below the Nyquist frequency of the output sample rate,
+  // so the downsample filter has nothing left to remove.
+  template <int W>
+  float_4 tableShape(float_4 raw, float_4 shapeRaw, int o, int s) {
+    float_4 phase = simd::fmod(raw, 1000.f), delta = blk->phaseDelta[o][s] * (0.001f * oversample), out;
+    phase = simd::ifelse(phase<0.f, phase+1000.f, phase) * 0.001f;
+    for (int i=0; i<4; i++)
+      out[i] = shapeTable[W]->lookup(phase[i], shapeRaw[i], delta[i]);
+    return out;
+  }
+
+  typedef float_4 (*Shaper)(float_4 raw, float_4 shapeRaw);
+
+  // Renders one naive cycle of a sine, triangle or saw shape mode for the shared wavetables (table = waveform*8 + mode)
+  static void renderShape(int table, float shape, float* cycle, int len) {
+    static const Shaper shapers[4][8] = {
+      {&sinShape<0>, &sinShape<1>, &sinShape<2>, &sinShape<3>, &sinShape<4>, &sinShape<5>, &sinShape<6>, &sinShape<7>},
+      {&triShape<0>, &triShape<1>, &triShape<2>, &triShape<3>, &triShape<4>, &triShape<5>, &triShape<6>, &triShape<7>},
+      {},
+      {&naiveSawShape<0>, &naiveSawShape<1>, &naiveSawShape<2>, &naiveSawShape<3>,
+       &naiveSawShape<4>, &naiveSawShape<5>, &naiveSawShape<6>, &naiveSawShape<7>}
+    };
+    Shaper shaper = shapers[table/8][table%8];
+    for (int i=0; i<len; i+=4)
+      shaper(float_4(i, i+1, i+2, i+3) * (1000.f / len), shape).store(cycle + i);
+  }
+
+  static WavetableBank& shapeTables() {
+    static WavetableBank bank(32, renderShape);
+    return bank;
+  }
+
+  void setWavetable(bool val) {
+    if (val)
+      shapeTables();
+    wavetable = val;
+    setMode(true);
+  }
+
+  template <int W, int MODE, bool DPW>
+  float_4 waveShape(float_4 raw, float_4 shapeRaw, int o, int s) {
+    if (W == SIN)
+      return sinShape<MODE>(raw, shapeRaw);
+    else if (W == TRI)
+      return triShape<MODE>(raw, shapeRaw);
+    else if (W == SQR)
+      return sqrShape<MODE, DPW>(raw, shapeRaw, o, s);
+    else
+      return sawShape<MODE, DPW>(raw, shapeRaw, o, s);
+  }
+
+  // Apply PolyBLEP / PolyBLAMP corrections to a naive waveform value, delaying the output by one sample.
+  // A wavetable is already band limited, so only its sync resets and reversals are corrected, with the steps
+  // and slopes read from the table itself.
+  template <int W, int MODE, int AA>
+  float_4 blepCorrect(float_4 out, float_4 raw, float_4 shapeRaw, int o, int s) {
+    PolyBLEP<float_4>& bl = blep[s][W];
+    auto f = [&](float_4 p) {
+      return AA == AA_TABLE ? this->tableShape<W>(p, shapeRaw, o, s) : this->waveShape<W, MODE, false>(p, shapeRaw, o, s);
+    };
+    float_4 sync = blk->sync[o][s] != 0.f;
+    float_4 delta = PolyBLEP<float_4>::wrapPhase(raw - blepRaw[s][W] + 500.f) - 500.f;
+    delta = simd::ifelse(sync, blk->phaseDelta[o][s], delta);
+    blepRaw[s][W] = raw;
+    float_4 pos[4];
+    int cnt = AA == AA_TABLE ? 0 : polyBLEPEdges(W, MODE, W==SAW ? clamp(shapeRaw, -1.f, 1.f) : shapeRaw, pos);
+    bl.addEvents(f, pos, cnt, raw, delta, sync, blk->syncD[o][s], blk->syncJump[o][s], blk->rev[o][s] != 0.f, blk->revD[o][s]);
+    return bl.process(out);
+  }
+
+  // Complete processing of one waveform output for the current block.
+  // Parameters are read once per block, and the shape mode and anti-alias method are resolved at compile time.
+  template <int W, int MODE, int AA>
+  void waveKernel(int simdCnt) {
+    float shapeAmt = params[SIN_SHAPE_AMT_PARAM+W].getValue(), shapeParm = params[SIN_SHAPE_PARAM+W].getValue(),
+          phaseAmt = params[SIN_PHASE_AMT_PARAM+W].getValue(), phaseParm = params[SIN_PHASE_PARAM+W].getValue()*2.f,
+          levelAmt = params[SIN_LEVEL_AMT_PARAM+W].getValue(), levelParm = params[SIN_LEVEL_PARAM+W].getValue(),
+          offsetAmt = params[SIN_OFFSET_AMT_PARAM+W].getValue(), offsetParm = params[SIN_OFFSET_PARAM+W].getValue()*5.f;
+    bool toMix = params[SIN_ASIGN_PARAM+W].getValue()!=1, toOut = params[SIN_ASIGN_PARAM+W].getValue()!=0;
+    float_4 shapeIn{}, phaseIn{}, levelIn{}, offsetIn{};
+    for (int o=0; o<oversample; o++){
+      for (int s=0, c=0; s<simdCnt; s++, c+=4){
+        upsampleInput(shapeIn, SIN_SHAPE_INPUT+W, o, s, c);
+        upsampleInput(phaseIn, SIN_PHASE_INPUT+W, o, s, c);
+        float_4 shapeRaw = shapeIn*shapeAmt*shpScale[W] + shapeParm;
+        float_4 raw = blk->globalPhasor[o][s] + (phaseIn*phaseAmt + phaseParm)*250.f;
+        float_4 out = AA == AA_TABLE ? tableShape<W>(raw, shapeRaw, o, s) : waveShape<W, MODE, AA == AA_DPW>(raw, shapeRaw, o, s);
+        // With PolyBLEP, a table also matches the one sample delay of the PolyBLEP square
+        if (AA == AA_BLEP || (AA == AA_TABLE && blepActive))
+          out = blepCorrect<W, MODE, AA>(out, raw, shapeRaw, o, s);
+
+        upsampleInput(levelIn, SIN_LEVEL_INPUT+W, o, s, c);
+        float_4 level = bipolar[W] ? levelIn : simd::ifelse(levelIn>0.f, levelIn, 0.f);
+        level = level * levelAmt * lvlScale[W] + levelParm;
+        if (clampLevel)
+          level = simd::clamp(level, -1.f, 1.f);
+        if (toMix) {
+          blk->mixOut[o][s] += out * level;
+          blk->mixDiv[o][s] += simd::fabs(level);
+        }
+
+        upsampleInput(offsetIn, SIN_OFFSET_INPUT+W, o, s, c);
+        out += clamp(offsetIn*offsetAmt + offsetParm, -5.f, 5.f);
+        if (toOut)
+          out *= level;
+        finishOutput(W, o, s, out);
+      }
+    }
+    finishBlock(W, simdCnt);
+  }
+
+  template <int MODE>
+  void mixKernel(int simdCnt) {
+    const int mixType = MODE % 3, folds = MODE > 2 ? 3 : 10;
+    float shapeAmt = params[MIX_SHAPE_AMT_PARAM].getValue(), shapeParm = params[MIX_SHAPE_PARAM].getValue(),
+          levelAmt = params[MIX_LEVEL_AMT_PARAM].getValue(), levelParm = params[MIX_LEVEL_PARAM].getValue(),
+          offsetAmt = params[MIX_OFFSET_AMT_PARAM].getValue(), offsetParm = params[MIX_OFFSET_PARAM].getValue()*5.f;
+    float_4 shapeIn{}, levelIn{}, offsetIn{};
+    for (int o=0; o<oversample; o++){
+      for (int s=0, c=0; s<simdCnt; s++, c+=4){
+        float_4 out = blk->mixOut[o][s];
+        if (MODE > 2)
+          out = simd::ifelse(blk->mixDiv[o][s]>0.f, out/blk->mixDiv[o][s], out);
+        if (mixType) {
+          upsampleInput(shapeIn, MIX_SHAPE_INPUT, o, s, c);
+          float_4 drive = clamp(shapeIn*shapeAmt + shapeParm+1.f, 0.f, 3.f)*2.f + 1.f;
+          if (mixType==1){
+            out = softClip<float_4>(out*2.f*drive)/2.f;
+          }
+          if (mixType==2){
+            out *= drive;
+            float_4 clmp;
+            for (int i=0; i<folds; i++){
+              clmp = clamp(out,-5,5);
+              out = clmp + clmp - out;
+            }
+          }
+        }
+        upsampleInput(offsetIn, MIX_OFFSET_INPUT, o, s, c);
+        out += clamp(offsetIn*offsetAmt + offsetParm, -5.f, 5.f);
+        upsampleInput(levelIn, MIX_LEVEL_INPUT, o, s, c);
+        float_4 level = bipolar[MIX] ? levelIn : simd::ifelse(levelIn>0.f, levelIn, 0.f);
+        level = level * levelAmt * lvlScale[MIX] + levelParm;
+        if (clampLevel)
+          level = simd::clamp(level, -1.f, 1.f);
+        finishOutput(MIX, o, s, out * level);
+      }
+    }
+    finishBlock(MIX, simdCnt);
+  }
+
+  typedef void (Oscillator::*Kernel)(int simdCnt);
+
+  // Select the waveform kernels once per block. DPW alias suppression only affects square PWM and the first 3 saw modes,
+  // so sine and triangle use the plain kernels in place of DPW.
+  void runKernels(int simdCnt, int sinMode, int triMode, int sqrMode, int sawMode, int mixMode,
+                  bool procSin, bool procTri, bool procSqr, bool procSaw, bool procMix) {
+    static const Kernel sinKernels[3][8] = {
+      {&Oscillator::waveKernel<SIN,0,AA_NONE>, &Oscillator::waveKernel<SIN,1,AA_NONE>, &Oscillator::waveKernel<SIN,2,AA_NONE>, &Oscillator::waveKernel<SIN,3,AA_NONE>,
+       &Oscillator::waveKernel<SIN,4,AA_NONE>, &Oscillator::waveKernel<SIN,5,AA_NONE>, &Oscillator::waveKernel<SIN,6,AA_NONE>, &Oscillator::waveKernel<SIN,7,AA_NONE>},
+      {&Oscillator::waveKernel<SIN,0,AA_NONE>, &Oscillator::waveKernel<SIN,1,AA_NONE>, &Oscillator::waveKernel<SIN,2,AA_NONE>, &Oscillator::waveKernel<SIN,3,AA_NONE>,
+       &Oscillator::waveKernel<SIN,4,AA_NONE>, &Oscillator::waveKernel<SIN,5,AA_NONE>, &Oscillator::waveKernel<SIN,6,AA_NONE>, &Oscillator::waveKernel<SIN,7,AA_NONE>},
+      {&Oscillator::waveKernel<SIN,0,AA_BLEP>, &Oscillator::waveKernel<SIN,1,AA_BLEP>, &Oscillator::waveKernel<SIN,2,AA_BLEP>, &Oscillator::waveKernel<SIN,3,AA_BLEP>,
+       &Oscillator::waveKernel<SIN,4,AA_BLEP>, &Oscillator::waveKernel<SIN,5,AA_BLEP>, &Oscillator::waveKernel<SIN,6,AA_BLEP>, &Oscillator::waveKernel<SIN,7,AA_BLEP>}
+    };
+    static const Kernel triKernels[3][8] = {
+      {&Oscillator::waveKernel<TRI,0,AA_NONE>, &Oscillator::waveKernel<TRI,1,AA_NONE>, &Oscillator::waveKernel<TRI,2,AA_NONE>, &Oscillator::waveKernel<TRI,3,AA_NONE>,
+       &Oscillator::waveKernel<TRI,4,AA_NONE>, &Oscillator::waveKernel<TRI,5,AA_NONE>, &Oscillator::waveKernel<TRI,6,AA_NONE>, &Oscillator::waveKernel<TRI,7,AA_NONE>},
+      {&Oscillator::waveKernel<TRI,0,AA_NONE>, &Oscillator::waveKernel<TRI,1,AA_NONE>, &Oscillator::waveKernel<TRI,2,AA_NONE>, &Oscillator::waveKernel<TRI,3,AA_NONE>,
+       &Oscillator::waveKernel<TRI,4,AA_NONE>, &Oscillator::waveKernel<TRI,5,AA_NONE>, &Oscillator::waveKernel<TRI,6,AA_NONE>, &Oscillator::waveKernel<TRI,7,AA_NONE>},
+      {&Oscillator::waveKernel<TRI,0,AA_BLEP>, &Oscillator::waveKernel<TRI,1,AA_BLEP>, &Oscillator::waveKernel<TRI,2,AA_BLEP>, &Oscillator::waveKernel<TRI,3,AA_BLEP>,
+       &Oscillator::waveKernel<TRI,4,AA_BLEP>, &Oscillator::waveKernel<TRI,5,AA_BLEP>, &Oscillator::waveKernel<TRI,6,AA_BLEP>, &Oscillator::waveKernel<TRI,7,AA_BLEP>}
+    };
+    static const Kernel sqrKernels[3][3] = {
+      {&Oscillator::waveKernel<SQR,0,AA_NONE>, &Oscillator::waveKernel<SQR,1,AA_NONE>, &Oscillator::waveKernel<SQR,2,AA_NONE>},
+      {&Oscillator::waveKernel<SQR,0,AA_DPW>, &Oscillator::waveKernel<SQR,1,AA_DPW>, &Oscillator::waveKernel<SQR,2,AA_NONE>},
+      {&Oscillator::waveKernel<SQR,0,AA_BLEP>, &Oscillator::waveKernel<SQR,1,AA_BLEP>, &Oscillator::waveKernel<SQR,2,AA_BLEP>}
+    };
+    static const Kernel sawKernels[3][8] = {
+      {&Oscillator::waveKernel<SAW,0,AA_NONE>, &Oscillator::waveKernel<SAW,1,AA_NONE>, &Oscillator::waveKernel<SAW,2,AA_NONE>, &Oscillator::waveKernel<SAW,3,AA_NONE>,
+       &Oscillator::waveKernel<SAW,4,AA_NONE>, &Oscillator::waveKernel<SAW,5,AA_NONE>, &Oscillator::waveKernel<SAW,6,AA_NONE>, &Oscillator::waveKernel<SAW,7,AA_NONE>},
+      {&Oscillator::waveKernel<SAW,0,AA_DPW>, &Oscillator::waveKernel<SAW,1,AA_DPW>, &Oscillator::waveKernel<SAW,2,AA_DPW>, &Oscillator::waveKernel<SAW,3,AA_NONE>,
+       &Oscillator::waveKernel<SAW,4,AA_NONE>, &Oscillator::waveKernel<SAW,5,AA_NONE>, &Oscillator::waveKernel<SAW,6,AA_NONE>, &Oscillator::waveKernel<SAW,7,AA_NONE>},
+      {&Oscillator::waveKernel<SAW,0,AA_BLEP>, &Oscillator::waveKernel<SAW,1,AA_BLEP>, &Oscillator::waveKernel<SAW,2,AA_BLEP>, &Oscillator::waveKernel<SAW,3,AA_BLEP>,
+       &Oscillator::waveKernel<SAW,4,AA_BLEP>, &Oscillator::waveKernel<SAW,5,AA_BLEP>, &Oscillator::waveKernel<SAW,6,AA_BLEP>, &Oscillator::waveKernel<SAW,7,AA_BLEP>}
+    };
+    static const Kernel mixKernels[6] = {
+      &Oscillator::mixKernel<0>, &Oscillator::mixKernel<1>, &Oscillator::mixKernel<2>,
+      &Oscillator::mixKernel<3>, &Oscillator::mixKernel<4>, &Oscillator::mixKernel<5>
+    };
+    // Sine, triangle and saw read the shared wavetables instead once they are built
+    shapeTable[SIN] = tableActive && procSin ? shapeTables().get(SIN*8 + sinMode) : NULL;
+    shapeTable[TRI] = tableActive && procTri ? shapeTables().get(TRI*8 + triMode) : NULL;
+    shapeTable[SAW] = tableActive && procSaw ? shapeTables().get(SAW*8 + sawMode) : NULL;
+    // The mix accumulates in sin, tri, sqr, saw order
+    if (procSin)
+      (this->*(shapeTable[SIN] ? &Oscillator::waveKernel<SIN,0,AA_TABLE> : sinKernels[antiAlias][sinMode]))(simdCnt);
+    if (procTri)
+      (this->*(shapeTable[TRI] ? &Oscillator::waveKernel<TRI,0,AA_TABLE> : triKernels[antiAlias][triMode]))(simdCnt);
+    if (procSqr)
+      (this->*sqrKernels[antiAlias][sqrMode])(simdCnt);
+    if (procSaw)
+      (this->*(shapeTable[SAW] ? &Oscillator::waveKernel<SAW,0,AA_TABLE> : sawKernels[antiAlias][sawMode]))(simdCnt);
+    if (procMix)
+      (this->*mixKernels[mixMode])(simdCnt);
+  }
+
   void process(const ProcessArgs& args) override {
     VenomModule::process(args);
+    blk = &scratchBlock();
 
     if (currentMode != static_cast<int>(params[MODE_PARAM].getValue())) {
       setMode();
     }
 
-    if (oversample != oversampleValues[params[OVER_PARAM].getValue()]) {
-      oversample = oversampleValues[params[OVER_PARAM].getValue()];
+    if (oversample != governedOversample(oversampleValues[params[OVER_PARAM].getValue()])) {
+      oversample = governedOversample(oversampleValues[params[OVER_PARAM].getValue()]);
       setOversample();
       sampleRate = 0;
     }
     if (sampleRate != args.sampleRate) {
       sampleRate = args.sampleRate;
-      for (int i=0; i<4; i++){
-        for (int j=0; j<6; j++)
-          dcBlockFilter[i][j].init(oversample, sampleRate);
-      }
+      for (int i=0; i<4; i++)
+        linDcBlockFilter[i].init(oversample, sampleRate);
+      for (int j=0; j<5; j++)
+        outDcBlockFilter[j].init(oversample, sampleRate);
     }
     // get channel count
     int channels = 1;
@@ -508,14 +1024,12 @@ struct Oscillator : VenomModule {
     }
     int simdCnt = (channels+3)/4;
     
-    float_4 expIn{}, linIn{}, expDepthIn[4]{}, linDepthIn[4]{}, vOctIn[4]{}, revIn{}, syncIn{}, freq[4]{},
-            shapeIn[5]{}, phaseIn[5]{}, offsetIn[5]{}, levelIn[5]{},
-            sinOut[4]{}, triOut[4]{}, sqrOut[4]{}, sawOut[4]{}, mixOut[4]{},
-            sinPhasor{}, triPhasor{}, sqrPhasor{}, sawPhasor{}, offsetSawPhasor{}, globalPhasor{},
-            shapeSign{}, phases[3]{}, flip{};
+    float_4 expIn{}, linIn{}, expDepthIn[4]{}, linDepthIn[4]{}, vOctIn[4]{}, revIn{}, syncIn{}, freq[4]{}, mixPhaseIn{};
     float vOctParm = mode<2 ? params[FREQ_PARAM].getValue() + params[OCTAVE_PARAM].getValue() : params[FREQ_PARAM].getValue();
     float k =  1000.f * args.sampleTime / oversample;
-    float_4 basePhaseDelta{}, lowFreq{}, denInv{};
+    float expAmt = params[EXP_PARAM].getValue(), linAmt = params[LIN_PARAM].getValue(),
+          linRange = (params[OCTAVE_PARAM].getValue()+4.f)*3.f+1.f,
+          mixPhaseAmt = params[MIX_PHASE_AMT_PARAM].getValue(), mixPhaseParm = params[MIX_PHASE_PARAM].getValue()*2.f;
     
     if (alternate != (mode==2)) {
       alternate = !alternate;
@@ -546,21 +1060,27 @@ struct Oscillator : VenomModule {
     int sqrMode = static_cast<int>(params[PW_PARAM].getValue());
     int sawMode = static_cast<int>(params[SAWSHP_PARAM].getValue());
     int mixMode = static_cast<int>(params[MIXSHP_PARAM].getValue());
-    int mixType = mixMode % 3;
     
     bool procSin = outputs[SIN_OUTPUT].isConnected() || (outputs[MIX_OUTPUT].isConnected() && params[SIN_ASIGN_PARAM].getValue() != 1.f);
     bool procTri = outputs[TRI_OUTPUT].isConnected() || (outputs[MIX_OUTPUT].isConnected() && params[TRI_ASIGN_PARAM].getValue() != 1.f);
     bool procSqr = outputs[SQR_OUTPUT].isConnected() || (outputs[MIX_OUTPUT].isConnected() && params[SQR_ASIGN_PARAM].getValue() != 1.f);
     bool procSaw = outputs[SAW_OUTPUT].isConnected() || (outputs[MIX_OUTPUT].isConnected() && params[SAW_ASIGN_PARAM].getValue() != 1.f);
     bool procMix = outputs[MIX_OUTPUT].isConnected();
-    bool procOver[INPUTS_LEN]{};
-    for (int i=0; i<INPUTS_LEN; i++)
+    for (int i=0; i<INPUTS_LEN; i++) {
       procOver[i] = oversample>1 && inputs[i].isConnected() && !disableOver[i];
-    // main loops
+      heldIn[i] = disableOver[i];
+    }
+    dcBlock = params[DC_PARAM].getValue();
+    for (int w=0; w<5; w++){
+      for (int s=0; s<4; s++)
+        blk->out[w][s] = float_4::zero();
+    }
+    bool procWave[5] = {procSin, procTri, procSqr, procSaw, procMix};
+    upsampleInputs(simdCnt, procWave, mixMode % 3);
+    prepareOutputs(procWave);
+    // main phasor loops
     for (int o=0; o<oversample; o++){
       for (int s=0, c=0; s<simdCnt; s++, c+=4){
-        float_4 level{}, mixDiv{};
-        // Main Phasor
         if (!o) {
           if (!alternate) {
             if (s==0 || inputs[EXP_DEPTH_INPUT].isPolyphonic()) {
@@ -574,82 +1094,82 @@ struct Oscillator : VenomModule {
             vOctIn[s] = inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c);
           } else vOctIn[s] = vOctIn[0];
         }
-        if (!alternate) {
-          if (s==0 || inputs[EXP_INPUT].isPolyphonic()) {
-            expIn = (o && !disableOver[EXP_INPUT]) ? float_4::zero() : inputs[EXP_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[EXP_INPUT]){
-              if (o==0) expIn *= oversample;
-              expIn = expUpSample[s].process(expIn);
-            }
-          } // else preserve prior expIn value
-        }
-        if (s==0 || inputs[LIN_INPUT].isPolyphonic()) {
-          linIn = (o && !disableOver[LIN_INPUT]) ? float_4::zero() : inputs[LIN_INPUT].getPolyVoltageSimd<float_4>(c);
-          if (procOver[LIN_INPUT]){
-            if (o==0) linIn *= oversample;
-            linIn = linUpSample[s].process(linIn);
-          }
-        } // else preserve prior linIn value
+        if (!alternate)
+          upsampleInput(expIn, EXP_INPUT, o, s, c);
+        upsampleInput(linIn, LIN_INPUT, o, s, c);
         if (inputs[LIN_INPUT].isConnected() && !linDCCouple)
-          linIn = dcBlockFilter[s][LINFM].process(linIn);
-        if (s==0 || inputs[MIX_PHASE_INPUT].isPolyphonic()) {
-          phaseIn[MIX] = (o && !disableOver[MIX_PHASE_INPUT]) ? float_4::zero() : inputs[MIX_PHASE_INPUT].getPolyVoltageSimd<float_4>(c);
-          if (procOver[MIX_PHASE_INPUT]){
-            if (o==0) phaseIn[MIX] *= oversample;
-            phaseIn[MIX] = phaseUpSample[s][MIX].process(phaseIn[MIX]);
-          }
-        } // else preserve prior phaseIn[MIX] value
-        float_4 rev{};
+          linIn = linDcBlockFilter[s].process(linIn);
+        upsampleInput(mixPhaseIn, MIX_PHASE_INPUT, o, s, c);
+        float_4 rev{}, revD{};
         if (inputs[REV_INPUT].isConnected()) {
-          if (s==0 || inputs[REV_INPUT].isPolyphonic()) {
-            revIn = (o && !disableOver[REV_INPUT]) ? float_4::zero() : inputs[REV_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[REV_INPUT]){
-              if (o==0) revIn *= oversample;
-              revIn = revUpSample[s].process(revIn);
-            }
-          } // else preserve prior value
+          upsampleInput(revIn, REV_INPUT, o, s, c);
           for (int i=0; i<4; i++){
             rev[i] = revTrig[c+i].process(revIn[i], syncLo, syncHi);
           }
-        }
-        float_4 sync{};
+          if (subSample) // fraction of the step since the input crossed the high threshold
+            revD = clamp((revIn - syncHi) / (revIn - revPrev[s]), 0.f, 1.f);
+          revPrev[s] = revIn;
+        } else revPrev[s] = float_4::zero();
+        float_4 sync{}, syncD{};
         if (inputs[SYNC_INPUT].isConnected()) {
-          if (s==0 || inputs[SYNC_INPUT].isPolyphonic()) {
-            syncIn = (o && !disableOver[SYNC_INPUT]) ? float_4::zero() : inputs[SYNC_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SYNC_INPUT]){
-              if (o==0) syncIn *= oversample;
-              syncIn = syncUpSample[s].process(syncIn);
-            }
-          } // else preserve prior syncIn value
+          upsampleInput(syncIn, SYNC_INPUT, o, s, c);
           for (int i=0; i<4; i++){
             sync[i] = syncTrig[c+i].process(syncIn[i], syncLo, syncHi) && !(noRetrigger && onceActive[s][i]);
           }
-        } else onceActive[s] = float_4::zero();
+          if (subSample)
+            syncD = clamp((syncIn - syncHi) / (syncIn - syncPrev[s]), 0.f, 1.f);
+          syncPrev[s] = syncIn;
+        } else {
+          onceActive[s] = float_4::zero();
+          syncPrev[s] = float_4::zero();
+        }
         if (!alternate) {
-          freq[s] = vOctIn[s] + vOctParm + expIn*expDepthIn[s]*params[EXP_PARAM].getValue();
-          freq[s] = dsp::exp2_taylor5(freq[s]) + linIn*linDepthIn[s]*params[LIN_PARAM].getValue();
+          freq[s] = vOctIn[s] + vOctParm + expIn*expDepthIn[s]*expAmt;
+          freq[s] = dsp::exp2_taylor5(freq[s]) + linIn*linDepthIn[s]*linAmt;
           if (linNoThru0)
             freq[s] = simd::ifelse(freq[s]<float_4::zero(), float_4::zero(), freq[s]);
         } else {
-          freq[s] = (vOctParm + vOctIn[s])*biasFreq + linIn*linDepthIn[s]*params[LIN_PARAM].getValue()*((params[OCTAVE_PARAM].getValue()+4.f)*3.f+1.f);
+          freq[s] = (vOctParm + vOctIn[s])*biasFreq + linIn*linDepthIn[s]*linAmt*linRange;
         }
         freq[s] *= modeFreq[0][mode];
         phasorDir[s] = simd::ifelse(rev>0.f, phasorDir[s]*-1.f, phasorDir[s]);
         phasorDir[s] = simd::ifelse(sync>0.f, 1.f, phasorDir[s]);
-        basePhaseDelta = freq[s] * phasorDir[s] * k;
-        phasor[s] += basePhaseDelta;
+        float_4 basePhaseDelta = freq[s] * phasorDir[s] * k;
+        float_4 phaseDelta = basePhaseDelta, prevPhasor = phasor[s];
+        phasor[s] += phaseDelta;
+        // A reverse only applies to the portion of the step after the event
+        if (subSample)
+          phasor[s] += simd::ifelse(rev>0.f, phaseDelta * (revD - 1.f) * 2.f, 0.f);
+        if (blepActive || tableActive)
+          blk->phaseDelta[o][s] = phaseDelta;
+        if (blepActive) {
+          blk->rev[o][s] = rev;
+          blk->revD[o][s] = revD;
+        }
         if (aliasSuppress) {
           basePhaseDelta *= 0.001f;
-          lowFreq = simd::abs(basePhaseDelta) < 1e-3;
-          denInv = 1.f/basePhaseDelta;
-          denInv = denInv * denInv * 0.25;
+          blk->basePhaseDelta[o][s] = basePhaseDelta;
+          blk->lowFreq[o][s] = simd::abs(basePhaseDelta) < 1e-3;
+          float_4 denInv = 1.f/basePhaseDelta;
+          blk->denInv[o][s] = denInv * denInv * 0.25;
         }
         float_4 tempPhasor = simd::fmod(phasor[s], 1000.f);
         tempPhasor = simd::ifelse(tempPhasor<0.f, tempPhasor+1000.f, tempPhasor);
         if (once)
           onceActive[s] = simd::ifelse(tempPhasor != phasor[s], float_4::zero(), onceActive[s]);
         phasor[s] = tempPhasor;
-        phasor[s] = simd::ifelse(sync>0.f, float_4::zero(), phasor[s]);
+        if (subSample) {
+          // Sub-sample sync: the reset phasor has already advanced for the portion of the step after the event
+          float_4 resetPhasor = syncD * phaseDelta;
+          if (blepActive) {
+            blk->sync[o][s] = sync;
+            blk->syncD[o][s] = syncD;
+            blk->syncJump[o][s] = prevPhasor + phaseDelta * (1.f - syncD) - resetPhasor;
+          }
+          phasor[s] = simd::ifelse(sync>0.f, resetPhasor, phasor[s]);
+        }
+        else
+          phasor[s] = simd::ifelse(sync>0.f, float_4::zero(), phasor[s]);
         if (once)
           onceActive[s] = simd::ifelse(sync>float_4::zero(), 1.f, onceActive[s]);
         if (gated){
@@ -658,472 +1178,24 @@ struct Oscillator : VenomModule {
               onceActive[s][i] = 0.f;
           }
         }
+        blk->active[o][s] = onceActive[s];
 
         // Global (Mix) Phase
-        globalPhasor = phasor[s] + (phaseIn[MIX]*params[MIX_PHASE_AMT_PARAM].getValue() + params[MIX_PHASE_PARAM].getValue()*2.f)*250.f;
-
-        mixOut[s] = float_4::zero();
-
-        // Sine
-        if (procSin)
-        {
-          if (s==0 || inputs[SIN_SHAPE_INPUT].isPolyphonic()) {
-            shapeIn[SIN] = (o && !disableOver[SIN_SHAPE_INPUT]) ? float_4::zero() : inputs[SIN_SHAPE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SIN_SHAPE_INPUT]){
-              if (o==0) shapeIn[SIN] *= oversample;
-              shapeIn[SIN] = shapeUpSample[s][SIN].process(shapeIn[SIN]);
-            }
-          } // preserve prior shapeIn[SIN] value
-          float_4 shape = clamp(shapeIn[SIN]*params[SIN_SHAPE_AMT_PARAM].getValue()*shpScale[SIN] + params[SIN_SHAPE_PARAM].getValue(), -1.f, 1.f);
-          if (s==0 || inputs[SIN_PHASE_INPUT].isPolyphonic()) {
-            phaseIn[SIN] = (o && !disableOver[SIN_PHASE_INPUT]) ? float_4::zero() : inputs[SIN_PHASE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SIN_PHASE_INPUT]){
-              if (o==0) phaseIn[SIN] *= oversample;
-              phaseIn[SIN] = phaseUpSample[s][SIN].process(phaseIn[SIN]);
-            }
-          } // else preserve prior phaseIn[SIN] value
-          sinPhasor = globalPhasor + (phaseIn[SIN]*params[SIN_PHASE_AMT_PARAM].getValue() + params[SIN_PHASE_PARAM].getValue()*2.f)*250.f;
-          sinPhasor = simd::fmod(sinPhasor, 1000.f);
-          sinPhasor = simd::ifelse(sinPhasor<0.f, sinPhasor+1000.f, sinPhasor);
-          switch (sinMode) {
-            case 0:  // exp/log
-              sinPhasor = sinSimd_1000(sinPhasor + simd::ifelse(sinPhasor>250.f, -250.f, 750.f));
-              sinOut[s] = crossfade(sinPhasor, ifelse(shape>0.f, 11.f*sinPhasor/(10.f*simd::abs(sinPhasor)+1.f), simd::sgn(sinPhasor)*simd::pow(sinPhasor,4)), ifelse(shape>0.f, shape, -shape))*5.f;
-              break;
-            case 1:  // J curve
-              sinPhasor = sinSimd_1000(sinPhasor + simd::ifelse(sinPhasor>250.f, -250.f, 750.f));
-              sinOut[s] = (normSigmoid((sinPhasor+1.f)/2.f, -shape*0.9f)*2.f-1.f) * 5.f;
-              break;
-            case 2: // S curve
-              sinPhasor = sinSimd_1000(sinPhasor + simd::ifelse(sinPhasor>250.f, -250.f, 750.f));
-              sinOut[s] = normSigmoid(sinPhasor, -shape*0.9f) * 5.f;
-              break;
-            case 3: // Rectify
-            case 4: // Normalized Rectify
-              sinPhasor = sinSimd_1000(sinPhasor + simd::ifelse(sinPhasor>250.f, -250.f, 750.f));
-              shape = -shape;
-              shapeSign = simd::sgn(shape);
-              sinOut[s] = simd::ifelse(shapeSign==0, sinPhasor, -(shapeSign*simd::abs(-sinPhasor+shapeSign-shape)-shapeSign+shape));
-              if (sinMode==4 /*Normalized Rectify*/)
-                sinOut[s] = -((1+simd::abs(shape))*-sinOut[s]-shape);
-              sinOut[s] *= 5.f;
-              break;
-            case 5: // morph square <--> sine <--> saw
-              sinPhasor = sinSimd_1000(sinPhasor + simd::ifelse(sinPhasor>250.f, -250.f, 750.f));
-              sinOut[s] = sinPhasor * 5.f * (1.f - simd::abs(shape)); // sine component
-              // square and saw components
-              sinPhasor = globalPhasor + (phaseIn[SIN]*params[SIN_PHASE_AMT_PARAM].getValue() + params[SIN_PHASE_PARAM].getValue()*2.f)*250.f;
-              sinPhasor = simd::fmod(sinPhasor + simd::ifelse(sinPhasor<0.f, 0.f, 500.f), 1000.f);
-              sinPhasor = simd::ifelse(sinPhasor<0.f, sinPhasor+1000.f, sinPhasor);
-              sinOut[s] += simd::ifelse( shape<=0.f,
-                                         simd::ifelse(sinPhasor<500.f, 5.f, -5.f) * shape, // square component
-                                         (sinPhasor*0.01f - 5.f) * shape // saw component
-                                       );
-              break;
-            default: // PWM or Skew
-              flip = (shape + 1.f) * 500.f;
-              flip = clamp( flip, 30.f, 970.f );
-              if (sinMode==7) // Skew
-                sinPhasor += simd::ifelse(sinPhasor>250.f, -250.f, 750.f);
-              sinPhasor = 1000.f*simd::ifelse(sinPhasor<flip, sinPhasor/flip/2.f, (sinPhasor-flip)/(1000.f-flip)/2.f+0.5f);
-              if (sinMode==6) // Pulse width
-                sinPhasor += simd::ifelse(sinPhasor>250.f, -250.f, 750.f);
-              sinOut[s] = sinSimd_1000(sinPhasor) * 5.f;
-          }
-
-          if (s==0 || inputs[SIN_LEVEL_INPUT].isPolyphonic()) {
-            levelIn[SIN] = (o && !disableOver[SIN_LEVEL_INPUT]) ? float_4::zero() : inputs[SIN_LEVEL_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SIN_LEVEL_INPUT]){
-              if (o==0) levelIn[SIN] *= oversample;
-              levelIn[SIN] = levelUpSample[s][SIN].process(levelIn[SIN]);
-            }
-          } // else preserve prior levelIn[SIN] value
-          level = bipolar[SIN] ? levelIn[SIN] : simd::ifelse(levelIn[SIN]>0.f, levelIn[SIN], 0.f);
-          level = level * params[SIN_LEVEL_AMT_PARAM].getValue() * lvlScale[SIN] + params[SIN_LEVEL_PARAM].getValue();
-          if (clampLevel)
-            level = simd::clamp(level, -1.f, 1.f);
-          if (params[SIN_ASIGN_PARAM].getValue()!=1) {
-            mixOut[s] += sinOut[s] * level;
-            mixDiv += simd::fabs(level);
-          }
-
-          if (s==0 || inputs[SIN_OFFSET_INPUT].isPolyphonic()) {
-            offsetIn[SIN] = (o && !disableOver[SIN_OFFSET_INPUT]) ? float_4::zero() : inputs[SIN_OFFSET_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SIN_OFFSET_INPUT]){
-              if (o==0) offsetIn[SIN] *= oversample;
-              offsetIn[SIN] = offsetUpSample[s][SIN].process(offsetIn[SIN]);
-            }
-          } // else preserve prior offsetIn[SIN] value
-          sinOut[s] += clamp(offsetIn[SIN]*params[SIN_OFFSET_AMT_PARAM].getValue() + params[SIN_OFFSET_PARAM].getValue()*5.f, -5.f, 5.f);
-          if (params[SIN_ASIGN_PARAM].getValue()!=0)
-            sinOut[s] *= level;  
-        }
-        
-        // Triangle
-        if (procTri)
-        {
-          if (s==0 || inputs[TRI_SHAPE_INPUT].isPolyphonic()) {
-            shapeIn[TRI] = (o && !disableOver[TRI_SHAPE_INPUT]) ? float_4::zero() : inputs[TRI_SHAPE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[TRI_SHAPE_INPUT]){
-              if (o==0) shapeIn[TRI] *= oversample;
-              shapeIn[TRI] = shapeUpSample[s][TRI].process(shapeIn[TRI]);
-            }
-          } // else preserve prior shapeIn[TRI] value
-          float_4 shape = clamp(shapeIn[TRI]*params[TRI_SHAPE_AMT_PARAM].getValue()*shpScale[TRI] + params[TRI_SHAPE_PARAM].getValue(), -1.f, 1.f);
-          if (s==0 || inputs[TRI_PHASE_INPUT].isPolyphonic()) {
-            phaseIn[TRI] = (o && !disableOver[TRI_PHASE_INPUT]) ? float_4::zero() : inputs[TRI_PHASE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[TRI_PHASE_INPUT]){
-              if (o==0) phaseIn[TRI] *= oversample;
-              phaseIn[TRI] = phaseUpSample[s][TRI].process(phaseIn[TRI]);
-            }
-          } // else preserve prior phaseIn[TRI] value
-          triPhasor = globalPhasor + (phaseIn[TRI]*params[TRI_PHASE_AMT_PARAM].getValue() + params[TRI_PHASE_PARAM].getValue()*2.f)*250.f;
-          triPhasor = simd::fmod(triPhasor, 1000.f);
-          triPhasor = simd::ifelse(triPhasor<0.f, triPhasor+1000.f, triPhasor);
-          switch (triMode) {
-            case 0:  // exp/log
-              triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
-              shape = simd::ifelse(triPhasor<500.f, shape, -shape);
-              triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
-              triOut[s] = crossfade(triPhasor, ifelse(shape>0.f, 11.f*triPhasor/(10.f*simd::abs(triPhasor)+1.f), simd::sgn(triPhasor)*simd::pow(triPhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
-              break;
-            case 1:  // J curve
-              triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
-              shape = simd::ifelse(triPhasor<500.f, shape, -shape);
-              triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
-              triOut[s] = normSigmoid(triPhasor, -shape*0.8) * 10.f - 5.f;
-              break;
-            case 2: // S curve
-              triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
-              shape = simd::ifelse(triPhasor<500.f, shape, -shape);
-              triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
-              triOut[s] = normSigmoid(triPhasor*2.f-1.f, -shape*0.8) * 5.f;
-              break;
-            case 3: // Rectify
-            case 4: // Normalized Rectify
-              triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
-              triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
-              shape = -shape;
-              shapeSign = simd::sgn(shape);
-              triOut[s] = triPhasor*2.f-1.f;
-              triOut[s] = simd::ifelse(shapeSign==0, triOut[s], -(shapeSign*simd::abs(-triOut[s]+shapeSign-shape)-shapeSign+shape));
-              if (triMode==4 /*Normalized Rectify*/)
-                triOut[s] = -((1+simd::abs(shape))*-triOut[s]-shape);
-              triOut[s] *= 5.f;
-              break;
-            case 5: // morph sine <--> triangle <--> square
-              triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
-              triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
-              triOut[s] = (triPhasor*10.f - 5.f) * (1.f - simd::abs(shape)); // triangle component
-              // sine and square components
-              triPhasor = globalPhasor + (phaseIn[TRI]*params[TRI_PHASE_AMT_PARAM].getValue() + params[TRI_PHASE_PARAM].getValue()*2.f)*250.f;
-              triPhasor = simd::fmod(triPhasor - simd::ifelse(shape<=0.f, 250.f, 0.f), 1000.f);
-              triPhasor = simd::ifelse(triPhasor<0.f, triPhasor+1000.f, triPhasor);
-              triOut[s] += simd::ifelse( shape<=0.f,
-                                         sinSimd_1000(triPhasor)*5.f * -shape, // sine component
-                                         simd::ifelse(triPhasor<500.f, 5.f, -5.f) * shape // square component
-                                       );
-              break;
-            default: // PWM or skew
-              flip = (shape + 1.f) * 500.f;
-              flip = clamp( flip, 30.f, 970.f );
-              if (triMode==7) // skew
-                triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
-              triPhasor = 1000.f*simd::ifelse(triPhasor<flip, triPhasor/flip/2.f, (triPhasor-flip)/(1000.f-flip)/2.f+0.5f);
-              if (triMode==6) // PWM
-                triPhasor += simd::ifelse(triPhasor<750.f, 250.f, -750.f);
-              triPhasor = simd::ifelse(triPhasor<500.f, triPhasor*.002f, (1000.f-triPhasor)*.002f);
-              triOut[s] = triPhasor * 10.f - 5.f;
-          }  
-
-          if (s==0 || inputs[TRI_LEVEL_INPUT].isPolyphonic()) {
-            levelIn[TRI] = (o && !disableOver[TRI_LEVEL_INPUT]) ? float_4::zero() : inputs[TRI_LEVEL_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[TRI_LEVEL_INPUT]){
-              if (o==0) levelIn[TRI] *= oversample;
-              levelIn[TRI] = levelUpSample[s][TRI].process(levelIn[TRI]);
-            }
-          } // else preserve prior levelIn[TRI] value
-          level = bipolar[TRI] ? levelIn[TRI] : simd::ifelse(levelIn[TRI]>0.f, levelIn[TRI], 0.f);
-          level = level * params[TRI_LEVEL_AMT_PARAM].getValue() * lvlScale[TRI] + params[TRI_LEVEL_PARAM].getValue();
-          if (clampLevel)
-            level = simd::clamp(level, -1.f, 1.f);
-          if (params[TRI_ASIGN_PARAM].getValue()!=1){
-            mixOut[s] += triOut[s] * level;
-            mixDiv += simd::fabs(level);
-          }
-
-          if (s==0 || inputs[TRI_OFFSET_INPUT].isPolyphonic()) {
-            offsetIn[TRI] = (o && !disableOver[TRI_OFFSET_INPUT]) ? float_4::zero() : inputs[TRI_OFFSET_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[TRI_OFFSET_INPUT]){
-              if (o==0) offsetIn[TRI] *= oversample;
-              offsetIn[TRI] = offsetUpSample[s][TRI].process(offsetIn[TRI]);
-            }
-          } // else preserve prior offsetIn[TRI] value
-          triOut[s] += clamp(offsetIn[TRI]*params[TRI_OFFSET_AMT_PARAM].getValue() + params[TRI_OFFSET_PARAM].getValue()*5.f, -5.f, 5.f);
-          if (params[TRI_ASIGN_PARAM].getValue()!=0)
-            triOut[s] *= level;  
-        }
-        
-        // Square
-        if (procSqr)
-        {
-          if (s==0 || inputs[SQR_SHAPE_INPUT].isPolyphonic()) {
-            shapeIn[SQR] = (o && !disableOver[SQR_SHAPE_INPUT]) ? float_4::zero() : inputs[SQR_SHAPE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SQR_SHAPE_INPUT]){
-              if (o==0) shapeIn[SQR] *= oversample;
-              shapeIn[SQR] = shapeUpSample[s][SQR].process(shapeIn[SQR]);
-            }
-          } // else preserve prior shapeIn[SQR] value
-          if (s==0 || inputs[SQR_PHASE_INPUT].isPolyphonic()) {
-            phaseIn[SQR] = (o && !disableOver[SQR_PHASE_INPUT]) ? float_4::zero() : inputs[SQR_PHASE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SQR_PHASE_INPUT]){
-              if (o==0) phaseIn[SQR] *= oversample;
-              phaseIn[SQR] = phaseUpSample[s][SQR].process(phaseIn[SQR]);
-            }
-          } // else preserve prior phaseIn[SQR] value
-          sqrPhasor = globalPhasor + (phaseIn[SQR]*params[SQR_PHASE_AMT_PARAM].getValue() + params[SQR_PHASE_PARAM].getValue()*2.f)*250.f;
-          sqrPhasor = simd::fmod(sqrPhasor, 1000.f);
-          sqrPhasor = simd::ifelse(sqrPhasor<0.f, sqrPhasor+1000.f, sqrPhasor);
-          if (sqrMode==2) { // morph tri <--> sqr <--> saw
-            float_4 shape = clamp(shapeIn[SQR]*params[SQR_SHAPE_AMT_PARAM].getValue()*shpScale[SQR] + params[SQR_SHAPE_PARAM].getValue(), -1.f, 1.f);
-            sqrOut[s] = simd::ifelse(sqrPhasor<500.f, 5.f, -5.f) * (1.f - simd::abs(shape)); // square component
-            // triangle and saw components
-            sqrPhasor = globalPhasor + (phaseIn[SQR]*params[SQR_PHASE_AMT_PARAM].getValue() + params[SQR_PHASE_PARAM].getValue()*2.f)*250.f;
-            sqrPhasor = simd::fmod(sqrPhasor + simd::ifelse(shape<=0.f, 250.f, 500.f), 1000.f);
-            sqrPhasor = simd::ifelse(sqrPhasor<0.f, sqrPhasor+1000.f, sqrPhasor);
-            sqrOut[s] += simd::ifelse( shape<=0.f, 
-                                       (simd::ifelse(sqrPhasor<500.f, sqrPhasor, (1000.f-sqrPhasor))*.02f - 5.f) * -shape, // triangle component
-                                       (sqrPhasor*0.01f - 5.f) * shape // saw component
-                                     );
-          } else { // PWM
-            float_4 flip = (shapeIn[SQR]*params[SQR_SHAPE_AMT_PARAM].getValue()*shpScale[SQR] + params[SQR_SHAPE_PARAM].getValue() + 1.f) * 500.f;
-            if (!sqrMode) flip = clamp( flip, 30.f, 970.f );
-            sqrOut[s] = simd::ifelse(sqrPhasor<flip, 5.f, -5.f);
-            if (aliasSuppress) {
-              loadPhases(phases, sqrPhasor * 0.001f, basePhaseDelta);
-              sawPhasor = aliasSuppressedSaw(phases, denInv);
-              offsetSawPhasor = aliasSuppressedOffsetSaw(phases, 1.f - flip*0.001f, denInv);
-              sqrOut[s] = ifelse(lowFreq, sqrOut[s], (offsetSawPhasor - sawPhasor + flip*0.001f - 0.5f) * 10.f);
-            }
-          }
-          if (s==0 || inputs[SQR_LEVEL_INPUT].isPolyphonic()) {
-            levelIn[SQR] = (o && !disableOver[SQR_LEVEL_INPUT]) ? float_4::zero() : inputs[SQR_LEVEL_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SQR_LEVEL_INPUT]){
-              if (o==0) levelIn[SQR] *= oversample;
-              levelIn[SQR] = levelUpSample[s][SQR].process(levelIn[SQR]);
-            }
-          } // else preserve prior levelIn[SQR] value
-          level = bipolar[SQR] ? levelIn[SQR] : simd::ifelse(levelIn[SQR]>0.f, levelIn[SQR], 0.f);
-          level = level * params[SQR_LEVEL_AMT_PARAM].getValue() * lvlScale[SQR] + params[SQR_LEVEL_PARAM].getValue();
-          if (clampLevel)
-            level = simd::clamp(level, -1.f, 1.f);
-          if (params[SQR_ASIGN_PARAM].getValue()!=1){
-            mixOut[s] += sqrOut[s] * level;
-            mixDiv += simd::fabs(level);
-          }
-
-          if (s==0 || inputs[SQR_OFFSET_INPUT].isPolyphonic()) {
-            offsetIn[SQR] = (o && !disableOver[SQR_OFFSET_INPUT]) ? float_4::zero() : inputs[SQR_OFFSET_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SQR_OFFSET_INPUT]){
-              if (o==0) offsetIn[SQR] *= oversample;
-              offsetIn[SQR] = offsetUpSample[s][SQR].process(offsetIn[SQR]);
-            }
-          } // else preserve prior offsetIn[SQR] value
-          sqrOut[s] += clamp(offsetIn[SQR]*params[SQR_OFFSET_AMT_PARAM].getValue() + params[SQR_OFFSET_PARAM].getValue()*5.f, -5.f, 5.f);
-          if (params[SQR_ASIGN_PARAM].getValue()!=0)
-            sqrOut[s] *= level;  
-        }
-        
-        // Saw
-        if (procSaw)
-        {
-          if (s==0 || inputs[SAW_SHAPE_INPUT].isPolyphonic()) {
-            shapeIn[SAW] = (o && !disableOver[SAW_SHAPE_INPUT]) ? float_4::zero() : inputs[SAW_SHAPE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SAW_SHAPE_INPUT]){
-              if (o==0) shapeIn[SAW] *= oversample;
-              shapeIn[SAW] = shapeUpSample[s][SAW].process(shapeIn[SAW]);
-            }
-          } // else preserve prior shapeIn[SAW] value
-          float_4 shape = clamp(shapeIn[SAW]*params[SAW_SHAPE_AMT_PARAM].getValue()*shpScale[SAW] + params[SAW_SHAPE_PARAM].getValue(), -1.f, 1.f);
-          if (s==0 || inputs[SAW_PHASE_INPUT].isPolyphonic()) {
-            phaseIn[SAW] = (o && !disableOver[SAW_PHASE_INPUT]) ? float_4::zero() : inputs[SAW_PHASE_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SAW_PHASE_INPUT]){
-              if (o==0) phaseIn[SAW] *= oversample;
-              phaseIn[SAW] = phaseUpSample[s][SAW].process(phaseIn[SAW]);
-            }
-          } // else preserve prior phaseIn[SAW] value
-          sawPhasor = globalPhasor + (phaseIn[SAW]*params[SAW_PHASE_AMT_PARAM].getValue() + params[SAW_PHASE_PARAM].getValue()*2.f)*250.f;
-          sawPhasor = simd::fmod(sawPhasor, 1000.f);
-          sawPhasor = simd::ifelse(sawPhasor<0.f, sawPhasor+1000.f, sawPhasor);
-          sawPhasor *= 0.001f;
-          if (aliasSuppress && sawMode < 3) {
-            loadPhases(phases, sawPhasor, basePhaseDelta);
-            sawPhasor = ifelse(lowFreq, sawPhasor, aliasSuppressedSaw(phases, denInv));
-          }
-          switch (sawMode) {
-            case 0:  // exp/log
-              sawOut[s] = crossfade(sawPhasor, ifelse(shape>0.f, 11.f*sawPhasor/(10.f*simd::abs(sawPhasor)+1.f), simd::sgn(sawPhasor)*simd::pow(sawPhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
-              break;
-            case 1:  // J Curve
-              sawOut[s] = normSigmoid(sawPhasor, -shape*0.90) * 10.f - 5.f;
-              break;
-            case 2: // S Curve
-              sawOut[s] = normSigmoid(sawPhasor*2.f-1.f, -shape*0.85) * 5.f;
-              break;
-            case 3: // Rectify
-            case 4: // Normalized Rectify
-              shape = -shape;
-              shapeSign = simd::sgn(shape);
-              sawOut[s] = sawPhasor*2.f-1.f;
-              sawOut[s] = simd::ifelse(shapeSign==0, sawOut[s], -(shapeSign*simd::abs(-sawOut[s]+shapeSign-shape)-shapeSign+shape));
-              if (sawMode==4 /*Normalized Rectify*/)
-                sawOut[s] = -((1+simd::abs(shape))*-sawOut[s]-shape);
-              sawOut[s] *= 5.f;
-              break;
-            case 5: // morph square <--> saw <--> even
-              sawOut[s] = (sawPhasor*10.f - 5.f) * simd::ifelse(shape<0.f, 1.f + shape, 1.f); // saw component
-              // square component
-              sawPhasor = globalPhasor + (phaseIn[SAW]*params[SAW_PHASE_AMT_PARAM].getValue() + params[SAW_PHASE_PARAM].getValue()*2.f)*250.f;
-              sawPhasor = simd::fmod(sawPhasor + simd::ifelse(shape<=0.f, 500.f, 0.f), 1000.f);
-              sawPhasor = simd::ifelse(sawPhasor<0.f, sawPhasor+1000.f, sawPhasor);
-              sawOut[s] += simd::ifelse(sawPhasor<500.f, 5.f, -5.f) * simd::abs(shape) * simd::ifelse(shape<0.f, 1.f, 0.5f);
-              // sine component
-              sawPhasor = globalPhasor + (phaseIn[SAW]*params[SAW_PHASE_AMT_PARAM].getValue() + params[SAW_PHASE_PARAM].getValue()*2.f)*250.f;
-              sawPhasor = simd::fmod(sawPhasor, 1000.f);
-              sawPhasor = simd::ifelse(sawPhasor<0.f, sawPhasor+1000.f, sawPhasor);
-              sawOut[s] += simd::ifelse(shape<0.f, 0.f, sinSimd_1000(sawPhasor) * 3.175 * shape);
-              break;
-            default: // PWM
-              flip = (-shape + 1.f) * .5f;
-              if (sawMode==6)
-                flip = clamp( flip, .03f, .97f );
-              sawPhasor = simd::ifelse(sawPhasor<flip, sawPhasor/flip/2.f, (sawPhasor-flip)/(1.f-flip)/2.f+0.5f);
-              sawOut[s] = sawPhasor * 10.f - 5.f;
-          }
-
-          if (s==0 || inputs[SAW_LEVEL_INPUT].isPolyphonic()) {
-            levelIn[SAW] = (o && !disableOver[SAW_LEVEL_INPUT]) ? float_4::zero() : inputs[SAW_LEVEL_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SAW_LEVEL_INPUT]){
-              if (o==0) levelIn[SAW] *= oversample;
-              levelIn[SAW] = levelUpSample[s][SAW].process(levelIn[SAW]);
-            }
-          } // else preserve prior levelIn[SAW] value
-          level = bipolar[SAW] ? levelIn[SAW] : simd::ifelse(levelIn[SAW]>0.f, levelIn[SAW], 0.f);
-          level = level * params[SAW_LEVEL_AMT_PARAM].getValue() * lvlScale[SAW] + params[SAW_LEVEL_PARAM].getValue();
-          if (clampLevel)
-            level = simd::clamp(level, -1.f, 1.f);
-          if (params[SAW_ASIGN_PARAM].getValue()!=1){
-            mixOut[s] += sawOut[s] * level;
-            mixDiv += simd::fabs(level);
-          }
-
-          if (s==0 || inputs[SAW_OFFSET_INPUT].isPolyphonic()) {
-            offsetIn[SAW] = (o && !disableOver[SAW_OFFSET_INPUT]) ? float_4::zero() : inputs[SAW_OFFSET_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SAW_OFFSET_INPUT]){
-              if (o==0) offsetIn[SAW] *= oversample;
-              offsetIn[SAW] = offsetUpSample[s][SAW].process(offsetIn[SAW]);
-            }
-          } // else preserve prior offsetIn[SAW] value
-          sawOut[s] += clamp(offsetIn[SAW]*params[SAW_OFFSET_AMT_PARAM].getValue() + params[SAW_OFFSET_PARAM].getValue()*5.f, -5.f, 5.f);
-          if (params[SAW_ASIGN_PARAM].getValue()!=0)
-            sawOut[s] *= level;  
-        }
-        
-        // Mix
-        if (procMix) {
-          int folds=10;
-          if (mixMode > 2) {
-            mixOut[s] = simd::ifelse(mixDiv>0.f, mixOut[s]/mixDiv, mixOut[s]);
-            folds=3;
-          }
-          if (mixType) {
-            if (s==0 || inputs[MIX_SHAPE_INPUT].isPolyphonic()) {
-              shapeIn[MIX] = (o && !disableOver[MIX_SHAPE_INPUT]) ? float_4::zero() : inputs[MIX_SHAPE_INPUT].getPolyVoltageSimd<float_4>(c);
-              if (procOver[MIX_SHAPE_INPUT]){
-                if (o==0) shapeIn[MIX] *= oversample;
-                shapeIn[MIX] = shapeUpSample[s][MIX].process(shapeIn[MIX]);
-              }
-            } // else preserve prior shapeIn[MIX] value
-            float_4 drive = clamp(shapeIn[MIX]*params[MIX_SHAPE_AMT_PARAM].getValue() + params[MIX_SHAPE_PARAM].getValue()+1.f, 0.f, 3.f)*2.f + 1.f;
-            if (mixType==1){
-              mixOut[s] = softClip<float_4>(mixOut[s]*2.f*drive)/2.f;
-            }
-            if (mixType==2){
-              mixOut[s] *= drive;
-              float_4 clmp;
-              for (int i=0; i<folds; i++){
-                clmp = clamp(mixOut[s],-5,5);
-                mixOut[s] = clmp + clmp - mixOut[s];
-              }
-            }
-          }
-          if (s==0 || inputs[MIX_OFFSET_INPUT].isPolyphonic()) {
-            offsetIn[MIX] = (o && !disableOver[MIX_OFFSET_INPUT]) ? float_4::zero() : inputs[MIX_OFFSET_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[MIX_OFFSET_INPUT]){
-              if (o==0) offsetIn[MIX] *= oversample;
-              offsetIn[MIX] = offsetUpSample[s][MIX].process(offsetIn[MIX]);
-            }
-          } // else preserve prior offsetIn[MIX] value
-          mixOut[s] += clamp(offsetIn[MIX]*params[MIX_OFFSET_AMT_PARAM].getValue() + params[MIX_OFFSET_PARAM].getValue()*5.f, -5.f, 5.f);
-          if (s==0 || inputs[MIX_LEVEL_INPUT].isPolyphonic()) {
-            levelIn[MIX] = (o && !disableOver[MIX_LEVEL_INPUT]) ? float_4::zero() : inputs[MIX_LEVEL_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[MIX_LEVEL_INPUT]){
-              if (o==0) levelIn[MIX] *= oversample;
-              levelIn[MIX] = levelUpSample[s][MIX].process(levelIn[MIX]);
-            }
-          } // else preserve prior levelIn[MIX] value
-          level = bipolar[MIX] ? levelIn[MIX] : simd::ifelse(levelIn[MIX]>0.f, levelIn[MIX], 0.f);
-          level = level * params[MIX_LEVEL_AMT_PARAM].getValue() * lvlScale[MIX] + params[MIX_LEVEL_PARAM].getValue();
-          if (clampLevel)
-            level = simd::clamp(level, -1.f, 1.f);
-          mixOut[s] *= level;
-        }
-
-        // FINAL PROCESSING
-        // Handle one shots
-        if (once){
-          sinOut[s] = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), sinOut[s]);
-          triOut[s] = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), triOut[s]);
-          sqrOut[s] = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), sqrOut[s]);
-          sawOut[s] = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), sawOut[s]);
-          mixOut[s] = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), mixOut[s]);
-        }
-        // Remove DC offset
-        if (params[DC_PARAM].getValue()) {
-          if (outputs[SIN_OUTPUT].isConnected())
-            sinOut[s] = dcBlockFilter[s][SIN].process(sinOut[s]);
-          if (outputs[TRI_OUTPUT].isConnected())
-            triOut[s] = dcBlockFilter[s][TRI].process(triOut[s]);
-          if (outputs[SQR_OUTPUT].isConnected())
-            sqrOut[s] = dcBlockFilter[s][SQR].process(sqrOut[s]);
-          if (outputs[SAW_OUTPUT].isConnected())
-            sawOut[s] = dcBlockFilter[s][SAW].process(sawOut[s]);
-          if (outputs[MIX_OUTPUT].isConnected())
-            mixOut[s] = dcBlockFilter[s][MIX].process(mixOut[s]);
-        }
-        // Downsample outputs
-        if (oversample>1) {
-          if (outputs[SIN_OUTPUT].isConnected())
-            sinOut[s] = outDownSample[s][SIN].process(sinOut[s]);
-          if (outputs[TRI_OUTPUT].isConnected())
-            triOut[s] = outDownSample[s][TRI].process(triOut[s]);
-          if (outputs[SQR_OUTPUT].isConnected())
-            sqrOut[s] = outDownSample[s][SQR].process(sqrOut[s]);
-          if (outputs[SAW_OUTPUT].isConnected())
-            sawOut[s] = outDownSample[s][SAW].process(sawOut[s]);
-          if (outputs[MIX_OUTPUT].isConnected())
-            mixOut[s] = outDownSample[s][MIX].process(mixOut[s]);
-        }
+        blk->globalPhasor[o][s] = phasor[s] + (mixPhaseIn*mixPhaseAmt + mixPhaseParm)*250.f;
+        blk->mixOut[o][s] = float_4::zero();
+        blk->mixDiv[o][s] = float_4::zero();
       }
     }
-    
-    float_4 out{};
+
+    runKernels(simdCnt, sinMode, triMode, sqrMode, sawMode, mixMode, procSin, procTri, procSqr, procSaw, procMix);
+    downsampleOutputs(simdCnt, procWave);
+
     for (int s=0, c=0; s<simdCnt; s++, c+=4) {
-      outputs[SIN_OUTPUT].setVoltageSimd( sinOut[s], c );
-      outputs[TRI_OUTPUT].setVoltageSimd( triOut[s], c );
-      outputs[SQR_OUTPUT].setVoltageSimd( sqrOut[s], c );
-      outputs[SAW_OUTPUT].setVoltageSimd( sawOut[s], c );
-      outputs[MIX_OUTPUT].setVoltageSimd( mixOut[s], c );
+      outputs[SIN_OUTPUT].setVoltageSimd( blk->out[SIN][s], c );
+      outputs[TRI_OUTPUT].setVoltageSimd( blk->out[TRI][s], c );
+      outputs[SQR_OUTPUT].setVoltageSimd( blk->out[SQR][s], c );
+      outputs[SAW_OUTPUT].setVoltageSimd( blk->out[SAW][s], c );
+      outputs[MIX_OUTPUT].setVoltageSimd( blk->out[MIX][s], c );
     }
     outputs[SIN_OUTPUT].setChannels(channels);
     outputs[TRI_OUTPUT].setChannels(channels);
@@ -1160,6 +1232,9 @@ struct Oscillator : VenomModule {
     json_object_set_new(rootJ, "clampLevel", json_boolean(clampLevel));
     json_object_set_new(rootJ, "syncAt0", json_boolean(syncLo<0.f));
     json_object_set_new(rootJ, "disableDPW", json_boolean(disableDPW));
+    json_object_set_new(rootJ, "polyBLEP", json_boolean(polyBLEP));
+    json_object_set_new(rootJ, "subSampleSync", json_boolean(subSampleSync));
+    json_object_set_new(rootJ, "wavetable", json_boolean(wavetable));
     json_object_set_new(rootJ, "lfoAsBPM", json_boolean(lfoAsBPM));
     return rootJ;
   }
@@ -1216,6 +1291,14 @@ struct Oscillator : VenomModule {
     }
     val = json_object_get(rootJ, "disableDPW");
     disableDPW = val ? json_boolean_value(val) : true;
+    val = json_object_get(rootJ, "polyBLEP");
+    polyBLEP = val ? json_boolean_value(val) : false;
+    val = json_object_get(rootJ, "subSampleSync");
+    subSampleSync = val ? json_boolean_value(val) : false;
+    val = json_object_get(rootJ, "wavetable");
+    wavetable = val ? json_boolean_value(val) : false;
+    if (wavetable)
+      shapeTables();
     if ((val = json_object_get(rootJ, "lfoAsBPM"))) {
       lfoAsBPM = json_boolean_value(val);
     }
@@ -1229,6 +1312,7 @@ struct Oscillator : VenomModule {
   
 };
 
+#ifndef VENOM_HEADLESS
 struct OscillatorWidget : VenomWidget {
   
   struct ModeSwitch : GlowingSvgSwitchLockable {
@@ -1476,15 +1560,20 @@ struct OscillatorWidget : VenomWidget {
       }
     ));    
     menu->addChild(createBoolPtrMenuItem("Limit levels to 100%", "", &module->clampLevel));
-    menu->addChild(createBoolMenuItem("Disable DPW anti-alias", "",
-      [=]() {
-        return module->disableDPW;
-      },
-      [=](bool val) {
-        module->disableDPW = val;
+    menu->addChild(createIndexSubmenuItem(
+      "Audio anti-alias method",
+      {"Oversampling only", "DPW", "PolyBLEP"},
+      [=]() {return module->polyBLEP ? 2 : module->disableDPW ? 0 : 1;},
+      [=](int val) {
+        module->polyBLEP = (val == 2);
+        module->disableDPW = (val == 0);
         module->setMode(true);
       }
-    ));    
+    ));
+    menu->addChild(createBoolMenuItem("Band limited wavetables for sine, triangle, and saw", "",
+      [=]() {return module->wavetable;},
+      [=](bool val) {module->setWavetable(val);}
+    ));
     menu->addChild(createIndexSubmenuItem(
       "Sync trigger threshold",
       {"High 2V, Low 0.2V", "High 0V, Low -2V"},
@@ -1494,6 +1583,13 @@ struct OscillatorWidget : VenomWidget {
         module->syncLo = val ? -2.f : 0.2f;
       }
     ));
+    menu->addChild(createBoolMenuItem("Sub-sample sync and reverse timing", "",
+      [=]() {return module->subSampleSync;},
+      [=](bool val) {
+        module->subSampleSync = val;
+        module->setMode(true);
+      }
+    ));
     menu->addChild(createIndexSubmenuItem(
       "Audio mode default oversample",
       {"Off","x2","x4","x8","x16","x32"},
@@ -1504,7 +1600,10 @@ struct OscillatorWidget : VenomWidget {
   }
 
 };
+#endif
 
 }
 
-Model* modelVenomOscillator = createModel<Venom::Oscillator, Venom::OscillatorWidget>("Oscillator");
+#ifndef VENOM_HEADLESS
+Model* modelVenomOscillator = Venom::createVenomModel<Venom::Oscillator, Venom::OscillatorWidget>("Oscillator");
+#endif
@@ -186,4 +186,4 @@ struct Pan3DWidget : VenomWidget {
 
 }
 
-Model* modelVenomPan3D = createModel<Venom::Pan3D, Venom::Pan3DWidget>("Pan3D");
+Model* modelVenomPan3D = Venom::createVenomModel<Venom::Pan3D, Venom::Pan3DWidget>("Pan3D");
@@ -0,0 +1,201 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#pragma once
+#include "rack.hpp"
+
+namespace Venom {
+
+// Phase distance (0-1000 units) used to estimate waveform values and slopes on each side of an edge
+static const float POLYBLEP_EPS = 0.05f;
+
+// PolyBLEP (band limited step) and PolyBLAMP (band limited ramp) anti-aliasing for oscillators
+// that use phasors in 0-1000 units.
+// The naive waveform is delayed by one sample so that a discontinuity detected during the current
+// step can correct both the sample before and the sample after the event.
+template <typename T>
+struct PolyBLEP {
+  T held{}, pending{};
+
+  void reset() {
+    held = T(0.f);
+    pending = T(0.f);
+  }
+
+  // Add a step of height h and a slope change of m per sample that occurred d samples before the
+  // current sample (0 <= d <= 1). Only lanes set in mask are corrected.
+  void add(T mask, T h, T m, T d) {
+    T e = 1.f - d;
+    T d2 = d * d, e2 = e * e;
+    held += simd::ifelse(mask, h * d2 * 0.5f + m * d2 * d * (1.f / 6.f), T(0.f));
+    pending += simd::ifelse(mask, -h * e2 * 0.5f + m * e2 * e * (1.f / 6.f), T(0.f));
+  }
+
+  // Add the step and slope change of waveform f at phase position pos, crossed with phase change delta.
+  // The step and slopes on each side are estimated from f, so any shaped waveform can be corrected.
+  // The slope change is only applied to lanes set in ramp.
+  template <typename F>
+  void addEdge(F f, T mask, T ramp, T pos, T delta, T d) {
+    const float e = POLYBLEP_EPS;
+    T a = f(wrapPhase(pos - 2.f * e)), b = f(wrapPhase(pos - e)),
+      c = f(wrapPhase(pos + e)), g = f(wrapPhase(pos + 2.f * e));
+    T slopeBefore = simd::ifelse(ramp, (b - a) / e, T(0.f)), slopeAfter = simd::ifelse(ramp, (g - c) / e, T(0.f));
+    T h = (c - slopeAfter * e) - (b + slopeBefore * e);
+    add(mask, simd::ifelse(delta < 0.f, -h, h), (slopeAfter - slopeBefore) * simd::fabs(delta), d);
+  }
+
+  // Add the step and slope change caused by a phase reset (hard sync) from phase before to phase after.
+  // The waveform is sampled just inside each side because a reset usually lands on a discontinuity.
+  // The slope change is only applied to lanes set in ramp.
+  template <typename F>
+  void addReset(F f, T mask, T ramp, T before, T after, T delta, T d) {
+    T e = simd::ifelse(delta < 0.f, -POLYBLEP_EPS, POLYBLEP_EPS);
+    T a = f(wrapPhase(before - e - e)), b = f(wrapPhase(before - e)),
+      c = f(wrapPhase(after + e)), g = f(wrapPhase(after + e + e));
+    T slopeBefore = simd::ifelse(ramp, (b - a) / e, T(0.f)), slopeAfter = simd::ifelse(ramp, (g - c) / e, T(0.f));
+    T h = (c - slopeAfter * e) - (b + slopeBefore * e);
+    add(mask, h, (slopeAfter - slopeBefore) * delta, d);
+  }
+
+  // Add the slope change caused by a reversal of direction (soft sync) at phase pos.
+  // delta is the phase change per sample after the reversal.
+  template <typename F>
+  void addReverse(F f, T mask, T pos, T delta, T d) {
+    const float e = POLYBLEP_EPS;
+    T slope = (f(wrapPhase(pos + e)) - f(wrapPhase(pos - e))) / (2.f * e);
+    add(mask, T(0.f), slope * delta * 2.f, d);
+  }
+
+  // Returns a mask of the lanes where one of the cnt positions lies strictly between phase x and x + span
+  static T nearEdge(const T* pos, int cnt, T x, T span) {
+    T near(0.f);
+    for (int i=0; i<cnt; i++) {
+      T dist = simd::ifelse(span > 0.f, wrapPhase(pos[i] - x), wrapPhase(x - pos[i]));
+      near |= (dist > 0.f) & (dist < simd::fabs(span));
+    }
+    return near;
+  }
+
+  // Add the corrections for one step of a waveform f, where phase is the waveform phase after the step
+  // and delta is the phase change per sample. pos holds the cnt phase positions of the waveform steps
+  // and corners. Lanes set in sync were reset syncD samples before the current sample, with syncJump
+  // being the phase just before the reset relative to phase. Lanes set in rev reversed direction
+  // revD samples before the current sample.
+  // Lanes running above the Nyquist frequency are left uncorrected.
+  template <typename F>
+  void addEvents(F f, const T* pos, int cnt, T phase, T delta, T sync, T syncD, T syncJump, T rev, T revD) {
+    T valid = simd::fabs(delta) < 500.f;
+    sync &= valid;
+    bool anySync = simd::movemask(sync);
+    // A sync reset splits the step into the segments before and after the reset
+    T dS = simd::ifelse(sync, syncD, T(0.f)), scale = 1.f - dS;
+    T end = simd::ifelse(sync, phase + syncJump, phase);
+    // Corners less than 2 samples apart do not have the smooth segment between them that a
+    // PolyBLAMP correction assumes, so only their steps are corrected.
+    // Slopes are also not estimated across a neighboring position.
+    T gap(1000.f);
+    for (int i=0; cnt>1 && i<cnt; i++)
+      gap = simd::fmin(gap, wrapPhase(pos[(i+1)%cnt] - pos[i]));
+    T ramp = (gap > simd::fabs(delta) * 2.f) & (gap > POLYBLEP_EPS * 4.f);
+    T d, hit;
+    for (int i=0; i<cnt; i++) {
+      hit = crossing(end, delta * scale, pos[i], d) & valid;
+      if (simd::movemask(hit))
+        addEdge(f, hit, ramp, pos[i], delta, dS + d * scale);
+      if (anySync) {
+        hit = crossing(phase, delta * dS, pos[i], d) & sync;
+        if (simd::movemask(hit))
+          addEdge(f, hit, ramp, pos[i], delta, d * dS);
+      }
+    }
+    if (anySync) {
+      T before = phase + syncJump, after = phase - dS * delta;
+      T span = simd::ifelse(delta < 0.f, -2.f * POLYBLEP_EPS, 2.f * POLYBLEP_EPS);
+      addReset(f, sync, ramp & ~nearEdge(pos, cnt, before, -span) & ~nearEdge(pos, cnt, after, span), before, after, delta, dS);
+    }
+    T at = phase - revD * delta;
+    hit = rev & valid & ramp & ~sync & ~nearEdge(pos, cnt, at - POLYBLEP_EPS, T(2.f * POLYBLEP_EPS));
+    if (simd::movemask(hit))
+      addReverse(f, hit, at, delta, revD);
+  }
+
+  T process(T x) {
+    T out = held;
+    held = x + pending;
+    pending = T(0.f);
+    return out;
+  }
+
+  static T wrapPhase(T phase) {
+    phase = simd::fmod(phase, 1000.f);
+    return simd::ifelse(phase < 0.f, phase + 1000.f, phase);
+  }
+
+  // Returns a mask of the lanes where a phasor that changed by delta to reach phase crossed
+  // position pos, and sets d to the fraction of the step since the crossing.
+  static T crossing(T phase, T delta, T pos, T& d) {
+    T x = wrapPhase(phase - pos);
+    T y = 1000.f - x;
+    T fwd = (delta > 0.f) & (x < delta);
+    T bwd = (delta < 0.f) & (y <= -delta);
+    d = simd::ifelse(fwd, x / delta, simd::ifelse(bwd, y / -delta, T(0.f)));
+    return fwd | bwd;
+  }
+};
+
+// Phase positions (0-1000) of the steps and corners that PolyBLEP corrects for the VCO Lab and VCO Unit
+// waveforms (0 sine, 1 triangle, 2 square, 3 saw) given the shape mode and shape value.
+// Returns the number of positions loaded into pos.
+inline int polyBLEPEdges(int wave, int mode, simd::float_4 shape, simd::float_4* pos) {
+  using float_4 = simd::float_4;
+  if (wave == 2 && mode < 2) { // square PWM
+    float_4 flip = (shape + 1.f) * 500.f;
+    if (mode == 0) flip = clamp( flip, 30.f, 970.f );
+    pos[0] = 0.f;
+    pos[1] = flip;
+    return 2;
+  }
+  if ((wave == 1 && mode == 5) || wave == 2) { // triangle and square morph
+    for (int i=0; i<4; i++)
+      pos[i] = i * 250.f;
+    return 4;
+  }
+  if (mode == 5) { // sine and saw morph
+    pos[0] = 0.f;
+    pos[1] = 500.f;
+    return 2;
+  }
+  if (mode < 5) {
+    if (wave == 1) {
+      pos[0] = 250.f;
+      pos[1] = 750.f;
+      return 2;
+    }
+    pos[0] = 0.f;
+    return wave == 3;
+  }
+  // PWM or skew
+  float_4 flip = wave == 3 ? (-shape + 1.f) * 500.f : (shape + 1.f) * 500.f;
+  if (mode == 6 || wave != 3)
+    flip = clamp( flip, 30.f, 970.f );
+  if (wave == 1 && mode == 6) {
+    pos[0] = 0.f;
+    pos[1] = flip * .5f;
+    pos[2] = flip;
+    pos[3] = (flip + 1000.f) * .5f;
+    return 4;
+  }
+  if (mode == 6 || wave == 3) {
+    pos[0] = 0.f;
+    pos[1] = flip;
+  } else if (wave == 0) { // sine skew
+    pos[0] = 250.f;
+    pos[1] = flip + 250.f;
+  } else { // triangle skew
+    pos[0] = 750.f;
+    pos[1] = flip - 250.f;
+  }
+  return 2;
+}
+
+}
@@ -134,4 +134,4 @@ struct PolyCloneWidget : CloneModuleWidget {
 
 }
 
-Model* modelVenomPolyClone = createModel<Venom::PolyClone, Venom::PolyCloneWidget>("PolyClone");
+Model* modelVenomPolyClone = Venom::createVenomModel<Venom::PolyClone, Venom::PolyCloneWidget>("PolyClone");
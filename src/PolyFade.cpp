@@ -439,4 +439,4 @@ struct PolyFadeWidget : VenomWidget {
 
 }
 
-Model* modelVenomPolyFade = createModel<Venom::PolyFade, Venom::PolyFadeWidget>("PolyFade");
+Model* modelVenomPolyFade = Venom::createVenomModel<Venom::PolyFade, Venom::PolyFadeWidget>("PolyFade");
@@ -202,4 +202,4 @@ struct PolyMuteWidget : VenomWidget {
 
 }
 
-Model* modelVenomPolyMute = createModel<Venom::PolyMute, Venom::PolyMuteWidget>("PolyMute");
+Model* modelVenomPolyMute = Venom::createVenomModel<Venom::PolyMute, Venom::PolyMuteWidget>("PolyMute");
@@ -295,4 +295,4 @@ struct PolyOffsetWidget : VenomWidget {
 
 }
 
-Model* modelVenomPolyOffset = createModel<Venom::PolyOffset, Venom::PolyOffsetWidget>("PolyOffset");
+Model* modelVenomPolyOffset = Venom::createVenomModel<Venom::PolyOffset, Venom::PolyOffsetWidget>("PolyOffset");
@@ -180,4 +180,4 @@ struct PolyPruneWidget : VenomWidget {
 
 }
 
-Model* modelVenomPolyPrune = createModel<Venom::PolyPrune, Venom::PolyPruneWidget>("PolyPrune");
+Model* modelVenomPolyPrune = Venom::createVenomModel<Venom::PolyPrune, Venom::PolyPruneWidget>("PolyPrune");
@@ -43,6 +43,7 @@ struct PolySHASR : VenomModule {
 
   PolySHASR() {
     venomConfig(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+    noiseUsed = true;
     configButton(TRIG_PARAM, "Manual row 1 trigger");
     configSwitch<FixedSwitchQuantity>(OVER_PARAM, 0.f, 5.f, 0.f, "Oversample", {"Off", "x2", "x4", "x8", "x16", "x32"});
     configSwitch<FixedSwitchQuantity>(RANGE_PARAM, 0.f, 5.f, 2.f, "Random range", {"0-1", "0-5", "0-10", "+/- 1", "+/- 5", "+/- 10"});
@@ -70,8 +71,8 @@ struct PolySHASR : VenomModule {
   void process(const ProcessArgs& args) override {
     using float_4 = simd::float_4;
     VenomModule::process(args);
-    if (oversample != oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]) {
-      oversample = oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())];
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())])) {
+      oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]);
       setOversample();
     }
     int range = params[RANGE_PARAM].getValue();
@@ -130,7 +131,7 @@ struct PolySHASR : VenomModule {
             if (oversample>1)
               data = inUpSample[c][pi].process(o ? float_4::zero() : data * oversample);
           } else if (!c || inputs[TRIG_INPUT+c].isConnected()){
-            float_4 rnd{tempTrig[0]?random::uniform():0.f, tempTrig[1]?random::uniform():0.f, tempTrig[2]?random::uniform():0.f, tempTrig[3]?random::uniform():0.f,};
+            float_4 rnd = simd::movemask(tempTrig != 0.f) ? simd::ifelse(tempTrig != 0.f, noise.uniform(), 0.f) : float_4::zero();
             data = rnd * scale + offset;
           } else {
             data = c==0 ? float_4::zero() : out[c-1][pi];
@@ -241,4 +242,4 @@ struct PolySHASRWidget : VenomWidget {
 
 }
 
-Model* modelVenomPolySHASR = createModel<Venom::PolySHASR, Venom::PolySHASRWidget>("PolySHASR");
+Model* modelVenomPolySHASR = Venom::createVenomModel<Venom::PolySHASR, Venom::PolySHASRWidget>("PolySHASR");
@@ -152,4 +152,4 @@ struct PolyScaleWidget : VenomWidget {
 
 }
 
-Model* modelVenomPolyScale = createModel<Venom::PolyScale, Venom::PolyScaleWidget>("PolyScale");
+Model* modelVenomPolyScale = Venom::createVenomModel<Venom::PolyScale, Venom::PolyScaleWidget>("PolyScale");
@@ -223,4 +223,4 @@ struct PolyUnisonWidget : CloneModuleWidget {
 
 }
 
-Model* modelVenomPolyUnison = createModel<Venom::PolyUnison, Venom::PolyUnisonWidget>("PolyUnison");
+Model* modelVenomPolyUnison = Venom::createVenomModel<Venom::PolyUnison, Venom::PolyUnisonWidget>("PolyUnison");
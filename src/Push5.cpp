@@ -458,4 +458,4 @@ struct Push5Widget : VenomWidget {
 
 }
 
-Model* modelVenomPush5 = createModel<Venom::Push5, Venom::Push5Widget>("Push5");
+Model* modelVenomPush5 = Venom::createVenomModel<Venom::Push5, Venom::Push5Widget>("Push5");
@@ -69,8 +69,8 @@ struct QuadVCPolarizer : VenomModule {
     VenomModule::process(args);
     using float_4 = simd::float_4;
     int channels[4]{}, outPort[4]{-1,-1,-1,-1};
-    if (oversample != oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]) {
-      oversample = oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())];
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())])) {
+      oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]);
       oversampleEnd = oversample-1;
       setOversample();
     }
@@ -255,4 +255,4 @@ struct QuadVCPolarizerWidget : VenomWidget {
 
 }
 
-Model* modelVenomQuadVCPolarizer = createModel<Venom::QuadVCPolarizer, Venom::QuadVCPolarizerWidget>("QuadVCPolarizer");
+Model* modelVenomQuadVCPolarizer = Venom::createVenomModel<Venom::QuadVCPolarizer, Venom::QuadVCPolarizerWidget>("QuadVCPolarizer");
@@ -135,4 +135,4 @@ struct REXCVWidget : VenomWidget {
 
 }
 
-Model* modelVenomREXCV = createModel<Venom::REXCV, Venom::REXCVWidget>("REXCV");
+Model* modelVenomREXCV = Venom::createVenomModel<Venom::REXCV, Venom::REXCVWidget>("REXCV");
@@ -198,4 +198,4 @@ struct RecurseWidget : VenomWidget {
 
 }
 
-Model* modelVenomRecurse = createModel<Venom::Recurse, Venom::RecurseWidget>("Recurse");
+Model* modelVenomRecurse = Venom::createVenomModel<Venom::Recurse, Venom::RecurseWidget>("Recurse");
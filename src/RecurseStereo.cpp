@@ -248,4 +248,4 @@ struct RecurseStereoWidget : VenomWidget {
 
 }
 
-Model* modelVenomRecurseStereo = createModel<Venom::RecurseStereo, Venom::RecurseStereoWidget>("RecurseStereo");
+Model* modelVenomRecurseStereo = Venom::createVenomModel<Venom::RecurseStereo, Venom::RecurseStereoWidget>("RecurseStereo");
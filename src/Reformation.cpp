@@ -45,8 +45,7 @@ struct Reformation : VenomModule {
     LIGHTS_LEN
   };
 
-  float oldOversample = -1.f; // force initialization
-  int oversample, oversampleValues[5] = {1,4,8};
+  int oversample = -1, oversampleValues[5] = {1,4,8};
   OversampleFilter_4 cv1UpSample[4][MAP_COUNT], cv2UpSample[4][MAP_COUNT],
                      inUpSample[4], driveUpSample[4], levelUpSample[4],
                      outDownSample[4];
@@ -99,9 +98,8 @@ struct Reformation : VenomModule {
     int clip = static_cast<int>(params[CLIP_PARAM].getValue());
 
     // configure oversample
-    if (params[OVER_PARAM].getValue() != oldOversample) {
-      oldOversample = params[OVER_PARAM].getValue();
-      oversample = oversampleValues[static_cast<int>(oldOversample)];
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())], oversampleValues, 3)) {
+      oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())], oversampleValues, 3);
       setOversample();
     }
     
@@ -209,6 +207,7 @@ struct Reformation : VenomModule {
 
 };
 
+#ifndef VENOM_HEADLESS
 struct ReformationWidget : VenomWidget {
 
   struct PortSwitch : GlowingSvgSwitchLockable {
@@ -258,7 +257,10 @@ struct ReformationWidget : VenomWidget {
   }
 
 };
+#endif
 
 }
 
-Model* modelVenomReformation = createModel<Venom::Reformation, Venom::ReformationWidget>("Reformation");
+#ifndef VENOM_HEADLESS
+Model* modelVenomReformation = Venom::createVenomModel<Venom::Reformation, Venom::ReformationWidget>("Reformation");
+#endif
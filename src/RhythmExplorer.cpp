@@ -779,6 +779,7 @@ struct RhythmExplorer : VenomModule {
 
 };
 
+#ifndef VENOM_HEADLESS
 struct VCVBezelBig : app::SvgSwitch {
   VCVBezelBig() {
     momentary = true;
@@ -1051,7 +1052,10 @@ struct RhythmExplorerWidget : VenomWidget {
   }
 
 };
+#endif
 
 }
 
-Model* modelVenomRhythmExplorer = createModel<Venom::RhythmExplorer, Venom::RhythmExplorerWidget>("RhythmExplorer");
+#ifndef VENOM_HEADLESS
+Model* modelVenomRhythmExplorer = Venom::createVenomModel<Venom::RhythmExplorer, Venom::RhythmExplorerWidget>("RhythmExplorer");
+#endif
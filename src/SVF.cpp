@@ -63,8 +63,8 @@ struct SVF : VenomModule {
   std::string spreadName[2] {"Cutoff spread", "Cutoff frequency right"};
 
   using float_4 = simd::float_4;
-  float maxFreq;
-  float sampleRate;
+  float maxFreq = 0.f;
+  float sampleRate = 0.f;
   float rangeFreq[2] {dsp::FREQ_C4, 2.f};
   float rangeMaxFreq[2][8] {
  //sample rate 11kHz 12kHz 22kHz 24kHz 44kHz  48kHz  88kHz  96kHz+
@@ -75,9 +75,21 @@ struct SVF : VenomModule {
       range = 0;
   int rangeOver[2] {4,1};
   bool disableDCBlock = false;
+  // The Chamberlin core is only accurate and stable well below Nyquist, so the audio range is oversampled.
+  // The zero delay feedback (TPT) core is stable up to Nyquist and always runs at the sample rate.
+  int filterCore = 0;
+  // Stereo layout: each SIMD group holds left and right lanes for 2 channels.
+  // Mono layout: each SIMD group holds 4 channels, used when the right channel is unused and identical to the left.
+  bool monoLayout = false;
   float_4 state[4][8]{}, 
           modeState[4][7][4][8]{},
           fdbkOld[8]{};
+  ControlRamp<float_4> fRamp[8]{}, resQRamp[8]{}, fdbkRamp[8]{};
+  // Coefficient cache: the exp2 arguments that produced the current ramp targets, and the cutoff and resonance
+  // that produced the TPT gains. Coefficients are only recomputed when these change, and NaN forces a recompute.
+  float_4 freqCache[8], resCache[8], fdbkCache[8], fCache[8], resQCache[8],
+          tptA[8]{}, tptResA[8]{};
+  int coefSlope = -1, coefCore = -1;
   OversampleFilter_4 stereoUpSample[8]{},
                      lowDownSample[8]{},
                      morphDownSample[8]{},
@@ -183,7 +195,126 @@ struct SVF : VenomModule {
       configBypass(R_INPUT,i+1);
     }
     
+    configAudioRateInput(VOCT_INPUT);
+    configAudioRateInput(FREQ_CV_INPUT);
+    
+    quiescence = 1;
+    noiseUsed = true;
     setOversample();
+    invalidateCoefficients();
+  }
+
+  void invalidateCoefficients() {
+    for (int s=0; s<8; s++)
+      freqCache[s] = resCache[s] = fdbkCache[s] = fCache[s] = resQCache[s] = float_4(NAN);
+  }
+
+  // Moves the state of each channel from lanes 2*(c%2) and 2*(c%2)+1 of SIMD group c/2 (stereo layout)
+  // to lane c%4 of group c/4 (mono layout), or back. Only the left lane survives the move to mono, which is
+  // exact because both lanes are identical whenever the mono layout applies. Groups at or above cnt are unused.
+  template <typename T>
+  static void repackLanes(T (*val)[4], int cnt, bool mono) {
+    T old[8][4];
+    for (int s=0; s<cnt; s++) {
+      for (int l=0; l<4; l++)
+        old[s][l] = val[s][l];
+    }
+    for (int s=0; s<cnt; s++) {
+      for (int l=0; l<4; l++) {
+        int c = mono ? s*4+l : s*2+l/2;
+        if (!mono)
+          val[s][l] = old[c/4][c%4];
+        else if (c/2 < cnt)
+          val[s][l] = old[c/2][c%2*2];
+        else
+          val[s][l] = T(0);
+      }
+    }
+  }
+
+  static void repackVectors(float_4** vec, int cnt, bool mono) {
+    float val[8][4];
+    for (int s=0; s<cnt; s++) {
+      for (int l=0; l<4; l++)
+        val[s][l] = (*vec[s])[l];
+    }
+    repackLanes(val, cnt, mono);
+    for (int s=0; s<cnt; s++)
+      *vec[s] = float_4::load(val[s]);
+  }
+
+  void setLayout(bool mono, int channels) {
+    int cnt = (channels+1)/2;
+    float_4* vec[8];
+    for (int i=0; i<4; i++) {
+      for (int s=0; s<cnt; s++)
+        vec[s] = &state[i][s];
+      repackVectors(vec, cnt, mono);
+      for (int b=0; b<4; b++) {
+        for (int j=0; j<7; j++) {
+          for (int s=0; s<cnt; s++)
+            vec[s] = &modeState[b][j][i][s];
+          repackVectors(vec, cnt, mono);
+        }
+      }
+    }
+    for (int s=0; s<cnt; s++)
+      vec[s] = &fdbkOld[s];
+    repackVectors(vec, cnt, mono);
+    ControlRamp<float_4>* ramps[3] {fRamp, resQRamp, fdbkRamp};
+    for (ControlRamp<float_4>* ramp : ramps) {
+      float_4 ControlRamp<float_4>::* member[3] {&ControlRamp<float_4>::value, &ControlRamp<float_4>::target, &ControlRamp<float_4>::delta};
+      for (int m=0; m<3; m++) {
+        for (int s=0; s<cnt; s++)
+          vec[s] = &(ramp[s].*member[m]);
+        repackVectors(vec, cnt, mono);
+      }
+      // all active groups are set on the same ticks
+      for (int s=1; s<cnt; s++)
+        ramp[s].remaining = ramp[0].remaining;
+    }
+    OversampleFilter_4* filters[6] {stereoUpSample, morphDownSample, lowDownSample, bandDownSample, highDownSample, notchDownSample};
+    for (OversampleFilter_4* filter : filters) {
+      float_4* filterState[8][20];
+      int stateCnt = 0;
+      for (int s=0; s<cnt; s++)
+        stateCnt = filter[s].laneState(filterState[s]);
+      for (int i=0; i<stateCnt; i++) {
+        for (int s=0; s<cnt; s++)
+          vec[s] = filterState[s][i];
+        repackVectors(vec, cnt, mono);
+      }
+    }
+    for (int i=0; i<6; i++) {
+      double x[8][4], y[8][4];
+      for (int s=0; s<cnt; s++)
+        dcBlockFilter[i][s].getState(x[s], y[s]);
+      repackLanes(x, cnt, mono);
+      repackLanes(y, cnt, mono);
+      for (int s=0; s<cnt; s++)
+        dcBlockFilter[i][s].setState(x[s], y[s]);
+    }
+    monoLayout = mono;
+    invalidateCoefficients();
+  }
+
+  // One zero delay feedback SVF step with integrator states ic1 (band) and ic2 (low), where g = tan(pi*cutoff/sampleRate),
+  // k is the damping, and a = 1/(1+g*(g+k)). The notch is inverted to match the Chamberlin core.
+  static void tptStep(float_4 x, float_4 g, float_4 k, float_4 a, float_4& ic1, float_4& ic2,
+                      float_4& low, float_4& band, float_4& high, float_4& notch) {
+    float_4 v1 = a * (ic1 + g * (x - ic2)),
+            v2 = ic2 + g * v1;
+    ic1 = 2.f * v1 - ic1;
+    ic2 = 2.f * v2 - ic2;
+    low = v2;
+    band = v1;
+    notch = k * v1 - x;
+    high = -(notch + v2);
+  }
+
+  // Low frequency range filters settle too slowly to detect reliably
+  bool quiescenceAllowed() override {
+    return range == 0;
   }
 
   void setOversample() override {
@@ -205,14 +336,22 @@ struct SVF : VenomModule {
         mono = params[SPREAD_MONO_PARAM].getValue(),
         mode = params[MORPH_MODE_PARAM].getValue(),
         inputMode = params[INPUT_PARAM].getValue();
+    if (slope != coefSlope || filterCore != coefCore) {
+      coefSlope = slope;
+      coefCore = filterCore;
+      invalidateCoefficients();
+    }
 
     SpreadQuantity *spreadQuantity = static_cast<SpreadQuantity*>(paramQuantities[SPREAD_PARAM]);
     FreqQuantity *freqQuantity = static_cast<FreqQuantity*>(paramQuantities[FREQ_PARAM]);
 
-    // update range
-    if (range != static_cast<int>(params[RANGE_PARAM].getValue())) {
+    // update range and filter core
+    if (range != static_cast<int>(params[RANGE_PARAM].getValue()) || oversample != (filterCore ? 1 : rangeOver[range])) {
       range = static_cast<int>(params[RANGE_PARAM].getValue());
-      oversample = rangeOver[range];
+      if (oversample != (filterCore ? 1 : rangeOver[range])) {
+        oversample = filterCore ? 1 : rangeOver[range];
+        setOversample();
+      }
       freqQuantity->displayMultiplier = rangeFreq[range];
       if (dir == 2)
         spreadQuantity->displayMultiplier = rangeFreq[range];
@@ -232,6 +371,7 @@ struct SVF : VenomModule {
                   : 7];
       freqQuantity->maxFreq = maxFreq;
       spreadQuantity->maxFreq = maxFreq;
+      invalidateCoefficients();
       for (int i=0; i<6; i++)
         for (int j=0; j<8; j++)
           dcBlockFilter[i][j].init(oversample, sampleRate);
@@ -303,7 +443,10 @@ struct SVF : VenomModule {
             morphBRatio{},
             morphBHigh{},
             morphA,
-            morphB;
+            morphB,
+            qA{},
+            resA{},
+            dither;
 
     bool stereoConnected = inputs[L_INPUT].isConnected() || inputs[R_INPUT].isConnected(),
          outConnected[5]{ outputs[L_LOW_OUTPUT].isConnected() || outputs[R_LOW_OUTPUT].isConnected(),
@@ -333,6 +476,11 @@ struct SVF : VenomModule {
         break;
     }
 
+    // cutoff is control rate unless V/Oct or cutoff CV is patched, resonance and feedback are always control rate
+    bool tick = controlRateTick(),
+         freqAudioRate = isAudioRateInput(VOCT_INPUT) || isAudioRateInput(FREQ_CV_INPUT);
+    float_4 resQ;
+
     // get channel count
     int channels=1;
     for (int i=0; i<INPUTS_LEN; i++){
@@ -340,70 +488,124 @@ struct SVF : VenomModule {
         channels = inputs[i].getChannels();
     }
 
-    for (int s=0, c1=0, c2=1; c1<channels; s++, c1+=2, c2+=2) { // poly channel loop
-      resIn[0] = inputs[RES_CV_INPUT].getPolyVoltage(c1);
-      resIn[1] = resIn[0];
-      resIn[2] = inputs[RES_CV_INPUT].getPolyVoltage(c2);
-      resIn[3] = resIn[2];
-      driveIn[0] = inputs[DRIVE_CV_INPUT].getPolyVoltage(c1);
-      driveIn[1] = driveIn[0];
-      driveIn[2] = inputs[DRIVE_CV_INPUT].getPolyVoltage(c2);
-      driveIn[3] = driveIn[2];
-      switch (dir) {
-        case 0: // bipolar
-          voctIn[0] = voctIn[1] = inputs[VOCT_INPUT].getPolyVoltage(c1);
-          voctIn[2] = voctIn[3] = inputs[VOCT_INPUT].getPolyVoltage(c2);
-          freqIn[0] = freqIn[1] = inputs[FREQ_CV_INPUT].getPolyVoltage(c1);
-          freqIn[2] = freqIn[2] = inputs[FREQ_CV_INPUT].getPolyVoltage(c2);
-          spreadIn[0] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c1)*-0.5f;
-          spreadIn[2] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c2)*-0.5f;
-          spreadIn[1] = -spreadIn[0];
-          spreadIn[3] = -spreadIn[2];
-          break;
-        case 1: // unipolar
-          voctIn[0] = voctIn[1] = inputs[VOCT_INPUT].getPolyVoltage(c1);
-          voctIn[2] = voctIn[3] = inputs[VOCT_INPUT].getPolyVoltage(c2);
-          freqIn[0] = freqIn[1] = inputs[FREQ_CV_INPUT].getPolyVoltage(c1);
-          freqIn[2] = freqIn[2] = inputs[FREQ_CV_INPUT].getPolyVoltage(c2);
-          spreadIn[1] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c1);
-          spreadIn[3] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c2);
-          break;
-        case 2: // unipolar absolute
-          voctIn[0] = inputs[VOCT_INPUT].getPolyVoltage(c1);
-          voctIn[2] = inputs[VOCT_INPUT].getPolyVoltage(c2);
-          freqIn[0] = inputs[FREQ_CV_INPUT].getPolyVoltage(c1);
-          freqIn[2] = inputs[FREQ_CV_INPUT].getPolyVoltage(c2);
-          spreadIn[1] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c1);
-          spreadIn[3] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c2);
-          break;
+    // pack 4 mono channels per SIMD group when the right lanes would only duplicate the left
+    bool mono4 = !mono && dir<2 && params[SPREAD_PARAM].getValue()==0.f
+              && (!inputs[SPREAD_CV_INPUT].isConnected() || spreadCVAmt==0.f)
+              && !inputs[R_INPUT].isConnected() && !rightConnected[LOW] && !rightConnected[HIGH]
+              && !rightConnected[BAND] && !rightConnected[NOTCH] && !rightConnected[MORPH];
+    if (mono4 != monoLayout)
+      setLayout(mono4, channels);
+    int simdCnt = mono4 ? (channels+3)/4 : (channels+1)/2;
+
+    for (int s=0, c1=0, c2=1; s<simdCnt; s++, c1+=2, c2+=2) { // poly channel loop
+      if (mono4) {
+        int c = s*4;
+        resIn = inputs[RES_CV_INPUT].getPolyVoltageSimd<float_4>(c);
+        driveIn = inputs[DRIVE_CV_INPUT].getPolyVoltageSimd<float_4>(c);
+        voctIn = inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c);
+        freqIn = inputs[FREQ_CV_INPUT].getPolyVoltageSimd<float_4>(c);
+        fdbkIn = inputs[FDBK_CV_INPUT].getPolyVoltageSimd<float_4>(c);
+        morphIn = inputs[MORPH_CV_INPUT].getPolyVoltageSimd<float_4>(c);
+        stereoIn = inputs[L_INPUT].getPolyVoltageSimd<float_4>(c);
+      }
+      else {
+        resIn[0] = inputs[RES_CV_INPUT].getPolyVoltage(c1);
+        resIn[1] = resIn[0];
+        resIn[2] = inputs[RES_CV_INPUT].getPolyVoltage(c2);
+        resIn[3] = resIn[2];
+        driveIn[0] = inputs[DRIVE_CV_INPUT].getPolyVoltage(c1);
+        driveIn[1] = driveIn[0];
+        driveIn[2] = inputs[DRIVE_CV_INPUT].getPolyVoltage(c2);
+        driveIn[3] = driveIn[2];
+        switch (dir) {
+          case 0: // bipolar
+            voctIn[0] = voctIn[1] = inputs[VOCT_INPUT].getPolyVoltage(c1);
+            voctIn[2] = voctIn[3] = inputs[VOCT_INPUT].getPolyVoltage(c2);
+            freqIn[0] = freqIn[1] = inputs[FREQ_CV_INPUT].getPolyVoltage(c1);
+            freqIn[2] = freqIn[3] = inputs[FREQ_CV_INPUT].getPolyVoltage(c2);
+            spreadIn[0] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c1)*-0.5f;
+            spreadIn[2] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c2)*-0.5f;
+            spreadIn[1] = -spreadIn[0];
+            spreadIn[3] = -spreadIn[2];
+            break;
+          case 1: // unipolar
+            voctIn[0] = voctIn[1] = inputs[VOCT_INPUT].getPolyVoltage(c1);
+            voctIn[2] = voctIn[3] = inputs[VOCT_INPUT].getPolyVoltage(c2);
+            freqIn[0] = freqIn[1] = inputs[FREQ_CV_INPUT].getPolyVoltage(c1);
+            freqIn[2] = freqIn[3] = inputs[FREQ_CV_INPUT].getPolyVoltage(c2);
+            spreadIn[1] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c1);
+            spreadIn[3] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c2);
+            break;
+          case 2: // unipolar absolute
+            voctIn[0] = inputs[VOCT_INPUT].getPolyVoltage(c1);
+            voctIn[2] = inputs[VOCT_INPUT].getPolyVoltage(c2);
+            freqIn[0] = inputs[FREQ_CV_INPUT].getPolyVoltage(c1);
+            freqIn[2] = inputs[FREQ_CV_INPUT].getPolyVoltage(c2);
+            spreadIn[1] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c1);
+            spreadIn[3] = inputs[SPREAD_CV_INPUT].getPolyVoltage(c2);
+            break;
+        }
+        fdbkIn[0] = inputs[FDBK_CV_INPUT].getPolyVoltage(c1);
+        fdbkIn[1] = fdbkIn[0];
+        fdbkIn[2] = inputs[FDBK_CV_INPUT].getPolyVoltage(c2);
+        fdbkIn[3] = fdbkIn[2];
+
+        morphIn[0] = inputs[MORPH_CV_INPUT].getPolyVoltage(c1);
+        morphIn[1] = morphIn[0];
+        morphIn[2] = inputs[MORPH_CV_INPUT].getPolyVoltage(c2);
+        morphIn[3] = morphIn[2];
+
+        stereoIn[0] = inputs[L_INPUT].getPolyVoltage(c1);
+        stereoIn[1] = inputs[R_INPUT].getNormalPolyVoltage(stereoIn[0], c1);
+        stereoIn[2] = inputs[L_INPUT].getPolyVoltage(c2);
+        stereoIn[3] = inputs[R_INPUT].getNormalPolyVoltage(stereoIn[2], c2);
       }
-      fdbkIn[0] = inputs[FDBK_CV_INPUT].getPolyVoltage(c1);
-      fdbkIn[1] = fdbkIn[0];
-      fdbkIn[2] = inputs[FDBK_CV_INPUT].getPolyVoltage(c2);
-      fdbkIn[3] = fdbkIn[2];
-
-      morphIn[0] = inputs[MORPH_CV_INPUT].getPolyVoltage(c1);
-      morphIn[1] = morphIn[0];
-      morphIn[2] = inputs[MORPH_CV_INPUT].getPolyVoltage(c2);
-      morphIn[3] = morphIn[2];
-
-      stereoIn[0] = inputs[L_INPUT].getPolyVoltage(c1);
-      stereoIn[1] = inputs[R_INPUT].getNormalPolyVoltage(stereoIn[0], c1);
-      stereoIn[2] = inputs[L_INPUT].getPolyVoltage(c2);
-      stereoIn[3] = inputs[R_INPUT].getNormalPolyVoltage(stereoIn[2], c2);
       if (inputMode)
         stereoIn = dcBlockFilter[STEREOIN][s].process(stereoIn);
       stereoIn *= 10.f;
-      freq = pow(2.f, freqParam + voctIn + freqIn*freqCVAmt + spreadParam + spreadIn*spreadCVAmt) * rangeFreq[range];
-      freq = ifelse(freq>maxFreq, maxFreq, freq);
-      res = clamp(resParam + resIn * resCVAmt) * 4.5f;
+      if (freqAudioRate || tick || fRamp[s].unset()) {
+        freq = freqParam + voctIn + freqIn*freqCVAmt + spreadParam + spreadIn*spreadCVAmt;
+        if (simd::movemask(freq != freqCache[s])) {
+          freqCache[s] = freq;
+          freq = dsp::exp2_taylor5(freq) * rangeFreq[range];
+          freq = ifelse(freq>maxFreq, maxFreq, freq);
+          f = sampleTimePi * freq;
+          fRamp[s].set(filterCore ? sin_taylor11(f) / cos_taylor12(f) : 2.f * sin_taylor11(f), freqAudioRate ? 1 : CONTROL_RATE_DIVISION);
+        }
+      }
+      f = fRamp[s].process();
       drive = clamp(driveParam + driveIn * driveCVAmt, minGain, 10.f);
-      fdbkAmt = clamp(pow(2.f, fdbkParam + fdbkIn*fdbkCVAmt));
-      fdbkAmt = ifelse(fdbkAmt<0.001f, 0.f, fdbkAmt);
-      if (range==0)
-        fdbkAmt *= 0.5;
-      f = 2.f * sin(sampleTimePi * freq);
-      q = (slope==0) ? 1.f / pow(2.f, res) : 1.f;
+      if (tick || resQRamp[s].unset()) {
+        res = resParam + resIn * resCVAmt;
+        fdbkAmt = fdbkParam + fdbkIn*fdbkCVAmt;
+        if (simd::movemask((res != resCache[s]) | (fdbkAmt != fdbkCache[s]))) {
+          resCache[s] = res;
+          fdbkCache[s] = fdbkAmt;
+          resQRamp[s].set(dsp::exp2_taylor5(clamp(res) * -4.5f), CONTROL_RATE_DIVISION);
+          fdbkAmt = clamp(dsp::exp2_taylor5(fdbkAmt));
+          fdbkAmt = ifelse(fdbkAmt<0.001f, 0.f, fdbkAmt);
+          if (range==0)
+            fdbkAmt *= 0.5;
+          fdbkRamp[s].set(fdbkAmt, CONTROL_RATE_DIVISION);
+        }
+      }
+      resQ = resQRamp[s].process();
+      fdbkAmt = fdbkRamp[s].process();
+      q = (slope==0) ? resQ : 1.f;
+      if (filterCore){
+        // the oversampled Chamberlin core damps the stages before the last with 1 on the first step of each sample and
+        // with resQ on the remaining steps, so the same average damping keeps the resonance of both cores alike
+        if (slope)
+          q = (1.f + (rangeOver[range]-1) * resQ) / rangeOver[range];
+        if (simd::movemask((f != fCache[s]) | (resQ != resQCache[s]))) {
+          fCache[s] = f;
+          resQCache[s] = resQ;
+          tptA[s] = 1.f / (1.f + f * (f + q));
+          tptResA[s] = slope ? 1.f / (1.f + f * (f + resQ)) : tptA[s];
+        }
+        qA = tptA[s];
+        resA = tptResA[s];
+      }
       if (outConnected[MORPH]){
         morphBRatio = clamp(morphParam + morphIn*morphCVAmt);
         if (mode==1){
@@ -417,47 +619,69 @@ struct SVF : VenomModule {
         if (oversample>1 && stereoConnected) {
           stereoIn = stereoUpSample[s].process(o ? 0.f : stereoIn*oversample);
         }
-        stereo = (stereoIn * drive) + (1e-4f * (2.f*random::uniform() - 1.f)) + (fdbkOld[s] * fdbkAmt);
-        notch = state[NOTCH][s] = q * state[BAND][s] - stereo;
-        high = state[HIGH][s] = -(state[NOTCH][s] + state[LOW][s]);
-        band = state[BAND][s] = state[BAND][s] + f * state[HIGH][s];
-        low = state[LOW][s] = state[LOW][s] + f * state[BAND][s];
-        for (int i=0; i<slope; i++){ // slope loop
-          if (i==slope-1)
-            q = 1.f / pow(2.f, res);
-          int b=LOW;
-          if (outConnected[b] || outConnected[MORPH]){
-            stereo = low;
-            modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
-            modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
-            modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
-            low = modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
-          }
-          b=HIGH;
-          if (outConnected[b] || outConnected[MORPH]){
-            stereo = high;
-            modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
-            high = modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
-            modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
-            modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
-          }
-          b=BAND;
-          // always compute band states for feedback
-            stereo = band;
-            modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
-            modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
-            band = modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
-            modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
-          //
-          b=NOTCH;
-          if (outConnected[b]){
-            stereo = notch;
-            notch = modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
-            modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
-            modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
-            modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
-          }
-        } // end slope loop
+        // independent noise per channel, shared by the left and right lanes of a stereo channel
+        dither = noise.bipolar();
+        if (!mono4)
+          dither = _mm_shuffle_ps(dither.v, dither.v, _MM_SHUFFLE(2,2,0,0));
+        stereo = (stereoIn * drive) + (1e-4f * dither) + (fdbkOld[s] * fdbkAmt);
+        if (filterCore){
+          tptStep(stereo, f, q, qA, state[BAND][s], state[LOW][s], low, band, high, notch);
+          for (int i=0; i<slope; i++){ // slope loop
+            float_4 k = (i==slope-1) ? resQ : q,
+                    a = (i==slope-1) ? resA : qA,
+                    unused[3];
+            if (outConnected[LOW] || outConnected[MORPH])
+              tptStep(low, f, k, a, modeState[LOW][i][BAND][s], modeState[LOW][i][LOW][s], low, unused[0], unused[1], unused[2]);
+            if (outConnected[HIGH] || outConnected[MORPH])
+              tptStep(high, f, k, a, modeState[HIGH][i][BAND][s], modeState[HIGH][i][LOW][s], unused[0], unused[1], high, unused[2]);
+            // always compute band states for feedback
+            tptStep(band, f, k, a, modeState[BAND][i][BAND][s], modeState[BAND][i][LOW][s], unused[0], band, unused[1], unused[2]);
+            if (outConnected[NOTCH])
+              tptStep(notch, f, k, a, modeState[NOTCH][i][BAND][s], modeState[NOTCH][i][LOW][s], unused[0], unused[1], unused[2], notch);
+          } // end slope loop
+        }
+        else {
+          notch = state[NOTCH][s] = q * state[BAND][s] - stereo;
+          high = state[HIGH][s] = -(state[NOTCH][s] + state[LOW][s]);
+          band = state[BAND][s] = state[BAND][s] + f * state[HIGH][s];
+          low = state[LOW][s] = state[LOW][s] + f * state[BAND][s];
+          for (int i=0; i<slope; i++){ // slope loop
+            if (i==slope-1)
+              q = resQ;
+            int b=LOW;
+            if (outConnected[b] || outConnected[MORPH]){
+              stereo = low;
+              modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
+              modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
+              modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
+              low = modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
+            }
+            b=HIGH;
+            if (outConnected[b] || outConnected[MORPH]){
+              stereo = high;
+              modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
+              high = modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
+              modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
+              modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
+            }
+            b=BAND;
+            // always compute band states for feedback
+              stereo = band;
+              modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
+              modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
+              band = modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
+              modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
+            //
+            b=NOTCH;
+            if (outConnected[b]){
+              stereo = notch;
+              notch = modeState[b][i][NOTCH][s] = q * modeState[b][i][BAND][s] - stereo;
+              modeState[b][i][HIGH][s] = -(modeState[b][i][NOTCH][s] + modeState[b][i][LOW][s]);
+              modeState[b][i][BAND][s] = modeState[b][i][BAND][s] + f * modeState[b][i][HIGH][s];
+              modeState[b][i][LOW][s] = modeState[b][i][LOW][s] + f * modeState[b][i][BAND][s];
+            }
+          } // end slope loop
+        }
         fdbkOld[s] = softClip(band/10.f);
         if (outConnected[MORPH]){
           switch (mode){
@@ -499,14 +723,14 @@ struct SVF : VenomModule {
           }
           if (mode<5){
             morph = morphA * morphARatio + morphB * morphBRatio;
-            if (!rightConnected[MORPH]){
+            if (!mono4 && !rightConnected[MORPH]){
               morph[0] = mono ? morph[0]-morph[1] : (morph[0]+morph[1])/2.f;
               morph[2] = mono ? morph[2]-morph[3] : (morph[2]+morph[3])/2.f;
             }
             morph = softClip(morph*0.1f);
           }
           else {
-            if (!rightConnected[MORPH]){
+            if (!mono4 && !rightConnected[MORPH]){
               morphB[0] = mono ? morphB[0]-morphB[1] : (morphB[0]+morphB[1])/2.f;
               morphB[2] = mono ? morphB[2]-morphB[3] : (morphB[2]+morphB[3])/2.f;
             }
@@ -516,7 +740,7 @@ struct SVF : VenomModule {
             morph = morphDownSample[s].process(morph);
         }
         if (outConnected[LOW]){
-          if (!rightConnected[LOW]){
+          if (!mono4 && !rightConnected[LOW]){
             low[0] = mono ? low[0]-low[1] : (low[0]+low[1])/2.f;
             low[2] = mono ? low[2]-low[3] : (low[2]+low[3])/2.f;
             low[1] = low[3] = 0.f;
@@ -526,7 +750,7 @@ struct SVF : VenomModule {
             low = lowDownSample[s].process(low);
         }
         if (outConnected[HIGH]){
-          if (!rightConnected[HIGH]){
+          if (!mono4 && !rightConnected[HIGH]){
             high[0] = mono ? high[0]-high[1] : (high[0]+high[1])/2.f;
             high[2] = mono ? high[2]-high[3] : (high[2]+high[3])/2.f;
             high[1] = high[3] = 0.f;
@@ -536,7 +760,7 @@ struct SVF : VenomModule {
             high = highDownSample[s].process(high);
         }
         if (outConnected[BAND]){
-          if (!rightConnected[BAND]){
+          if (!mono4 && !rightConnected[BAND]){
             band[0] = mono ? band[0]-band[1] : (band[0]+band[1])/2.f;
             band[2] = mono ? band[2]-band[3] : (band[2]+band[3])/2.f;
             band[1] = band[3] = 0.f;
@@ -546,7 +770,7 @@ struct SVF : VenomModule {
             band = bandDownSample[s].process(band);
         }
         if (outConnected[NOTCH]){
-          if (!rightConnected[NOTCH]){
+          if (!mono4 && !rightConnected[NOTCH]){
             notch[0] = mono ? notch[0]-notch[1] : (notch[0]+notch[1])/2.f;
             notch[2] = mono ? notch[2]-notch[3] : (notch[2]+notch[3])/2.f;
             notch[1] = notch[3] = 0.f;
@@ -568,6 +792,14 @@ struct SVF : VenomModule {
         if (outConnected[NOTCH])
           notch = dcBlockFilter[NOTCH][s].process(notch);
       }
+      if (mono4) {
+        outputs[L_MORPH_OUTPUT].setVoltageSimd(morph, s*4);
+        outputs[L_LOW_OUTPUT].setVoltageSimd(low, s*4);
+        outputs[L_HIGH_OUTPUT].setVoltageSimd(high, s*4);
+        outputs[L_BAND_OUTPUT].setVoltageSimd(band, s*4);
+        outputs[L_NOTCH_OUTPUT].setVoltageSimd(notch, s*4);
+        continue;
+      }
       outputs[L_MORPH_OUTPUT].setVoltage(morph[0], c1);
       outputs[R_MORPH_OUTPUT].setVoltage(morph[1], c1);
       outputs[L_MORPH_OUTPUT].setVoltage(morph[2], c2);
@@ -609,6 +841,7 @@ struct SVF : VenomModule {
   json_t* dataToJson() override {
     json_t* rootJ = VenomModule::dataToJson();
     json_object_set_new(rootJ, "disableDCBlock", json_boolean(disableDCBlock));
+    json_object_set_new(rootJ, "filterCore", json_integer(filterCore));
     return rootJ;
   }
 
@@ -618,10 +851,14 @@ struct SVF : VenomModule {
     if ((val = json_object_get(rootJ, "disableDCBlock"))) {
       disableDCBlock = json_boolean_value(val);
     }
+    if ((val = json_object_get(rootJ, "filterCore"))) {
+      filterCore = json_integer_value(val);
+    }
   }
         
 };
 
+#ifndef VENOM_HEADLESS
 struct SVFWidget : VenomWidget {
   
   struct RangeSwitch : GlowingSvgSwitchLockable {
@@ -743,10 +980,14 @@ struct SVFWidget : VenomWidget {
     SVF* module = static_cast<SVF*>(this->module);
     menu->addChild(new MenuSeparator);
     menu->addChild(createBoolPtrMenuItem("Disable audio output DC block", "", &module->disableDCBlock));    
+    menu->addChild(createIndexPtrSubmenuItem("Filter core", {"Chamberlin (oversampled)", "Zero delay feedback"}, &module->filterCore));
     VenomWidget::appendContextMenu(menu);
   }
 
 };
+#endif
 }
 
-Model* modelVenomSVF = createModel<Venom::SVF, Venom::SVFWidget>("SVF");
+#ifndef VENOM_HEADLESS
+Model* modelVenomSVF = Venom::createVenomModel<Venom::SVF, Venom::SVFWidget>("SVF");
+#endif
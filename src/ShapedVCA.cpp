@@ -46,8 +46,7 @@ struct ShapedVCA : VenomModule {
   float levelScale, levelScaleVals[6] = {1.f, 2.f, 10.f, 2.f, 4.f, 20.f};
   float levelDefaultVals[6] = {1.f, 0.5f, 0.1f, 1.f, 0.75f, 0.55f};
   float offsetVals[3] = {0.f, -5.f, 5.f};
-  float oldOversample = -1; // force initialization
-  int oversample, overVals[5] = {1, 4, 8, 16, 32};
+  int oversample = -1, overVals[5] = {1, 4, 8, 16, 32};
   OversampleFilter_4 levelUpSample[4], curveUpSample[4], 
                      leftUpSample[4], rightUpSample[4], 
                      leftDownSample[4], rightDownSample[4];
@@ -103,9 +102,8 @@ struct ShapedVCA : VenomModule {
     int simdCnt = (channels+3)/4;
 
     // configure oversample
-    if (params[OVER_PARAM].getValue() != oldOversample) {
-      oldOversample = params[OVER_PARAM].getValue();
-      oversample = overVals[static_cast<int>(oldOversample)];
+    if (oversample != governedOversample(overVals[static_cast<int>(params[OVER_PARAM].getValue())], overVals, 5)) {
+      oversample = governedOversample(overVals[static_cast<int>(params[OVER_PARAM].getValue())], overVals, 5);
       setOversample();
     }
     
@@ -202,6 +200,7 @@ struct ShapedVCA : VenomModule {
 
 };
 
+#ifndef VENOM_HEADLESS
 struct ShapedVCAWidget : VenomWidget {
   
   struct RangeSwitch : GlowingSvgSwitchLockable {
@@ -288,7 +287,10 @@ struct ShapedVCAWidget : VenomWidget {
   }
 
 };
+#endif
 
 }
 
-Model* modelVenomShapedVCA = createModel<Venom::ShapedVCA, Venom::ShapedVCAWidget>("ShapedVCA");
+#ifndef VENOM_HEADLESS
+Model* modelVenomShapedVCA = Venom::createVenomModel<Venom::ShapedVCA, Venom::ShapedVCAWidget>("ShapedVCA");
+#endif
@@ -49,6 +49,7 @@ struct Slew : VenomModule {
   int overMinDeltaIndex = 0;
   float overMinDelta[5] {1e-2f,1e-3f,1e-4f,1e-5f,1e-6f};
   float_4 oldOut[4]{};
+  ControlRamp<float_4> riseMultRamp[4]{}, fallMultRamp[4]{};
   
 
   Slew() {
@@ -86,6 +87,7 @@ struct Slew : VenomModule {
     configOutput(SLEW_OUTPUT, "Slew");
 
     configBypass(RAW_INPUT, SLEW_OUTPUT);
+    configAudioRateInput(VOCT_INPUT);
 
     oversampleStages = 5;
   }
@@ -104,8 +106,8 @@ struct Slew : VenomModule {
   void process(const ProcessArgs& args) override {
     VenomModule::process(args);
     // update oversample configuration
-    if (oversample != oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]) {
-      oversample = oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())];
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())])) {
+      oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]);
       setOversample();
     }
     // gate values
@@ -121,11 +123,14 @@ struct Slew : VenomModule {
     // speed dependent slew constants    
     float kLin = 10*(fast ? 523.26f : 4.f)/args.sampleRate/oversample;
     float kCurve = fast ? 30.f : 4000.f;
+    // rise and fall rates are control rate unless V/Oct is patched
+    bool tick = controlRateTick(),
+         audioRate = isAudioRateInput(VOCT_INPUT);
     // get channel count
     int channels = 1;
     for (int i=0; i<INPUTS_LEN; i++)
       channels = std::max({channels, inputs[i].getChannels()});
-    float_4 in[INPUTS_LEN]{}, out[OUTPUTS_LEN]{};
+    float_4 in[INPUTS_LEN]{}, out[OUTPUTS_LEN]{}, riseMult, fallMult;
     // channel loop
     for (int s=0, c=0; c<channels; s++, c+=4){
       // oversample loop
@@ -134,6 +139,10 @@ struct Slew : VenomModule {
         if (!o) {
           for (int i=0; i<INPUTS_LEN; i++)
             in[i] = inputs[i].getPolyVoltageSimd<float_4>(c);
+          if ((tick || riseMultRamp[s].unset()) && !audioRate) {
+            riseMultRamp[s].set(pow(2.f, -params[RISE_TIME_PARAM].getValue() - in[RISE_TIME_CV_INPUT]*params[RISE_TIME_CV_PARAM].getValue()), CONTROL_RATE_DIVISION*oversample);
+            fallMultRamp[s].set(pow(2.f, -params[FALL_TIME_PARAM].getValue() - in[FALL_TIME_CV_INPUT]*params[FALL_TIME_CV_PARAM].getValue()), CONTROL_RATE_DIVISION*oversample);
+          }
         }
         // upsample inputs
         if (oversample > 1){
@@ -143,8 +152,13 @@ struct Slew : VenomModule {
           }
         }
         // compute outputs
-        float_4 riseMult = pow(2.f, in[VOCT_INPUT] - params[RISE_TIME_PARAM].getValue() - in[RISE_TIME_CV_INPUT]*params[RISE_TIME_CV_PARAM].getValue());
-        float_4 fallMult = pow(2.f, in[VOCT_INPUT] - params[FALL_TIME_PARAM].getValue() - in[FALL_TIME_CV_INPUT]*params[FALL_TIME_CV_PARAM].getValue());
+        if (audioRate) {
+          riseMult = pow(2.f, in[VOCT_INPUT] - params[RISE_TIME_PARAM].getValue() - in[RISE_TIME_CV_INPUT]*params[RISE_TIME_CV_PARAM].getValue());
+          fallMult = pow(2.f, in[VOCT_INPUT] - params[FALL_TIME_PARAM].getValue() - in[FALL_TIME_CV_INPUT]*params[FALL_TIME_CV_PARAM].getValue());
+        } else {
+          riseMult = riseMultRamp[s].process();
+          fallMult = fallMultRamp[s].process();
+        }
         float_4 diff = in[RAW_INPUT] - oldOut[s];
         out[RISE_OUTPUT] = ifelse(diff>minDelta, hi, lo);
         out[FALL_OUTPUT] = ifelse(diff<-minDelta, hi, lo);
@@ -267,4 +281,4 @@ struct SlewWidget : VenomWidget {
 
 }
 
-Model* modelVenomSlew = createModel<Venom::Slew, Venom::SlewWidget>("Slew");
+Model* modelVenomSlew = Venom::createVenomModel<Venom::Slew, Venom::SlewWidget>("Slew");
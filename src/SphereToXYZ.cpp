@@ -61,8 +61,8 @@ struct SphereToXYZ : VenomModule {
 
   void process(const ProcessArgs& args) override {
     VenomModule::process(args);
-    if (oversample != oversampleValues[params[OVER_PARAM].getValue()]) {
-      oversample = oversampleValues[params[OVER_PARAM].getValue()];
+    if (oversample != governedOversample(oversampleValues[params[OVER_PARAM].getValue()])) {
+      oversample = governedOversample(oversampleValues[params[OVER_PARAM].getValue()]);
       setOversample();
     }
     using float_4 = simd::float_4;
@@ -125,4 +125,4 @@ struct SphereToXYZWidget : VenomWidget {
 
 }
 
-Model* modelVenomSphereToXYZ = createModel<Venom::SphereToXYZ, Venom::SphereToXYZWidget>("SphereToXYZ");
+Model* modelVenomSphereToXYZ = Venom::createVenomModel<Venom::SphereToXYZ, Venom::SphereToXYZWidget>("SphereToXYZ");
@@ -155,4 +155,4 @@ struct Split4x2Widget : VenomWidget {
 
 }
 
-Model* modelVenomSplit4x2 = createModel<Venom::Split4x2, Venom::Split4x2Widget>("Split4x2");
+Model* modelVenomSplit4x2 = Venom::createVenomModel<Venom::Split4x2, Venom::Split4x2Widget>("Split4x2");
@@ -69,4 +69,4 @@ struct ThruWidget : VenomWidget {
 
 }
 
-Model* modelVenomThru = createModel<Venom::Thru, Venom::ThruWidget>("Thru");
+Model* modelVenomThru = Venom::createVenomModel<Venom::Thru, Venom::ThruWidget>("Thru");
@@ -416,4 +416,4 @@ struct VCAMix4Widget : MixBaseWidget {
 
 }
 
-Model* modelVenomVCAMix4 = createModel<Venom::VCAMix4, Venom::VCAMix4Widget>("VCAMix4");
+Model* modelVenomVCAMix4 = Venom::createVenomModel<Venom::VCAMix4, Venom::VCAMix4Widget>("VCAMix4");
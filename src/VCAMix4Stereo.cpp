@@ -527,6 +527,7 @@ struct VCAMix4Stereo : MixBaseModule {
 
 };
 
+#ifndef VENOM_HEADLESS
 struct VCAMix4StereoWidget : MixBaseWidget {
 
   VCAMix4StereoWidget(VCAMix4Stereo* module) {
@@ -577,6 +578,9 @@ struct VCAMix4StereoWidget : MixBaseWidget {
   }
 
 };
+#endif
 
 }
-Model* modelVenomVCAMix4Stereo = createModel<Venom::VCAMix4Stereo, Venom::VCAMix4StereoWidget>("VCAMix4Stereo");
+#ifndef VENOM_HEADLESS
+Model* modelVenomVCAMix4Stereo = Venom::createVenomModel<Venom::VCAMix4Stereo, Venom::VCAMix4StereoWidget>("VCAMix4Stereo");
+#endif
@@ -4,6 +4,7 @@
 #include "Venom.hpp"
 #include "Filter.hpp"
 #include "math.hpp"
+#include "PolyBLEP.hpp"
 #include <float.h>
 
 namespace Venom {
@@ -77,14 +78,19 @@ struct VCOUnit : VenomModule {
   bool alternate = false;
   bool disableDPW = false;
   bool aliasSuppress = false;
+  bool polyBLEP = false;
+  bool blepActive = false;
+  bool subSampleSync = true; // off for patches saved before the option existed
+  bool subSample = false; // sync and reverse events are timed within the step (PolyBLEP or subSampleSync in audio frequency modes)
   using float_4 = simd::float_4;
   int oversample = -1, sampleRate = 0;
   std::vector<int> oversampleValues = {1,2,4,8,16,32};
-  OversampleFilter_4 expUpSample[4]{}, linUpSample[4]{}, revUpSample[4]{}, syncUpSample[4]{},
-                     shapeUpSample[4]{}, phaseUpSample[4]{}, offsetUpSample[4]{}, levelUpSample[4]{},
-                     outDownSample[4]{};
-  float_4 phasor[4]{}, phasorDir[4]{{1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}, {1.f, 1.f, 1.f, 1.f}};
-  DCBlockFilter_4 linDcBlockFilter[4]{}, outDcBlockFilter[4]{};
+  OversampleFilterBank<INPUTS_LEN> upSample; // indexed by input id
+  WideOversampleFilter outDownSample;
+  float_4 outBlock[32][4]{}; // output of each oversample step and SIMD group, DC blocked and downsampled as a block
+  float_4 phasor[16]{}, phasorDir[16]{}; // indexed by SIMD group of lanes
+  DCBlockFilter_4 linDcBlockFilter[4]{};
+  WideDCBlockFilter outDcBlockFilter;
   bool linDCCouple = false;
   bool linNoThru0 = false;
   dsp::SchmittTrigger syncTrig[16], revTrig[16];
@@ -95,8 +101,20 @@ struct VCOUnit : VenomModule {
   bool once = false;
   bool noRetrigger = false;
   bool gated = false;
-  float_4 onceActive[4]{};
+  float_4 onceActive[16]{};
   int modeDefaultOver[3] = {2, 0, 2};
+  float_4 syncPrev[4]{}, revPrev[4]{}, blepRaw[16]{};
+  PolyBLEP<float_4> blep[16]{};
+  // Unison: each voice is played by unison detuned copies in consecutive lanes (64 lanes maximum),
+  // which are summed per voice before DC blocking and downsampling
+  int unisonCopies = 1, unisonDetune = 3; // context menu settings
+  int unison = 1, unisonSettings = -1;
+  float unisonCents[6] = {5.f, 10.f, 15.f, 20.f, 30.f, 50.f};
+  float unisonOffsetGain = 1.f;
+  int laneVoice[64]{};
+  float_4 laneRatio[16]{}, laneGain[16]{}; // frequency ratio and gain of each lane
+  // Per voice values handed from the voice loop to the lane loop
+  float_4 voiceSync[4]{}, voiceSyncD[4]{}, voiceRev[4]{}, voiceRevD[4]{}, voiceShape[4]{}, voicePhase[4]{}, voiceLevel[4]{}, voiceOffset[4]{};
   
   struct ShapeQuantity : ParamQuantity {
     float getDisplayValue() override {
@@ -224,6 +242,9 @@ struct VCOUnit : VenomModule {
     configLight(VCA_LIGHT, "Bipolar VCA indicator");
     
     oversampleStages = 5;
+    oversampleFIR = true;
+    for (int i=0; i<16; i++)
+      phasorDir[i] = 1.f;
   }
 
   float_4 sinSimd_1000(float_4 t) {
@@ -244,7 +265,9 @@ struct VCOUnit : VenomModule {
   void setMode(bool shortCircuit = false) {
     currentMode = static_cast<int>(params[MODE_PARAM].getValue());
     mode = currentMode>5 ? 1 : currentMode>2 ? 0 : currentMode;
-    aliasSuppress = !(mode || disableDPW);
+    aliasSuppress = !(mode || disableDPW || polyBLEP);
+    blepActive = mode!=1 && polyBLEP;
+    subSample = mode!=1 && (polyBLEP || subSampleSync);
     paramQuantities[FREQ_PARAM]->unit = mode==1 && lfoAsBPM ? " BPM" : " Hz";
     if (shortCircuit)
       return;
@@ -291,6 +314,52 @@ struct VCOUnit : VenomModule {
       setLock(true, SHAPE_MODE_PARAM);
   }
 
+  // Polyphony requested by the inputs, before any unison limit
+  int inputChannels() {
+    int channels = 1;
+    if (!params[RESET_POLY_PARAM].getValue()){
+      for (int i=0; i<INPUTS_LEN; i++) {
+        int c = inputs[i].getChannels();
+        if (c>channels)
+          channels = c;
+      }
+    }
+    return channels;
+  }
+
+  // Voices that fit in the 64 lanes with the given number of copies each, never more than 16.
+  // Additional input channels are ignored.
+  static int maxUnisonVoices(int copies) {
+    return std::min(64/copies, 16);
+  }
+
+  // Lays out the unison lanes. Copies are spread evenly across the detune range,
+  // with gains that keep the summed level about the same as a single copy, and start at random phases.
+  void setUnison() {
+    unisonSettings = unisonCopies*10 + unisonDetune;
+    bool changed = unison != unisonCopies;
+    unison = unisonCopies;
+    float cents = unisonCents[unisonDetune], norm = 1.f / std::sqrt(unison);
+    for (int l=0; l<64; l++) {
+      int j = l % unison;
+      float pos = unison > 1 ? j * 2.f / (unison - 1) - 1.f : 0.f; // -1 to 1 across the copies
+      laneVoice[l] = std::min(l / unison, 15);
+      laneRatio[l>>2][l&3] = std::pow(2.f, pos * cents / 1200.f);
+      laneGain[l>>2][l&3] = norm;
+      if (changed && unison > 1)
+        phasor[l>>2][l&3] = random::uniform() * 1000.f;
+    }
+    unisonOffsetGain = 1.f / unison;
+  }
+
+  // Per voice values for SIMD group s of the lanes
+  float_4 lane(const float_4* voice, int s) {
+    if (unison == 1)
+      return voice[s];
+    const int* v = &laneVoice[s*4];
+    return float_4(voice[v[0]>>2][v[0]&3], voice[v[1]>>2][v[1]&3], voice[v[2]>>2][v[2]&3], voice[v[3]>>2][v[3]&3]);
+  }
+
   void setUnity5(bool rm) {
     unity5 = rm;
     lvlScale = rm ? 0.2f : 0.1f;
@@ -303,17 +372,8 @@ struct VCOUnit : VenomModule {
   }
   
   void setOversample() override {
-    for (int i=0; i<4; i++){
-      expUpSample[i].setOversample(oversample, oversampleStages);
-      linUpSample[i].setOversample(oversample, oversampleStages);
-      revUpSample[i].setOversample(oversample, oversampleStages);
-      syncUpSample[i].setOversample(oversample, oversampleStages);
-      shapeUpSample[i].setOversample(oversample, oversampleStages);
-      phaseUpSample[i].setOversample(oversample, oversampleStages);
-      offsetUpSample[i].setOversample(oversample, oversampleStages);
-      levelUpSample[i].setOversample(oversample, oversampleStages);
-      outDownSample[i].setOversample(oversample, oversampleStages);
-    }
+    upSample.setOversample(oversample, oversampleStages);
+    outDownSample.setOversample(oversample, oversampleStages, true);
   }
   
   void loadPhases(float_4* phases, float_4 phasor, float_4 delta){
@@ -342,6 +402,195 @@ struct VCOUnit : VenomModule {
     return ((buffer[0] - buffer[1] - buffer[1] + buffer[2])*denInv + 1.f) / 2.f;
   }
 
+  // Waveform shaper. raw is the unwrapped waveform phasor, shapeRaw is the unclamped shape value.
+  // basePhaseDelta, lowFreq, and denInv are only used by DPW alias suppression.
+  float_4 waveShape(float_4 raw, float_4 shapeRaw, int shapeMode, bool dpw, float_4 basePhaseDelta, float_4 lowFreq, float_4 denInv) {
+    float_4 shape = clamp(shapeRaw, -1.f, 1.f), out{}, wavePhasor{}, sawPhasor{}, offsetSawPhasor{};
+    float_4 shapeSign = 0.f;
+    float_4 phases[3]{};
+    float_4 flip = 0.f;
+    switch (wave) {
+      case 0: // SIN
+        wavePhasor = simd::fmod(raw, 1000.f);
+        wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+        switch (shapeMode) {
+          case 0:  // exp/log
+            wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
+            out = crossfade(wavePhasor, ifelse(shape>0.f, 11.f*wavePhasor/(10.f*simd::abs(wavePhasor)+1.f), simd::sgn(wavePhasor)*simd::pow(wavePhasor,4)), ifelse(shape>0.f, shape, -shape))*5.f;
+            break;
+          case 1:  // J curve
+            wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
+            out = (normSigmoid((wavePhasor+1.f)/2.f, -shape*0.9f)*2.f-1.f) * 5.f;
+            break;
+          case 2: // S curve
+            wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
+            out = normSigmoid(wavePhasor, -shape*0.9f) * 5.f;
+            break;
+          case 3: // Rectify
+          case 4: // Normalized Rectify
+            wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
+            shape = -shape;
+            shapeSign = simd::sgn(shape);
+            out = simd::ifelse(shapeSign==0, wavePhasor, -(shapeSign*simd::abs(-wavePhasor+shapeSign-shape)-shapeSign+shape));
+            if (shapeMode==4) // Normalized rectify
+              out = -((1+simd::abs(shape))*-out-shape);
+            out *= 5.f;
+            break;
+          case 5: // morph square <--> sine <--> saw
+            wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
+            out = wavePhasor * 5.f * (1.f - simd::abs(shape)); // sine component
+            // square and saw components
+            wavePhasor = simd::fmod(raw + simd::ifelse(raw<0.f, 0.f, 500.f), 1000.f);
+            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+            out += simd::ifelse( shape<=0.f,
+                                    simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * shape, // square component
+                                    (wavePhasor*0.01f - 5.f) * shape // saw component
+                                  );
+            break;
+          default: // skew or PWM
+            flip = (shapeRaw + 1.f) * 500.f;
+            flip = clamp( flip, 30.f, 970.f );
+            if (shapeMode==7) // Skew
+              wavePhasor += simd::ifelse(wavePhasor>250.f, -250.f, 750.f);
+            wavePhasor = 1000.f*simd::ifelse(wavePhasor<flip, wavePhasor/flip/2.f, (wavePhasor-flip)/(1000.f-flip)/2.f+0.5f);
+            if (shapeMode==6) // Pulse width
+              wavePhasor += simd::ifelse(wavePhasor>250.f, -250.f, 750.f);
+            out = sinSimd_1000(wavePhasor) * 5.f;
+        } // end sine shape switch
+        break;
+      case 1: // TRI
+        wavePhasor = simd::fmod(raw, 1000.f);
+        wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+        switch (shapeMode) {
+          case 0:  // exp/log
+            wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
+            shape = simd::ifelse(wavePhasor<500.f, shape, -shape);
+            wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
+            out = crossfade(wavePhasor, ifelse(shape>0.f, 11.f*wavePhasor/(10.f*simd::abs(wavePhasor)+1.f), simd::sgn(wavePhasor)*simd::pow(wavePhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
+            break;
+          case 1:  // J curve
+            wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
+            shape = simd::ifelse(wavePhasor<500.f, shape, -shape);
+            wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
+            out = normSigmoid(wavePhasor, -shape*0.8) * 10.f - 5.f;
+            break;
+          case 2: // S curve
+            wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
+            shape = simd::ifelse(wavePhasor<500.f, shape, -shape);
+            wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
+            out = normSigmoid(wavePhasor*2.f-1.f, -shape*0.8) * 5.f;
+            break;
+          case 3: // Rectify
+          case 4: // Normalized Rectify
+            wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
+            wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
+            shape = -shape;
+            shapeSign = simd::sgn(shape);
+            out = wavePhasor*2.f-1.f;
+            out = simd::ifelse(shapeSign==0, out, -(shapeSign*simd::abs(-out+shapeSign-shape)-shapeSign+shape));
+            if (shapeMode==4) // Normalized Rectify
+              out = -((1+simd::abs(shape))*-out-shape);
+            out *= 5.f;
+            break;
+          case 5: // morph sine <--> triangle <--> square
+            wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
+            wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
+            out = (wavePhasor*10.f - 5.f) * (1.f - simd::abs(shape)); // triangle component
+            // sine and square components
+            wavePhasor = simd::fmod(raw - simd::ifelse(shape<=0.f, 250.f, 0.f), 1000.f);
+            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+            out += simd::ifelse( shape<=0.f,
+                                    sinSimd_1000(wavePhasor)*5.f * -shape, // sine component
+                                    simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * shape // square component
+                                  );
+            break;
+          default: // PWM or skew
+            flip = (shapeRaw + 1.f) * 500.f;
+            flip = clamp( flip, 30.f, 970.f );
+            if (shapeMode==7) // skew
+              wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
+            wavePhasor = 1000.f*simd::ifelse(wavePhasor<flip, wavePhasor/flip/2.f, (wavePhasor-flip)/(1000.f-flip)/2.f+0.5f);
+            if (shapeMode==6) // PWM
+              wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
+            wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
+            out = wavePhasor * 10.f - 5.f;
+        } // end triangle shape switch
+        break;
+      case 2: // SQR
+        wavePhasor = simd::fmod(raw, 1000.f);
+        wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+        if (shapeMode%3==2) { // morph tri <--> sqr <--> saw
+          out = simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * (1.f - simd::abs(shape)); // square component
+          // triangle and saw components
+          wavePhasor = simd::fmod(raw + simd::ifelse(shape<=0.f, 250.f, 500.f), 1000.f);
+          wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+          out += simd::ifelse( shape<=0.f, 
+                                  (simd::ifelse(wavePhasor<500.f, wavePhasor, (1000.f-wavePhasor))*.02f - 5.f) * -shape, // triangle component
+                                  (wavePhasor*0.01f - 5.f) * shape // saw component
+                                );
+        } else { // PWM
+          flip = (shapeRaw + 1.f) * 500.f;
+          if (shapeMode%3==0) flip = clamp( flip, 30.f, 970.f );
+          out = ifelse(wavePhasor<flip, 5.f, -5.f);
+          if (dpw) {
+            loadPhases(phases, wavePhasor * 0.001f, basePhaseDelta);
+            sawPhasor = aliasSuppressedSaw(phases, denInv);
+            offsetSawPhasor = aliasSuppressedOffsetSaw(phases, 1.f - flip*0.001f, denInv);
+            out = ifelse(lowFreq, out, (offsetSawPhasor - sawPhasor + flip*0.001f - 0.5f) * 10.f);
+          }
+        }
+        break;
+      default: // 3 SAW
+        wavePhasor = simd::fmod(raw, 1000.f);
+        wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+        wavePhasor *= 0.001f;
+        if (dpw && shapeMode < 3) {
+          loadPhases(phases, wavePhasor, basePhaseDelta);
+          wavePhasor = ifelse(lowFreq, wavePhasor, aliasSuppressedSaw(phases, denInv));
+        }
+        switch (shapeMode) {
+          case 0:  // exp/log
+            out = crossfade(wavePhasor, ifelse(shape>0.f, 11.f*wavePhasor/(10.f*simd::abs(wavePhasor)+1.f), simd::sgn(wavePhasor)*simd::pow(wavePhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
+            break;
+          case 1:  // J Curve
+            out = normSigmoid(wavePhasor, -shape*0.90) * 10.f - 5.f;
+            break;
+          case 2: // S Curve
+            out = normSigmoid(wavePhasor*2.f-1.f, -shape*0.85) * 5.f;
+            break;
+          case 3: // Rectify
+          case 4: // Normalized Rectify
+            shape = -shape;
+            shapeSign = simd::sgn(shape);
+            out = wavePhasor*2.f-1.f;
+            out = simd::ifelse(shapeSign==0, out, -(shapeSign*simd::abs(-out+shapeSign-shape)-shapeSign+shape));
+            if (shapeMode==4) // Normalized Rectify
+              out = -((1+simd::abs(shape))*-out-shape);
+            out *= 5.f;
+            break;
+          case 5: // morph square <--> saw <--> even
+            out = (wavePhasor*10.f - 5.f) * simd::ifelse(shape<0.f, 1.f + shape, 1.f); // saw component
+            // square component
+            wavePhasor = simd::fmod(raw + simd::ifelse(shape<=0.f, 500.f, 0.f), 1000.f);
+            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+            out += simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * simd::abs(shape) * simd::ifelse(shape<0.f, 1.f, 0.5f);
+            // sine component
+            wavePhasor = simd::fmod(raw, 1000.f);
+            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
+            out += simd::ifelse(shape<0.f, 0.f, sinSimd_1000(wavePhasor) * 3.175 * shape);
+            break;
+          default: // PWM
+            flip = 1.f - (shapeRaw + 1.f) * .5f;
+            if (shapeMode==6)
+              flip = clamp( flip, .03f, .97f );
+            wavePhasor = simd::ifelse(wavePhasor<flip, wavePhasor/flip/2.f, (wavePhasor-flip)/(1.f-flip)/2.f+0.5f);
+            out = wavePhasor * 10.f - 5.f;
+            break;
+        } // end saw shape switch
+    } // end wave switch
+    return out;
+  }
+
   void process(const ProcessArgs& args) override {
     VenomModule::process(args);
 
@@ -352,31 +601,26 @@ struct VCOUnit : VenomModule {
       setWave();
     }
 
-    if (oversample != oversampleValues[params[OVER_PARAM].getValue()]) {
-      oversample = oversampleValues[params[OVER_PARAM].getValue()];
+    if (oversample != governedOversample(oversampleValues[params[OVER_PARAM].getValue()])) {
+      oversample = governedOversample(oversampleValues[params[OVER_PARAM].getValue()]);
       setOversample();
       sampleRate = 0;
     }
     if (sampleRate != args.sampleRate){
       sampleRate = args.sampleRate;
-      for (int i=0; i<4; i++){
+      for (int i=0; i<4; i++)
         linDcBlockFilter[i].init(oversample, sampleRate);
-        outDcBlockFilter[i].init(oversample, sampleRate);
-      }
+      outDcBlockFilter.init(oversample, sampleRate);
     }
     // get channel count
-    int channels = 1;
-    if (!params[RESET_POLY_PARAM].getValue()){
-      for (int i=0; i<INPUTS_LEN; i++) {
-        int c = inputs[i].getChannels();
-        if (c>channels)
-          channels = c;
-      }
-    }
-    int simdCnt = (channels+3)/4;
+    int channels = inputChannels();
+    if (unisonSettings != unisonCopies*10 + unisonDetune)
+      setUnison();
+    channels = std::min(channels, maxUnisonVoices(unison));
+    int simdCnt = (channels+3)/4, lanes = channels*unison, laneCnt = (lanes+3)/4;
     
     float_4 expIn{}, linIn{}, expDepthIn[4]{}, linDepthIn[4]{}, vOctIn[4]{}, revIn{}, syncIn{}, freq[4]{},
-            shapeIn{}, phaseIn{}, offsetIn{}, levelIn{}, out[4]{}, wavePhasor{}, sawPhasor{}, offsetSawPhasor{};
+            shapeIn{}, phaseIn{}, offsetIn{}, levelIn{};
     float vOctParm = mode<2 ? params[FREQ_PARAM].getValue() + params[OCTAVE_PARAM].getValue() : params[FREQ_PARAM].getValue();
     float k =  1000.f * args.sampleTime / oversample;
     float_4 basePhaseDelta{}, lowFreq{}, denInv{};
@@ -400,20 +644,44 @@ struct VCOUnit : VenomModule {
     
     if (softSync != inputs[REV_INPUT].isConnected()) {
       if (softSync) {
-        for (int i=0; i<4; i++) phasorDir[i] = 1.f;
+        for (int i=0; i<16; i++) phasorDir[i] = 1.f;
       }
       softSync = !softSync;
     }
     
     int shapeMode = static_cast<int>(params[SHAPE_MODE_PARAM].getValue());
-    bool procOver[INPUTS_LEN]{};
-    for (int i=0; i<INPUTS_LEN; i++)
+    // Inputs that are not upsampled are read once per frame, and held for every oversample step if heldIn
+    bool procOver[INPUTS_LEN]{}, heldIn[INPUTS_LEN]{};
+    for (int i=0; i<INPUTS_LEN; i++) {
       procOver[i] = oversample>1 && inputs[i].isConnected() && !disableOver[i];
+      heldIn[i] = disableOver[i];
+    }
+    // Upsample all CV inputs for the block in a single pass of the filter bank, releasing unused filters.
+    // An input whose filter has no bank slot is held for the block instead.
+    for (int id : {EXP_INPUT, LIN_INPUT, REV_INPUT, SYNC_INPUT, SHAPE_INPUT, PHASE_INPUT, LEVEL_INPUT, OFFSET_INPUT}) {
+      if (!procOver[id] || (id==EXP_INPUT && alternate)) {
+        upSample.release(id);
+        continue;
+      }
+      int groups = inputs[id].isPolyphonic() ? simdCnt : 1;
+      float_4 (*buf)[4] = upSample.block(id);
+      if (!buf) {
+        procOver[id] = false;
+        heldIn[id] = true;
+        continue;
+      }
+      for (int s=0, c=0; s<groups; s++, c+=4) {
+        buf[0][s] = inputs[id].getPolyVoltageSimd<float_4>(c) * static_cast<float>(oversample);
+        for (int o=1; o<oversample; o++)
+          buf[o][s] = float_4::zero();
+      }
+      upSample.queue(id, groups);
+    }
+    upSample.process(oversample);
     // main loops
     for (int o=0; o<oversample; o++){
+      // Per voice CV, frequency, and sync and reverse events
       for (int s=0, c=0; s<simdCnt; s++, c+=4){
-        float_4 level{};
-        // Main Phasor
         if (!o) {
           if (!alternate) {
             if (s==0 || inputs[EXP_DEPTH_INPUT].isPolyphonic()) {
@@ -429,48 +697,42 @@ struct VCOUnit : VenomModule {
         }
         if (!alternate) {
           if (s==0 || inputs[EXP_INPUT].isPolyphonic()) {
-            expIn = (o && !disableOver[EXP_INPUT]) ? float_4::zero() : inputs[EXP_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[EXP_INPUT]){
-              if (o==0) expIn *= oversample;
-              expIn = expUpSample[s].process(expIn);
-            }
+            expIn = procOver[EXP_INPUT] ? upSample.block(EXP_INPUT)[o][s]
+              : (o && !heldIn[EXP_INPUT]) ? float_4::zero() : inputs[EXP_INPUT].getPolyVoltageSimd<float_4>(c);
           } // else preserve prior expIn value
         }
         if (s==0 || inputs[LIN_INPUT].isPolyphonic()) {
-          linIn = (o && !disableOver[LIN_INPUT]) ? float_4::zero() : inputs[LIN_INPUT].getPolyVoltageSimd<float_4>(c);
-          if (procOver[LIN_INPUT]){
-            if (o==0) linIn *= oversample;
-            linIn = linUpSample[s].process(linIn);
-          }
+          linIn = procOver[LIN_INPUT] ? upSample.block(LIN_INPUT)[o][s]
+            : (o && !heldIn[LIN_INPUT]) ? float_4::zero() : inputs[LIN_INPUT].getPolyVoltageSimd<float_4>(c);
         } // else preserve prior linIn value
         if (inputs[LIN_INPUT].isConnected() && !linDCCouple)
           linIn = linDcBlockFilter[s].process(linIn);
-        float_4 rev{};
+        voiceRev[s] = voiceRevD[s] = float_4::zero();
         if (inputs[REV_INPUT].isConnected()) {
           if (s==0 || inputs[REV_INPUT].isPolyphonic()) {
-            revIn = (o && !disableOver[REV_INPUT]) ? float_4::zero() : inputs[REV_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[REV_INPUT]){
-              if (o==0) revIn *= oversample;
-              revIn = revUpSample[s].process(revIn);
-            }
+            revIn = procOver[REV_INPUT] ? upSample.block(REV_INPUT)[o][s]
+              : (o && !heldIn[REV_INPUT]) ? float_4::zero() : inputs[REV_INPUT].getPolyVoltageSimd<float_4>(c);
           } // else preserve prior value
           for (int i=0; i<4; i++){
-            rev[i] = revTrig[c+i].process(revIn[i], syncLo, syncHi);
+            voiceRev[s][i] = revTrig[c+i].process(revIn[i], syncLo, syncHi);
           }
-        }
-        float_4 sync{};
+          if (subSample) // fraction of the step since the input crossed the high threshold
+            voiceRevD[s] = clamp((revIn - syncHi) / (revIn - revPrev[s]), 0.f, 1.f);
+          revPrev[s] = revIn;
+        } else revPrev[s] = float_4::zero();
+        voiceSync[s] = voiceSyncD[s] = float_4::zero();
         if (inputs[SYNC_INPUT].isConnected()) {
           if (s==0 || inputs[SYNC_INPUT].isPolyphonic()) {
-            syncIn = (o && !disableOver[SYNC_INPUT]) ? float_4::zero() : inputs[SYNC_INPUT].getPolyVoltageSimd<float_4>(c);
-            if (procOver[SYNC_INPUT]){
-              if (o==0) syncIn *= oversample;
-              syncIn = syncUpSample[s].process(syncIn);
-            }
+            syncIn = procOver[SYNC_INPUT] ? upSample.block(SYNC_INPUT)[o][s]
+              : (o && !heldIn[SYNC_INPUT]) ? float_4::zero() : inputs[SYNC_INPUT].getPolyVoltageSimd<float_4>(c);
           } // else preserve prior syncIn value
           for (int i=0; i<4; i++){
-            sync[i] = syncTrig[c+i].process(syncIn[i], syncLo, syncHi) && !(noRetrigger && onceActive[s][i]);
+            voiceSync[s][i] = syncTrig[c+i].process(syncIn[i], syncLo, syncHi);
           }
-        } else onceActive[s] = float_4::zero();
+          if (subSample)
+            voiceSyncD[s] = clamp((syncIn - syncHi) / (syncIn - syncPrev[s]), 0.f, 1.f);
+          syncPrev[s] = syncIn;
+        } else syncPrev[s] = float_4::zero();
         if (!alternate) {
           freq[s] = vOctIn[s] + vOctParm + expIn*expDepthIn[s]*params[EXP_PARAM].getValue();
           freq[s] = dsp::exp2_taylor5(freq[s]) + linIn*linDepthIn[s]*params[LIN_PARAM].getValue();
@@ -480,10 +742,57 @@ struct VCOUnit : VenomModule {
           freq[s] = (vOctParm + vOctIn[s])*biasFreq + linIn*linDepthIn[s]*params[LIN_PARAM].getValue()*((params[OCTAVE_PARAM].getValue()+4.f)*3.f+1.f);
         }
         freq[s] *= modeFreq[0][mode];
+
+        if (s==0 || inputs[SHAPE_INPUT].isPolyphonic()) {
+          shapeIn = procOver[SHAPE_INPUT] ? upSample.block(SHAPE_INPUT)[o][s]
+            : (o && !heldIn[SHAPE_INPUT]) ? float_4::zero() : inputs[SHAPE_INPUT].getPolyVoltageSimd<float_4>(c);
+        } // preserve prior shapeIn value
+        if (s==0 || inputs[PHASE_INPUT].isPolyphonic()) {
+          phaseIn = procOver[PHASE_INPUT] ? upSample.block(PHASE_INPUT)[o][s]
+            : (o && !heldIn[PHASE_INPUT]) ? float_4::zero() : inputs[PHASE_INPUT].getPolyVoltageSimd<float_4>(c);
+        } // else preserve prior phaseIn value
+        voiceShape[s] = shapeIn*params[SHAPE_AMT_PARAM].getValue()*shpScale + params[SHAPE_PARAM].getValue();
+        voicePhase[s] = (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
+
+        if (s==0 || inputs[LEVEL_INPUT].isPolyphonic()) {
+          levelIn = procOver[LEVEL_INPUT] ? upSample.block(LEVEL_INPUT)[o][s]
+            : (o && !heldIn[LEVEL_INPUT]) ? float_4::zero() : inputs[LEVEL_INPUT].getPolyVoltageSimd<float_4>(c);
+        } // else preserve prior levelIn value
+        float_4 level = bipolar ? levelIn : simd::ifelse(levelIn>0.f, levelIn, 0.f);
+        level = level * params[LEVEL_AMT_PARAM].getValue() * lvlScale + params[LEVEL_PARAM].getValue();
+        if (clampLevel)
+          level = simd::clamp(level, -1.f, 1.f);
+        voiceLevel[s] = level;
+
+        if (s==0 || inputs[OFFSET_INPUT].isPolyphonic()) {
+          offsetIn = procOver[OFFSET_INPUT] ? upSample.block(OFFSET_INPUT)[o][s]
+            : (o && !heldIn[OFFSET_INPUT]) ? float_4::zero() : inputs[OFFSET_INPUT].getPolyVoltageSimd<float_4>(c);
+        } // else preserve prior offsetIn[SIN] value
+        voiceOffset[s] = clamp(offsetIn*params[OFFSET_AMT_PARAM].getValue() + params[OFFSET_PARAM].getValue()*5.f, -5.f, 5.f);
+      }
+
+      // Phasors and waveforms of each lane. Without unison each lane is a voice.
+      if (unison > 1) {
+        for (int s=0; s<simdCnt; s++)
+          outBlock[o][s] = float_4::zero();
+      }
+      for (int s=0, c=0; s<laneCnt; s++, c+=4){
+        // Main Phasor
+        float_4 rev = lane(voiceRev, s), revD = lane(voiceRevD, s), sync = lane(voiceSync, s), syncD = lane(voiceSyncD, s), syncJump{};
+        if (inputs[SYNC_INPUT].isConnected()) {
+          if (noRetrigger)
+            sync = simd::ifelse(onceActive[s] != 0.f, 0.f, sync);
+        } else onceActive[s] = float_4::zero();
+        float_4 laneFreq = lane(freq, s);
+        if (unison > 1)
+          laneFreq *= laneRatio[s];
         phasorDir[s] = simd::ifelse(rev>0.f, phasorDir[s]*-1.f, phasorDir[s]);
         phasorDir[s] = simd::ifelse(sync>0.f, 1.f, phasorDir[s]);
-        basePhaseDelta = freq[s] * phasorDir[s] * k;
-        phasor[s] += basePhaseDelta;
+        basePhaseDelta = laneFreq * phasorDir[s] * k;
+        float_4 phaseDelta = basePhaseDelta, prevPhasor = phasor[s];
+        phasor[s] += phaseDelta;
+        if (subSample) // A reverse only applies to the portion of the step after the event
+          phasor[s] += simd::ifelse(rev>0.f, phaseDelta * (revD - 1.f) * 2.f, 0.f);
         if (aliasSuppress) {
           basePhaseDelta *= 0.001f;
           lowFreq = simd::abs(basePhaseDelta) < 1e-3;
@@ -495,266 +804,71 @@ struct VCOUnit : VenomModule {
         if (once)
           onceActive[s] = simd::ifelse(tempPhasor != phasor[s], float_4::zero(), onceActive[s]);
         phasor[s] = tempPhasor;
-        phasor[s] = simd::ifelse(sync>0.f, float_4::zero(), phasor[s]);
+        if (subSample) {
+          // Sub-sample sync: the reset phasor has already advanced for the portion of the step after the event
+          float_4 resetPhasor = syncD * phaseDelta;
+          syncJump = prevPhasor + phaseDelta * (1.f - syncD) - resetPhasor;
+          phasor[s] = simd::ifelse(sync>0.f, resetPhasor, phasor[s]);
+        }
+        else
+          phasor[s] = simd::ifelse(sync>0.f, float_4::zero(), phasor[s]);
         if (once)
           onceActive[s] = simd::ifelse(sync>float_4::zero(), 1.f, onceActive[s]);
         if (gated){
           for (int i=0; i<4; i++){
-            if (!syncTrig[c+i].isHigh())
+            if (!syncTrig[laneVoice[c+i]].isHigh())
               onceActive[s][i] = 0.f;
           }
         }
 
         // Process Waveform
-        if (s==0 || inputs[SHAPE_INPUT].isPolyphonic()) {
-          shapeIn = (o && !disableOver[SHAPE_INPUT]) ? float_4::zero() : inputs[SHAPE_INPUT].getPolyVoltageSimd<float_4>(c);
-          if (procOver[SHAPE_INPUT]){
-            if (o==0) shapeIn *= oversample;
-            shapeIn = shapeUpSample[s].process(shapeIn);
-          }
-        } // preserve prior shapeIn value
-        float_4 shape = clamp(shapeIn*params[SHAPE_AMT_PARAM].getValue()*shpScale + params[SHAPE_PARAM].getValue(), -1.f, 1.f);
-        if (s==0 || inputs[PHASE_INPUT].isPolyphonic()) {
-          phaseIn = (o && !disableOver[PHASE_INPUT]) ? float_4::zero() : inputs[PHASE_INPUT].getPolyVoltageSimd<float_4>(c);
-          if (procOver[PHASE_INPUT]){
-            if (o==0) phaseIn *= oversample;
-            phaseIn = phaseUpSample[s].process(phaseIn);
-          }
-        } // else preserve prior phaseIn value
-
-        float_4 shapeSign = 0.f;
-        float_4 phases[3]{};
-        float_4 flip = 0.f;
-        switch (wave) {
-          case 0: // SIN
-            wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-            wavePhasor = simd::fmod(wavePhasor, 1000.f);
-            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-            switch (shapeMode) {
-              case 0:  // exp/log
-                wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
-                out[s] = crossfade(wavePhasor, ifelse(shape>0.f, 11.f*wavePhasor/(10.f*simd::abs(wavePhasor)+1.f), simd::sgn(wavePhasor)*simd::pow(wavePhasor,4)), ifelse(shape>0.f, shape, -shape))*5.f;
-                break;
-              case 1:  // J curve
-                wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
-                out[s] = (normSigmoid((wavePhasor+1.f)/2.f, -shape*0.9f)*2.f-1.f) * 5.f;
-                break;
-              case 2: // S curve
-                wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
-                out[s] = normSigmoid(wavePhasor, -shape*0.9f) * 5.f;
-                break;
-              case 3: // Rectify
-              case 4: // Normalized Rectify
-                wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
-                shape = -shape;
-                shapeSign = simd::sgn(shape);
-                out[s] = simd::ifelse(shapeSign==0, wavePhasor, -(shapeSign*simd::abs(-wavePhasor+shapeSign-shape)-shapeSign+shape));
-                if (shapeMode==4) // Normalized rectify
-                  out[s] = -((1+simd::abs(shape))*-out[s]-shape);
-                out[s] *= 5.f;
-                break;
-              case 5: // morph square <--> sine <--> saw
-                wavePhasor = sinSimd_1000(wavePhasor + simd::ifelse(wavePhasor>250.f, -250.f, 750.f));
-                out[s] = wavePhasor * 5.f * (1.f - simd::abs(shape)); // sine component
-                // square and saw components
-                wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-                wavePhasor = simd::fmod(wavePhasor + simd::ifelse(wavePhasor<0.f, 0.f, 500.f), 1000.f);
-                wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-                out[s] += simd::ifelse( shape<=0.f,
-                                        simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * shape, // square component
-                                        (wavePhasor*0.01f - 5.f) * shape // saw component
-                                      );
-                break;
-              default: // skew or PWM
-                flip = (shapeIn*params[SHAPE_AMT_PARAM].getValue()*shpScale + params[SHAPE_PARAM].getValue() + 1.f) * 500.f;
-                flip = clamp( flip, 30.f, 970.f );
-                if (shapeMode==7) // Skew
-                  wavePhasor += simd::ifelse(wavePhasor>250.f, -250.f, 750.f);
-                wavePhasor = 1000.f*simd::ifelse(wavePhasor<flip, wavePhasor/flip/2.f, (wavePhasor-flip)/(1000.f-flip)/2.f+0.5f);
-                if (shapeMode==6) // Pulse width
-                  wavePhasor += simd::ifelse(wavePhasor>250.f, -250.f, 750.f);
-                out[s] = sinSimd_1000(wavePhasor) * 5.f;
-            } // end sine shape switch
-            break;
-          case 1: // TRI
-            wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-            wavePhasor = simd::fmod(wavePhasor, 1000.f);
-            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-            switch (shapeMode) {
-              case 0:  // exp/log
-                wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
-                shape = simd::ifelse(wavePhasor<500.f, shape, -shape);
-                wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
-                out[s] = crossfade(wavePhasor, ifelse(shape>0.f, 11.f*wavePhasor/(10.f*simd::abs(wavePhasor)+1.f), simd::sgn(wavePhasor)*simd::pow(wavePhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
-                break;
-              case 1:  // J curve
-                wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
-                shape = simd::ifelse(wavePhasor<500.f, shape, -shape);
-                wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
-                out[s] = normSigmoid(wavePhasor, -shape*0.8) * 10.f - 5.f;
-                break;
-              case 2: // S curve
-                wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
-                shape = simd::ifelse(wavePhasor<500.f, shape, -shape);
-                wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
-                out[s] = normSigmoid(wavePhasor*2.f-1.f, -shape*0.8) * 5.f;
-                break;
-              case 3: // Rectify
-              case 4: // Normalized Rectify
-                wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
-                wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
-                shape = -shape;
-                shapeSign = simd::sgn(shape);
-                out[s] = wavePhasor*2.f-1.f;
-                out[s] = simd::ifelse(shapeSign==0, out[s], -(shapeSign*simd::abs(-out[s]+shapeSign-shape)-shapeSign+shape));
-                if (shapeMode==4) // Normalized Rectify
-                  out[s] = -((1+simd::abs(shape))*-out[s]-shape);
-                out[s] *= 5.f;
-                break;
-              case 5: // morph sine <--> triangle <--> square
-                wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
-                wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
-                out[s] = (wavePhasor*10.f - 5.f) * (1.f - simd::abs(shape)); // triangle component
-                // sine and square components
-                wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-                wavePhasor = simd::fmod(wavePhasor - simd::ifelse(shape<=0.f, 250.f, 0.f), 1000.f);
-                wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-                out[s] += simd::ifelse( shape<=0.f,
-                                        sinSimd_1000(wavePhasor)*5.f * -shape, // sine component
-                                        simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * shape // square component
-                                      );
-                break;
-              default: // PWM or skew
-                flip = (shapeIn*params[SHAPE_AMT_PARAM].getValue()*shpScale + params[SHAPE_PARAM].getValue() + 1.f) * 500.f;
-                flip = clamp( flip, 30.f, 970.f );
-                if (shapeMode==7) // skew
-                  wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
-                wavePhasor = 1000.f*simd::ifelse(wavePhasor<flip, wavePhasor/flip/2.f, (wavePhasor-flip)/(1000.f-flip)/2.f+0.5f);
-                if (shapeMode==6) // PWM
-                  wavePhasor += simd::ifelse(wavePhasor<750.f, 250.f, -750.f);
-                wavePhasor = simd::ifelse(wavePhasor<500.f, wavePhasor*.002f, (1000.f-wavePhasor)*.002f);
-                out[s] = wavePhasor * 10.f - 5.f;
-            } // end triangle shape switch
-            break;
-          case 2: // SQR
-            shapeMode %= 3;
-            wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-            wavePhasor = simd::fmod(wavePhasor, 1000.f);
-            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-            if (shapeMode==2) { // morph tri <--> sqr <--> saw
-              out[s] = simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * (1.f - simd::abs(shape)); // square component
-              // triangle and saw components
-              wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-              wavePhasor = simd::fmod(wavePhasor + simd::ifelse(shape<=0.f, 250.f, 500.f), 1000.f);
-              wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-              out[s] += simd::ifelse( shape<=0.f, 
-                                      (simd::ifelse(wavePhasor<500.f, wavePhasor, (1000.f-wavePhasor))*.02f - 5.f) * -shape, // triangle component
-                                      (wavePhasor*0.01f - 5.f) * shape // saw component
-                                    );
-            } else { // PWM
-              flip = (shapeIn*params[SHAPE_AMT_PARAM].getValue()*shpScale + params[SHAPE_PARAM].getValue() + 1.f) * 500.f;
-              if (!shapeMode) flip = clamp( flip, 30.f, 970.f );
-              out[s] = ifelse(wavePhasor<flip, 5.f, -5.f);
-              if (aliasSuppress) {
-                loadPhases(phases, wavePhasor * 0.001f, basePhaseDelta);
-                sawPhasor = aliasSuppressedSaw(phases, denInv);
-                offsetSawPhasor = aliasSuppressedOffsetSaw(phases, 1.f - flip*0.001f, denInv);
-                out[s] = ifelse(lowFreq, out[s], (offsetSawPhasor - sawPhasor + flip*0.001f - 0.5f) * 10.f);
-              }
-            }
-            break;
-          default: // 3 SAW
-            wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-            wavePhasor = simd::fmod(wavePhasor, 1000.f);
-            wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-            wavePhasor *= 0.001f;
-            if (aliasSuppress && shapeMode < 3) {
-              loadPhases(phases, wavePhasor, basePhaseDelta);
-              wavePhasor = ifelse(lowFreq, wavePhasor, aliasSuppressedSaw(phases, denInv));
-            }
-            switch (shapeMode) {
-              case 0:  // exp/log
-                out[s] = crossfade(wavePhasor, ifelse(shape>0.f, 11.f*wavePhasor/(10.f*simd::abs(wavePhasor)+1.f), simd::sgn(wavePhasor)*simd::pow(wavePhasor,4)), ifelse(shape>0.f, shape, -shape))*10.f-5.f;
-                break;
-              case 1:  // J Curve
-                out[s] = normSigmoid(wavePhasor, -shape*0.90) * 10.f - 5.f;
-                break;
-              case 2: // S Curve
-                out[s] = normSigmoid(wavePhasor*2.f-1.f, -shape*0.85) * 5.f;
-                break;
-              case 3: // Rectify
-              case 4: // Normalized Rectify
-                shape = -shape;
-                shapeSign = simd::sgn(shape);
-                out[s] = wavePhasor*2.f-1.f;
-                out[s] = simd::ifelse(shapeSign==0, out[s], -(shapeSign*simd::abs(-out[s]+shapeSign-shape)-shapeSign+shape));
-                if (shapeMode==4) // Normalized Rectify
-                  out[s] = -((1+simd::abs(shape))*-out[s]-shape);
-                out[s] *= 5.f;
-                break;
-              case 5: // morph square <--> saw <--> even
-                out[s] = (wavePhasor*10.f - 5.f) * simd::ifelse(shape<0.f, 1.f + shape, 1.f); // saw component
-                // square component
-                wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-                wavePhasor = simd::fmod(wavePhasor + simd::ifelse(shape<=0.f, 500.f, 0.f), 1000.f);
-                wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-                out[s] += simd::ifelse(wavePhasor<500.f, 5.f, -5.f) * simd::abs(shape) * simd::ifelse(shape<0.f, 1.f, 0.5f);
-                // sine component
-                wavePhasor = phasor[s] + (phaseIn*params[PHASE_AMT_PARAM].getValue() + params[PHASE_PARAM].getValue()*2.f)*250.f;
-                wavePhasor = simd::fmod(wavePhasor, 1000.f);
-                wavePhasor = simd::ifelse(wavePhasor<0.f, wavePhasor+1000.f, wavePhasor);
-                out[s] += simd::ifelse(shape<0.f, 0.f, sinSimd_1000(wavePhasor) * 3.175 * shape);
-                break;
-              default: // PWM
-                flip = 1.f - (shapeIn*params[SHAPE_AMT_PARAM].getValue()*shpScale + params[SHAPE_PARAM].getValue() + 1.f) * .5f;
-                if (shapeMode==6)
-                  flip = clamp( flip, .03f, .97f );
-                wavePhasor = simd::ifelse(wavePhasor<flip, wavePhasor/flip/2.f, (wavePhasor-flip)/(1.f-flip)/2.f+0.5f);
-                out[s] = wavePhasor * 10.f - 5.f;
-                break;
-            } // end saw shape switch
-        } // end wave switch
-
-        if (s==0 || inputs[LEVEL_INPUT].isPolyphonic()) {
-          levelIn = (o && !disableOver[LEVEL_INPUT]) ? float_4::zero() : inputs[LEVEL_INPUT].getPolyVoltageSimd<float_4>(c);
-          if (procOver[LEVEL_INPUT]){
-            if (o==0) levelIn *= oversample;
-            levelIn = levelUpSample[s].process(levelIn);
-          }
-        } // else preserve prior levelIn value
-        level = bipolar ? levelIn : simd::ifelse(levelIn>0.f, levelIn, 0.f);
-        level = level * params[LEVEL_AMT_PARAM].getValue() * lvlScale + params[LEVEL_PARAM].getValue();
-        if (clampLevel)
-          level = simd::clamp(level, -1.f, 1.f);
-
-        if (s==0 || inputs[OFFSET_INPUT].isPolyphonic()) {
-          offsetIn = (o && !disableOver[OFFSET_INPUT]) ? float_4::zero() : inputs[OFFSET_INPUT].getPolyVoltageSimd<float_4>(c);
-          if (procOver[OFFSET_INPUT]){
-            if (o==0) offsetIn *= oversample;
-            offsetIn = offsetUpSample[s].process(offsetIn);
-          }
-        } // else preserve prior offsetIn[SIN] value
-        out[s] += clamp(offsetIn*params[OFFSET_AMT_PARAM].getValue() + params[OFFSET_PARAM].getValue()*5.f, -5.f, 5.f);
-        out[s] *= level;  
-
-        // Handle one shots
-        if (once){
-          out[s] = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), out[s]);
+        float_4 shapeRaw = lane(voiceShape, s);
+        float_4 raw = phasor[s] + lane(voicePhase, s);
+        float_4 out = waveShape(raw, shapeRaw, shapeMode, aliasSuppress, basePhaseDelta, lowFreq, denInv);
+        if (blepActive) {
+          auto f = [&](float_4 p) { return waveShape(p, shapeRaw, shapeMode, false, basePhaseDelta, lowFreq, denInv); };
+          float_4 syncMask = sync != 0.f;
+          float_4 delta = PolyBLEP<float_4>::wrapPhase(raw - blepRaw[s] + 500.f) - 500.f;
+          delta = simd::ifelse(syncMask, basePhaseDelta, delta);
+          blepRaw[s] = raw;
+          float_4 pos[4];
+          int cnt = polyBLEPEdges(wave, wave==2 ? shapeMode%3 : shapeMode, shapeRaw, pos);
+          blep[s].addEvents(f, pos, cnt, raw, delta, syncMask, syncD, syncJump, rev != 0.f, revD);
+          out = blep[s].process(out);
         }
-        // Remove DC offset
-        if (params[DC_PARAM].getValue()) {
-          out[s] = outDcBlockFilter[s].process(out[s]);
+
+        float_4 level = lane(voiceLevel, s), offset = lane(voiceOffset, s);
+        if (unison == 1) {
+          out += offset;
+          out *= level;
+          // Handle one shots
+          if (once)
+            out = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), out);
+          outBlock[o][s] = out;
         }
-        // Downsample outputs
-        if (oversample>1) {
-          out[s] = outDownSample[s].process(out[s]);
+        else {
+          // Sum the copies of each voice, which share the offset
+          offset *= unisonOffsetGain;
+          out = (out * laneGain[s] + offset) * level;
+          if (once)
+            out = simd::ifelse(onceActive[s]==float_4::zero(), float_4::zero(), out);
+          for (int i=0; i<4 && c+i<lanes; i++) {
+            int v = laneVoice[c+i];
+            outBlock[o][v>>2][v&3] += out[i];
+          }
         }
       }
     }
+    // Remove DC offset
+    if (params[DC_PARAM].getValue())
+      outDcBlockFilter.processBlock(outBlock, oversample, simdCnt);
+    // Downsample outputs
+    if (oversample>1)
+      outDownSample.processBlock(outBlock, oversample, simdCnt);
     
     // Write output
     for (int s=0, c=0; s<simdCnt; s++, c+=4) {
-      outputs[OUTPUT].setVoltageSimd( out[s], c );
+      outputs[OUTPUT].setVoltageSimd( outBlock[oversample-1][s], c );
     }
     outputs[OUTPUT].setChannels(channels);
   }
@@ -773,9 +887,13 @@ struct VCOUnit : VenomModule {
     json_object_set_new(rootJ, "overParam", json_integer(params[OVER_PARAM].getValue()));
     json_object_set_new(rootJ, "clampLevel", json_boolean(clampLevel));
     json_object_set_new(rootJ, "disableDPW", json_boolean(disableDPW));
+    json_object_set_new(rootJ, "polyBLEP", json_boolean(polyBLEP));
+    json_object_set_new(rootJ, "subSampleSync", json_boolean(subSampleSync));
     json_object_set_new(rootJ, "syncAt0", json_boolean(syncLo<0.f));
     json_object_set_new(rootJ, "shapeModeParam", json_integer(params[SHAPE_MODE_PARAM].getValue()));
     json_object_set_new(rootJ, "lfoAsBPM", json_boolean(lfoAsBPM));
+    json_object_set_new(rootJ, "unisonCopies", json_integer(unisonCopies));
+    json_object_set_new(rootJ, "unisonDetune", json_integer(unisonDetune));
     return rootJ;
   }
 
@@ -806,6 +924,10 @@ struct VCOUnit : VenomModule {
     }
     val = json_object_get(rootJ, "disableDPW");
     disableDPW = val ? json_boolean_value(val) : true;
+    val = json_object_get(rootJ, "polyBLEP");
+    polyBLEP = val ? json_boolean_value(val) : false;
+    val = json_object_get(rootJ, "subSampleSync");
+    subSampleSync = val ? json_boolean_value(val) : false;
     if ((val = json_object_get(rootJ, "lfoAsBPM"))) {
       lfoAsBPM = json_boolean_value(val);
     }
@@ -824,10 +946,17 @@ struct VCOUnit : VenomModule {
     if ((val = json_object_get(rootJ, "shapeModeParam"))) {
       params[SHAPE_MODE_PARAM].setValue(json_integer_value(val));
     }
+    if ((val = json_object_get(rootJ, "unisonCopies"))) {
+      unisonCopies = clamp(static_cast<int>(json_integer_value(val)), 1, 7);
+    }
+    if ((val = json_object_get(rootJ, "unisonDetune"))) {
+      unisonDetune = clamp(static_cast<int>(json_integer_value(val)), 0, 5);
+    }
   }
   
 };
 
+#ifndef VENOM_HEADLESS
 struct VCOUnitWidget : VenomWidget {
   
   struct ModeSwitch : GlowingSvgSwitchLockable {
@@ -1034,15 +1163,32 @@ struct VCOUnitWidget : VenomWidget {
       }
     ));    
     menu->addChild(createBoolPtrMenuItem("Limit level to 100%", "", &module->clampLevel));
-    menu->addChild(createBoolMenuItem("Disable DPW anti-alias", "",
-      [=]() {
-        return module->disableDPW;
-      },
-      [=](bool val) {
-        module->disableDPW = val;
+    menu->addChild(createIndexSubmenuItem(
+      "Audio anti-alias method",
+      {"Oversampling only", "DPW", "PolyBLEP"},
+      [=]() {return module->polyBLEP ? 2 : module->disableDPW ? 0 : 1;},
+      [=](int val) {
+        module->polyBLEP = (val == 2);
+        module->disableDPW = (val == 0);
         module->setMode(true);
       }
-    ));    
+    ));
+    menu->addChild(createSubmenuItem("Unison", "",
+      [=](Menu* menu) {
+        std::vector<std::string> copies = {"Off"};
+        for (int i=2; i<=7; i++)
+          copies.push_back(VCOUnit::maxUnisonVoices(i) < 16 ? string::f("%d (max %d voices)", i, VCOUnit::maxUnisonVoices(i)) : std::to_string(i));
+        menu->addChild(createIndexSubmenuItem(
+          "Copies per voice",
+          copies,
+          [=]() {return module->unisonCopies - 1;},
+          [=](int val) {module->unisonCopies = val + 1;}
+        ));
+        menu->addChild(createIndexPtrSubmenuItem("Detune", {"5 cents", "10 cents", "15 cents", "20 cents", "30 cents", "50 cents"}, &module->unisonDetune));
+        if (module->unisonCopies > 1 && module->inputChannels() > VCOUnit::maxUnisonVoices(module->unisonCopies))
+          menu->addChild(createMenuLabel(string::f("Only the first %d of %d input voices are played", VCOUnit::maxUnisonVoices(module->unisonCopies), module->inputChannels())));
+      }
+    ));
     menu->addChild(createIndexSubmenuItem(
       "Sync trigger threshold",
       {"High 2V, Low 0.2V", "High 0V, Low -2V"},
@@ -1052,6 +1198,13 @@ struct VCOUnitWidget : VenomWidget {
         module->syncLo = val ? -2.f : 0.2f;
       }
     ));
+    menu->addChild(createBoolMenuItem("Sub-sample sync and reverse timing", "",
+      [=]() {return module->subSampleSync;},
+      [=](bool val) {
+        module->subSampleSync = val;
+        module->setMode(true);
+      }
+    ));
     menu->addChild(createIndexSubmenuItem(
       "Audio mode default oversample",
       {"Off","x2","x4","x8","x16","x32"},
@@ -1062,6 +1215,9 @@ struct VCOUnitWidget : VenomWidget {
   }
 
 };
+#endif
 
 }
-Model* modelVenomVCOUnit = createModel<Venom::VCOUnit, Venom::VCOUnitWidget>("VCOUnit");
+#ifndef VENOM_HEADLESS
+Model* modelVenomVCOUnit = Venom::createVenomModel<Venom::VCOUnit, Venom::VCOUnitWidget>("VCOUnit");
+#endif
@@ -1,4 +1,5 @@
 #include "Venom.hpp"
+#include "Filter.hpp"
 
 namespace Venom {
 
@@ -6,6 +7,27 @@ static std::string venomSettingsFileName = asset::user("Venom.json");
 
 int defaultTheme = 0;
 int defaultDarkTheme = 1;
+CpuGovernor cpuGovernor;
+int simdLevel = SIMD_SSE;
+
+void initSimdDispatch(){
+#ifdef VENOM_SIMD_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    simdLevel = __builtin_cpu_supports("avx512f") ? SIMD_AVX512 : SIMD_AVX2;
+#endif
+}
+
+const char* simdLevelName(){
+  static const char* names[] = {"SSE", "AVX2", "AVX-512"};
+  return names[simdLevel];
+}
+
+void refillFilterArenas(){
+  std::lock_guard<std::mutex> lock(filterArenaMutex());
+  for (void (*reserve)() : filterArenaReservers())
+    reserve();
+}
 
 void readDefaultThemes(){
   FILE *file = fopen(venomSettingsFileName.c_str(), "r");
@@ -18,6 +40,23 @@ void readDefaultThemes(){
     jsonVal = json_object_get(rootJ, "defaultDarkTheme");
     if (jsonVal)
       defaultDarkTheme = json_integer_value(jsonVal);
+    jsonVal = json_object_get(rootJ, "cpuGovernor");
+    if (jsonVal)
+      cpuGovernor.enabled = json_boolean_value(jsonVal);
+    jsonVal = json_object_get(rootJ, "cpuGovernorBudget");
+    if (jsonVal)
+      cpuGovernor.budget = clamp(static_cast<int>(json_integer_value(jsonVal)), 0, static_cast<int>(CPU_GOVERNOR_BUDGETS.size()) - 1);
+    jsonVal = json_object_get(rootJ, "cpuGovernorLimits");
+    if (jsonVal) {
+      const char* slug;
+      json_t* limJ;
+      json_object_foreach(jsonVal, slug, limJ) {
+        cpuGovernor.limits[slug] = std::make_pair(
+          static_cast<int>(json_integer_value(json_array_get(limJ, 0))),
+          static_cast<int>(json_integer_value(json_array_get(limJ, 1)))
+        );
+      }
+    }
     fclose(file);
     json_decref(rootJ);
   }
@@ -29,6 +68,16 @@ void writeDefaultThemes(){
     json_t *rootJ = json_object();
     json_object_set_new(rootJ, "defaultTheme", json_integer(defaultTheme));
     json_object_set_new(rootJ, "defaultDarkTheme", json_integer(defaultDarkTheme));
+    json_object_set_new(rootJ, "cpuGovernor", json_boolean(cpuGovernor.enabled));
+    json_object_set_new(rootJ, "cpuGovernorBudget", json_integer(cpuGovernor.budget));
+    json_t* limitsJ = json_object();
+    for (auto& lim : cpuGovernor.limits) {
+      json_t* limJ = json_array();
+      json_array_append_new(limJ, json_integer(lim.second.first));
+      json_array_append_new(limJ, json_integer(lim.second.second));
+      json_object_set_new(limitsJ, lim.first.c_str(), limJ);
+    }
+    json_object_set_new(rootJ, "cpuGovernorLimits", limitsJ);
     json_dumpf(rootJ, file, JSON_INDENT(2) | JSON_REAL_PRECISION(9));
     fclose(file);
     json_decref(rootJ);
@@ -57,4 +106,240 @@ int getDefaultDarkTheme(){
   return defaultDarkTheme;
 }
 
-}
\ No newline at end of file
+void setCpuGovernorEnabled(bool val){
+  if (cpuGovernor.enabled != val){
+    cpuGovernor.enabled = val;
+    cpuGovernor.reduction = 0;
+    cpuGovernor.windowStart = -1;
+    writeDefaultThemes();
+  }
+}
+
+void setCpuGovernorBudget(int val){
+  if (cpuGovernor.budget != val){
+    cpuGovernor.budget = val;
+    writeDefaultThemes();
+  }
+}
+
+std::pair<int, int> CpuGovernor::getLimits(const std::string& slug){
+  std::lock_guard<std::mutex> lock(limitsMutex);
+  auto it = limits.find(slug);
+  return it == limits.end() ? std::make_pair(1, 32) : it->second;
+}
+
+void CpuGovernor::setLimits(const std::string& slug, std::pair<int, int> lim){
+  {
+    std::lock_guard<std::mutex> lock(limitsMutex);
+    limits[slug] = lim;
+  }
+  limitsVersion++;
+  writeDefaultThemes();
+}
+
+// Called by each timed process() call. The first call after the 100 ms window has elapsed claims the window,
+// computes the load, and adjusts the oversampling reduction.
+void CpuGovernor::step(const Module::ProcessArgs& args){
+  int64_t start = windowStart.load(std::memory_order_relaxed);
+  if (start < 0 || args.frame < start) {
+    if (windowStart.compare_exchange_strong(start, args.frame))
+      busyNanos = 0;
+    return;
+  }
+  int64_t frames = args.frame - start;
+  if (frames < args.sampleRate * 0.1f || !windowStart.compare_exchange_strong(start, args.frame))
+    return;
+  float pct = busyNanos.exchange(0) * args.sampleRate / (frames * 1e7f);
+  load = pct;
+  float limit = CPU_GOVERNOR_BUDGETS[budget];
+  int red = reduction.load();
+  if (pct > limit) {
+    if (red < MAX_REDUCTION)
+      reduction = red + 1;
+    hold = 10;
+  }
+  else if (hold > 0)
+    hold--;
+  // Restoring an octave roughly doubles the load, so leave headroom before stepping back up
+  else if (red > 0 && pct < limit * 0.4f) {
+    reduction = red - 1;
+    hold = 10;
+  }
+}
+
+// Idle sleep windows in seconds, indexed by VenomModule::quiescence - 1
+static const float quiescenceWindows[] {0.f, 0.05f, 0.2f, 1.f};
+// Inputs may drift by this much and outputs may move by this much without disturbing quiescence
+static const float QUIESCENT_INPUT_THRESHOLD = 1e-6f;
+static const float QUIESCENT_OUTPUT_THRESHOLD = 1e-3f;
+
+// Snapshots store each port as its channel count followed by PORT_MAX_CHANNELS voltages, so they are allocated
+// once and then overwritten in place
+static const size_t QUIESCENT_PORT_STRIDE = PORT_MAX_CHANNELS + 1;
+
+bool VenomModule::quiescenceInputChanged(){
+  if (quiescentIn.empty())
+    return true;
+  const float* snap = quiescentIn.data();
+  for (int i=0; i<getNumInputs(); i++, snap+=QUIESCENT_PORT_STRIDE){
+    int channels = inputs[i].getChannels();
+    if (snap[0] != channels)
+      return true;
+    for (int c=0; c<channels; c++){
+      if (std::fabs(inputs[i].getVoltage(c) - snap[c+1]) > QUIESCENT_INPUT_THRESHOLD)
+        return true;
+    }
+  }
+  for (int i=0; i<getNumParams(); i++){
+    if (params[i].getValue() != snap[i])
+      return true;
+  }
+  return false;
+}
+
+bool VenomModule::quiescenceOutputSettled(){
+  const float* snap = quiescentOut.data();
+  for (int i=0; i<getNumOutputs(); i++, snap+=QUIESCENT_PORT_STRIDE){
+    int channels = outputs[i].getChannels();
+    if (snap[0] != channels)
+      return false;
+    for (int c=0; c<channels; c++){
+      if (std::fabs(outputs[i].getVoltage(c) - snap[c+1]) > QUIESCENT_OUTPUT_THRESHOLD)
+        return false;
+    }
+  }
+  return true;
+}
+
+void VenomModule::updateQuiescence(float sampleRate){
+  if (quiescentCount){
+    if (!quiescenceInputChanged() && quiescenceOutputSettled()){
+      if (++quiescentCount >= quiescenceWindows[quiescence-1] * sampleRate)
+        quiescent = !extProcNeeded && quiescenceAllowed();
+      return;
+    }
+    // something is still changing, so wait a control rate interval before starting a new window
+    quiescentCount = 0;
+    quiescentWait = CONTROL_RATE_DIVISION - 1;
+  }
+  if (quiescentWait){
+    quiescentWait--;
+    return;
+  }
+  // start a new window
+  quiescentIn.resize(getNumInputs() * QUIESCENT_PORT_STRIDE + getNumParams());
+  quiescentOut.resize(getNumOutputs() * QUIESCENT_PORT_STRIDE);
+  float* snap = quiescentIn.data();
+  for (int i=0; i<getNumInputs(); i++, snap+=QUIESCENT_PORT_STRIDE){
+    int channels = inputs[i].getChannels();
+    snap[0] = channels;
+    for (int c=0; c<channels; c++)
+      snap[c+1] = inputs[i].getVoltage(c);
+  }
+  for (int i=0; i<getNumParams(); i++)
+    snap[i] = params[i].getValue();
+  snap = quiescentOut.data();
+  for (int i=0; i<getNumOutputs(); i++, snap+=QUIESCENT_PORT_STRIDE){
+    int channels = outputs[i].getChannels();
+    snap[0] = channels;
+    for (int c=0; c<channels; c++)
+      snap[c+1] = outputs[i].getVoltage(c);
+  }
+  quiescentCount = 1;
+}
+
+void ProcessMeter::record(float ns, int oversample, int channels){
+  if (resetPending.exchange(false)) {
+    for (int o=0; o<OVER_CNT; o++) {
+      for (int c=0; c<CHAN_CNT; c++) {
+        SharedStats& s = stats[o][c];
+        uint32_t seq = s.seq.load(std::memory_order_relaxed);
+        s.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s.count.store(0, std::memory_order_relaxed);
+        s.mean.store(0.0, std::memory_order_relaxed);
+        s.worst.store(0.f, std::memory_order_relaxed);
+        for (int i=0; i<HIST_CNT; i++)
+          s.hist[i].store(0, std::memory_order_relaxed);
+        s.seq.store(seq + 2, std::memory_order_release);
+      }
+    }
+  }
+  int o = 0;
+  while (o < OVER_CNT-1 && (2 << o) <= oversample)
+    o++;
+  SharedStats& s = stats[o][clamp(channels, 1, CHAN_CNT) - 1];
+  uint64_t count = s.count.load(std::memory_order_relaxed) + 1;
+  // rolling mean over roughly the most recent 4096 calls
+  double mean = s.mean.load(std::memory_order_relaxed);
+  mean += (ns - mean) / std::min(count, (uint64_t)4096);
+  int bin = ns > 16.f ? std::min(int(4.f * std::log2(ns / 16.f)), HIST_CNT-1) : 0;
+  uint32_t seq = s.seq.load(std::memory_order_relaxed);
+  s.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  s.count.store(count, std::memory_order_relaxed);
+  s.mean.store(mean, std::memory_order_relaxed);
+  if (ns > s.worst.load(std::memory_order_relaxed))
+    s.worst.store(ns, std::memory_order_relaxed);
+  s.hist[bin].store(s.hist[bin].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  s.seq.store(seq + 2, std::memory_order_release);
+}
+
+// Copies a group, retrying if record() updated it during the copy
+ProcessMeter::Stats ProcessMeter::snapshot(int over, int chan){
+  const SharedStats& s = stats[over][chan];
+  Stats copy;
+  uint32_t seq;
+  do {
+    while ((seq = s.seq.load(std::memory_order_acquire)) & 1) {}
+    copy.count = s.count.load(std::memory_order_relaxed);
+    copy.mean = s.mean.load(std::memory_order_relaxed);
+    copy.worst = s.worst.load(std::memory_order_relaxed);
+    for (int i=0; i<HIST_CNT; i++)
+      copy.hist[i] = s.hist[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while (s.seq.load(std::memory_order_relaxed) != seq);
+  return copy;
+}
+
+float ProcessMeter::percentile(const Stats& s, float pct){
+  uint64_t limit = std::ceil(s.count * pct), sum = 0;
+  for (int i=0; i<HIST_CNT; i++) {
+    sum += s.hist[i];
+    if (sum >= limit)
+      return std::min(16.f * std::exp2((i + 1) / 4.f), s.worst);
+  }
+  return s.worst;
+}
+
+static std::string timeText(float ns){
+  return ns < 1000.f ? string::f("%.0f ns", ns) : string::f("%.2f us", ns / 1000.f);
+}
+
+std::string ProcessMeter::statsText(int over, int chan){
+  Stats s = snapshot(over, chan);
+  return string::f("x%d, %d ch: mean %s, p99 %s, worst %s",
+    1 << over, chan + 1, timeText(s.mean).c_str(), timeText(percentile(s, 0.99f)).c_str(), timeText(s.worst).c_str());
+}
+
+json_t* ProcessMeter::statsJson(){
+  json_t* arrayJ = json_array();
+  for (int o=0; o<OVER_CNT; o++) {
+    for (int c=0; c<CHAN_CNT; c++) {
+      Stats s = snapshot(o, c);
+      if (!s.count)
+        continue;
+      json_t* statJ = json_object();
+      json_object_set_new(statJ, "oversample", json_integer(1 << o));
+      json_object_set_new(statJ, "channels", json_integer(c + 1));
+      json_object_set_new(statJ, "calls", json_integer(s.count));
+      json_object_set_new(statJ, "meanNs", json_real(s.mean));
+      json_object_set_new(statJ, "p99Ns", json_real(percentile(s, 0.99f)));
+      json_object_set_new(statJ, "worstNs", json_real(s.worst));
+      json_array_append_new(arrayJ, statJ);
+    }
+  }
+  return arrayJ;
+}
+
+}
@@ -1,5 +1,11 @@
 #pragma once
 #include "plugin.hpp"
+#include "Dispatch.hpp"
+#include "Noise.hpp"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
 
 namespace Venom {
 
@@ -27,6 +33,39 @@ int getDefaultDarkTheme();
 void setDefaultTheme(int theme);
 void setDefaultDarkTheme(int theme);
 
+// Plugin wide CPU governor, configured from the context menu of any oversampling Venom module and saved in Venom.json.
+// While enabled, 1 of every SAMPLE_INTERVAL process() calls of each Venom module is timed, and every 100 ms the
+// estimated total Venom CPU load is compared with the budget. The governor then steps the oversample rate of every
+// governed module down one octave while the load exceeds the budget, and back up one octave once the load has
+// stayed well below the budget for a second. Each module type has its own floor and ceiling oversample rates.
+struct CpuGovernor {
+  static const int SAMPLE_INTERVAL = 32;
+  static const int MAX_REDUCTION = 5;
+  bool enabled = false;
+  int budget = 2; // index into CPU_GOVERNOR_BUDGETS
+  std::map<std::string, std::pair<int, int>> limits; // floor and ceiling oversample rates by module slug
+  std::mutex limitsMutex;
+  std::atomic<int> limitsVersion{0};
+  std::atomic<int> reduction{0}; // octaves of oversampling removed
+  std::atomic<int64_t> busyNanos{0};
+  std::atomic<int64_t> windowStart{-1};
+  std::atomic<float> load{0.f}; // percent of one core during the last window
+  int hold = 0;
+
+  void step(const Module::ProcessArgs& args);
+  std::pair<int, int> getLimits(const std::string& slug);
+  void setLimits(const std::string& slug, std::pair<int, int> lim);
+};
+static const std::vector<int> CPU_GOVERNOR_BUDGETS = {10, 25, 50, 75, 100};
+extern CpuGovernor cpuGovernor;
+void setCpuGovernorEnabled(bool val);
+void setCpuGovernorBudget(int val);
+
+// Tops up the spare slots of every FilterArena (Filter.hpp). Called by each module widget on the UI thread.
+void refillFilterArenas();
+
+// The UI is left out when VENOM_HEADLESS is defined, as it is by the headless DSP tests in test/
+#ifndef VENOM_HEADLESS
 // MenuTextField extracted from pachde1 components.hpp
 // Textfield as menu item, originally adapted from SubmarineFree
 struct MenuTextField : ui::TextField {
@@ -62,6 +101,84 @@ struct MenuTextField : ui::TextField {
       TextField::onSelectKey(e);
   }
 };
+#endif
+
+// Opt-in process() timing statistics, allocated when timing is first enabled from the context menu.
+// Calls are grouped by oversample factor (x1 through x32) and active channel count (1 through 16).
+// Each group tracks a rolling mean, the worst case, and a log spaced histogram used to estimate p99.
+// record() on the audio thread is the only writer, and publishes every update of a group with a sequence lock,
+// so snapshot() on the UI thread gets a consistent copy without ever blocking the audio thread.
+struct ProcessMeter {
+  static const int OVER_CNT = 6;
+  static const int CHAN_CNT = 16;
+  static const int HIST_CNT = 64; // 4 bins per octave starting at 16 ns
+  struct Stats {
+    uint64_t count = 0;
+    double mean = 0.0;
+    float worst = 0.f;
+    uint64_t hist[HIST_CNT] = {};
+  };
+  // Stats of one group as shared between the threads; seq is odd while record() is updating the group
+  struct SharedStats {
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint64_t> count{0};
+    std::atomic<double> mean{0.0};
+    std::atomic<float> worst{0.f};
+    std::atomic<uint64_t> hist[HIST_CNT];
+    SharedStats() {
+      for (int i=0; i<HIST_CNT; i++)
+        hist[i].store(0, std::memory_order_relaxed);
+    }
+  };
+  SharedStats stats[OVER_CNT][CHAN_CNT];
+  std::atomic<bool> resetPending{false};
+
+  void record(float ns, int oversample, int channels);
+  Stats snapshot(int over, int chan);
+  float percentile(const Stats& s, float pct);
+  std::string statsText(int over, int chan);
+  json_t* statsJson();
+};
+
+// Number of samples between control rate updates of slow parameters and CV derived coefficients
+static const int CONTROL_RATE_DIVISION = 16;
+
+// A control rate coefficient that is linearly interpolated per sample.
+// Each set() starts a ramp from the current value that reaches the new target after steps calls to process().
+// The first set() jumps straight to the target.
+template <typename T>
+struct ControlRamp {
+  T value{}, target{}, delta{};
+  int remaining = -1;
+
+  void set(T newTarget, int steps) {
+    target = newTarget;
+    if (remaining < 0 || steps <= 1) {
+      value = target;
+      delta = T(0.f);
+      remaining = 0;
+    } else {
+      delta = (target - value) / static_cast<float>(steps);
+      remaining = steps;
+    }
+  }
+
+  // True until the first set()
+  bool unset() const {
+    return remaining < 0;
+  }
+
+  T process() {
+    if (remaining > 1) {
+      value += delta;
+      remaining--;
+    } else if (remaining == 1) {
+      value = target;
+      remaining = 0;
+    }
+    return value;
+  }
+};
 
 struct VenomModule : Module {
 
@@ -71,17 +188,124 @@ struct VenomModule : Module {
   int prevTheme = -1;
   int prevDarkTheme = -1;
   int oversampleStages = 0; // default to 0 = unused
+  bool oversampleFIR = false; // true if the Linear phase FIR filter quality is supported
   virtual void setOversample(){};
+  // Set by the UI thread to have the audio thread call setOversample(), which may release filter state
+  std::atomic<bool> oversampleChanged{false};
   bool drawn = false;
   bool paramsInitialized = false;
   bool extProcNeeded = true;
   std::string moduleName = "";
+  std::atomic<bool> processMetering{false};
+  std::unique_ptr<ProcessMeter> processMeter;
+
+  void setProcessMetering(bool val) {
+    if (val && !processMeter)
+      processMeter.reset(new ProcessMeter);
+    processMetering.store(val, std::memory_order_release);
+  }
+
+  void recordProcessTime(std::chrono::steady_clock::time_point start, int oversample) {
+    float ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count();
+    int channels = 1;
+    for (int i=0; i<getNumInputs(); i++)
+      channels = std::max(channels, inputs[i].getChannels());
+    for (int i=0; i<getNumOutputs(); i++)
+      channels = std::max(channels, outputs[i].getChannels());
+    processMeter->record(ns, oversample, channels);
+  }
+
+  // CPU governor support: modules call governedOversample() with the oversample rate selected by their
+  // OVER parameter, and use the result in its place.
+  bool governed = false;
+  int governorCount = 0;
+  int governorLimitsVersion = -1;
+  std::pair<int, int> governorLimits{1, 32};
+
+  int governedOversample(int oversample) {
+    governed = true;
+    if (!cpuGovernor.enabled)
+      return oversample;
+    if (governorLimitsVersion != cpuGovernor.limitsVersion.load(std::memory_order_acquire)) {
+      governorLimitsVersion = cpuGovernor.limitsVersion.load(std::memory_order_acquire);
+      governorLimits = cpuGovernor.getLimits(model ? model->slug : "");
+    }
+    int over = std::max(oversample >> cpuGovernor.reduction.load(std::memory_order_relaxed), 1);
+    over = std::max(over, std::min(governorLimits.first, oversample));
+    return std::min(over, governorLimits.second);
+  }
+
+  // For OVER parameters that offer only some rates: the governed rate rounded down to the nearest of the
+  // cnt ascending rates, but never below the lowest rate the module supports.
+  int governedOversample(int oversample, const int* rates, int cnt) {
+    int over = governedOversample(oversample), i = cnt-1;
+    while (i && rates[i] > over)
+      i--;
+    return rates[i];
+  }
+
+  // Control rate support: controlRateTick() is called once per process() and returns true every
+  // CONTROL_RATE_DIVISION samples, when slow coefficients should be recomputed and ramped with ControlRamp.
+  // Inputs declared audio rate force per sample evaluation of the coefficients that depend on them while connected.
+  int controlRateCount = 0;
+
+  bool controlRateTick() {
+    if (controlRateCount) {
+      controlRateCount--;
+      return false;
+    }
+    controlRateCount = CONTROL_RATE_DIVISION - 1;
+    return true;
+  }
+
+  void configAudioRateInput(int inputId) {
+    inputExtensions[inputId].audioRate = true;
+  }
+
+  bool isAudioRateInput(int inputId) {
+    return inputExtensions[inputId].audioRate && inputs[inputId].isConnected();
+  }
+
+  // Idle sleep (quiescence): modules that support it set quiescence to 1 (Off), and the user may select a window.
+  // Once every input and parameter has been unchanged for the window, and every output has settled,
+  // the module's process() is skipped and the settled outputs are held until an input or parameter changes.
+  // Any filter or oversampler state has settled as well, so waking does not click.
+  int quiescence = 0; // default to 0 = unsupported
+  bool quiescent = false;
+  int quiescentCount = 0,
+      quiescentWait = 0;
+  std::vector<float> quiescentIn, quiescentOut;
+  virtual bool quiescenceAllowed() {return true;}
+  bool quiescenceInputChanged();
+  bool quiescenceOutputSettled();
+  void updateQuiescence(float sampleRate);
+
+  void wakeQuiescence() {
+    quiescent = false;
+    quiescentCount = 0;
+    quiescentWait = 0;
+  }
+
+  // Noise: modules that draw from the noise generator set noiseUsed, which adds the Fixed random seed menu option.
+  // A fixed seed is saved with the patch, and the noise restarts from it every time the patch loads.
+  SimdNoise noise;
+  bool noiseUsed = false,
+       fixedSeed = false;
+  std::atomic<uint64_t> noiseSeed{0};
+  // Set by seedNoise() from any thread to have the audio thread reseed the noise generator
+  std::atomic<bool> seedChanged{false};
+
+  void seedNoise(uint64_t seed) {
+    noiseSeed = seed;
+    seedChanged = true;
+  }
 
   std::string currentThemeStr(bool dark=false){
     return modThemes[currentTheme==0 ? (dark ? defaultDarkTheme : defaultTheme)+1 : currentTheme];
   }
 
   bool lockableParams = false;
+#ifndef VENOM_HEADLESS
   void appendParamMenu(Menu* menu, int parmId) {
     ParamQuantity* q = paramQuantities[parmId];
     ParamExtension* e = &paramExtensions[parmId];
@@ -187,6 +411,7 @@ struct VenomModule : Module {
       ));
     }  
   }
+#endif
 
   struct ParamExtension {
     bool locked;
@@ -211,11 +436,13 @@ struct VenomModule : Module {
   struct PortExtension {
     int nameLink;
     int portNameLink;
+    bool audioRate;
     std::string factoryName;
     PortExtension(){
       factoryName = "";
       nameLink = -1;
       portNameLink = -1;
+      audioRate = false;
     }
   };
 
@@ -257,6 +484,7 @@ struct VenomModule : Module {
       inputExtensions.push_back(PortExtension());
     for (int i=0; i<outCnt; i++)
       outputExtensions.push_back(PortExtension());
+    seedNoise(random::u64());
   }
   
   // Hack workaround for VCV bug when deleting a module - failure to trigger onExpanderChange()
@@ -299,10 +527,15 @@ struct VenomModule : Module {
 
   void process(const ProcessArgs& args) override {
     initializeParams();
+    if (oversampleChanged.exchange(false))
+      setOversample();
+    if (seedChanged.exchange(false))
+      noise.seed(noiseSeed);
   }
   
   void processBypass(const ProcessArgs& args) override {
     initializeParams();
+    wakeQuiescence();
     Module::processBypass(args);
   }
   
@@ -336,6 +569,10 @@ struct VenomModule : Module {
     json_object_set_new(rootJ, "currentTheme", json_integer(currentTheme));
     if (oversampleStages)
       json_object_set_new(rootJ, "oversampleStages", json_integer(oversampleStages));
+    if (quiescence)
+      json_object_set_new(rootJ, "quiescence", json_integer(quiescence));
+    if (fixedSeed)
+      json_object_set_new(rootJ, "noiseSeed", json_integer(static_cast<json_int_t>(noiseSeed)));
     return rootJ;
   }
 
@@ -395,10 +632,18 @@ struct VenomModule : Module {
       val = json_object_get(rootJ, "oversampleStages");
       oversampleStages = val ? json_integer_value(val) : 3;
     }
+    if (quiescence && (val = json_object_get(rootJ, "quiescence")))
+      quiescence = json_integer_value(val);
+    if (noiseUsed && (val = json_object_get(rootJ, "noiseSeed"))) {
+      fixedSeed = true;
+      seedNoise(static_cast<uint64_t>(json_integer_value(val)));
+    }
+    wakeQuiescence();
   }
 
 };
 
+#ifndef VENOM_HEADLESS
 struct VenomWidget : ModuleWidget {
   std::string moduleName;
   void draw(const DrawArgs & args) override {
@@ -420,19 +665,153 @@ struct VenomWidget : ModuleWidget {
     VenomModule* module = static_cast<VenomModule*>(this->module);
     
     if (module->oversampleStages){
+      std::vector<std::string> qualities = {"6th order", "8th order", "10th order"};
+      if (module->oversampleFIR)
+        qualities.push_back("Linear phase FIR");
       menu->addChild(new MenuSeparator);
       menu->addChild(createIndexSubmenuItem("Oversample filter quality",
-        {"6th order", "8th order", "10th order"},
+        qualities,
         [=]() {
           return module->oversampleStages - 3;
         },
         [=](int val) {
           module->oversampleStages = val + 3;
-          module->setOversample();
+          module->oversampleChanged = true;
         }
       ));
     }
 
+    if (module->quiescence){
+      menu->addChild(new MenuSeparator);
+      menu->addChild(createIndexSubmenuItem("Idle sleep when settled",
+        {"Off", "After 50 ms", "After 200 ms", "After 1 second"},
+        [=]() {
+          return module->quiescence - 1;
+        },
+        [=](int val) {
+          module->quiescence = val + 1;
+          module->wakeQuiescence();
+        }
+      ));
+    }
+
+    if (module->noiseUsed){
+      menu->addChild(new MenuSeparator);
+      menu->addChild(createBoolMenuItem("Fixed random seed", "",
+        [=]() {
+          return module->fixedSeed;
+        },
+        [=](bool val) {
+          module->fixedSeed = val;
+          if (val)
+            module->seedNoise(random::u64());
+        }
+      ));
+    }
+
+    if (module->governed){
+      menu->addChild(new MenuSeparator);
+      menu->addChild(createSubmenuItem("CPU governor", cpuGovernor.enabled ? "On" : "",
+        [=](Menu* menu){
+          menu->addChild(createBoolMenuItem("Enable CPU governor (all Venom modules)", "",
+            [=]() {
+              return cpuGovernor.enabled;
+            },
+            [=](bool val) {
+              setCpuGovernorEnabled(val);
+            }
+          ));
+          std::vector<std::string> budgetLabels;
+          for (int b : CPU_GOVERNOR_BUDGETS)
+            budgetLabels.push_back(std::to_string(b) + "% of one core");
+          menu->addChild(createIndexSubmenuItem("Venom CPU budget", budgetLabels,
+            [=]() {
+              return cpuGovernor.budget;
+            },
+            [=](int val) {
+              setCpuGovernorBudget(val);
+            }
+          ));
+          if (cpuGovernor.enabled){
+            int reduction = cpuGovernor.reduction.load();
+            menu->addChild(createMenuLabel(string::f("Venom CPU load %.1f%%, oversampling reduced %d octave%s",
+              cpuGovernor.load.load(), reduction, reduction == 1 ? "" : "s")));
+          }
+          menu->addChild(new MenuSeparator);
+          std::string slug = module->model->slug;
+          std::vector<std::string> overLabels = {"x1", "x2", "x4", "x8", "x16", "x32"};
+          menu->addChild(createIndexSubmenuItem(module->model->name + " oversample floor", overLabels,
+            [=]() {
+              return static_cast<int>(std::log2(cpuGovernor.getLimits(slug).first));
+            },
+            [=](int val) {
+              std::pair<int, int> lim = cpuGovernor.getLimits(slug);
+              lim.first = 1 << val;
+              lim.second = std::max(lim.second, lim.first);
+              cpuGovernor.setLimits(slug, lim);
+            }
+          ));
+          menu->addChild(createIndexSubmenuItem(module->model->name + " oversample ceiling", overLabels,
+            [=]() {
+              return static_cast<int>(std::log2(cpuGovernor.getLimits(slug).second));
+            },
+            [=](int val) {
+              std::pair<int, int> lim = cpuGovernor.getLimits(slug);
+              lim.second = 1 << val;
+              lim.first = std::min(lim.first, lim.second);
+              cpuGovernor.setLimits(slug, lim);
+            }
+          ));
+        }
+      ));
+    }
+
+    menu->addChild(new MenuSeparator);
+    menu->addChild(createSubmenuItem("Process timing", module->processMetering ? "On" : "",
+      [=](Menu *menu){
+        menu->addChild(createBoolMenuItem("Enable process timing", "",
+          [=]() {
+            return module->processMetering.load();
+          },
+          [=](bool val){
+            module->setProcessMetering(val);
+          }
+        ));
+        menu->addChild(createMenuLabel(string::f("Block kernels use %s", simdLevelName())));
+        if (!module->processMeter)
+          return;
+        menu->addChild(createMenuItem("Reset timing statistics", "",
+          [=]() {
+            module->processMeter->resetPending = true;
+          }
+        ));
+        menu->addChild(createMenuItem("Copy timing statistics as JSON", "",
+          [=]() {
+            json_t* rootJ = json_object();
+            json_object_set_new(rootJ, "module", json_string(module->moduleName.c_str()));
+            json_object_set_new(rootJ, "id", json_integer(module->id));
+            json_object_set_new(rootJ, "stats", module->processMeter->statsJson());
+            char* text = json_dumps(rootJ, JSON_INDENT(2) | JSON_REAL_PRECISION(6));
+            glfwSetClipboardString(APP->window->win, text);
+            free(text);
+            json_decref(rootJ);
+          }
+        ));
+        menu->addChild(new MenuSeparator);
+        int cnt = 0;
+        for (int o=0; o<ProcessMeter::OVER_CNT; o++) {
+          for (int c=0; c<ProcessMeter::CHAN_CNT; c++) {
+            if (module->processMeter->stats[o][c].count.load(std::memory_order_relaxed)) {
+              menu->addChild(createMenuLabel(module->processMeter->statsText(o, c)));
+              cnt++;
+            }
+          }
+        }
+        if (!cnt)
+          menu->addChild(createMenuLabel("No calls recorded"));
+      }
+    ));
+
     if (module->lockableParams){
       menu->addChild(new MenuSeparator);
       menu->addChild(createMenuItem("Lock all parameters", "",
@@ -500,6 +879,7 @@ struct VenomWidget : ModuleWidget {
           asset::plugin( pluginInstance, faceplatePath( moduleName, module->currentThemeStr(true)))
         ));
       }
+      refillFilterArenas();
     }
     Widget::step();
   }
@@ -518,6 +898,56 @@ struct VenomWidget : ModuleWidget {
   }  
 
 };
+#endif
+
+// Wraps the complete process() of a module so that the opt-in VenomModule timing covers the derived
+// module's work, not just the VenomModule::process() call at its start.
+// It also skips process() entirely while the module is asleep due to quiescence.
+template <class TModule>
+struct VenomMeteredModule : TModule {
+  void process(const Module::ProcessArgs& args) override {
+    if (this->quiescent) {
+      if (!this->quiescenceInputChanged())
+        return;
+      this->wakeQuiescence();
+    }
+    bool governorSample = cpuGovernor.enabled && ++this->governorCount >= CpuGovernor::SAMPLE_INTERVAL;
+    if (!governorSample && !this->processMetering.load(std::memory_order_acquire)) {
+      TModule::process(args);
+    } else {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      TModule::process(args);
+      if (governorSample) {
+        this->governorCount = 0;
+        cpuGovernor.busyNanos.fetch_add(CpuGovernor::SAMPLE_INTERVAL *
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+          std::memory_order_relaxed);
+        cpuGovernor.step(args);
+      }
+      if (this->processMetering.load(std::memory_order_acquire))
+        this->recordProcessTime(start, meterOversample(this, 0));
+    }
+    if (this->quiescence > 1)
+      this->updateQuiescence(args.sampleRate);
+  }
+
+  // Modules that oversample keep the current factor in an int oversample member
+  template <class T>
+  static auto meterOversample(T* m, int) -> decltype(int(m->oversample)) {
+    return m->oversample;
+  }
+  template <class T>
+  static int meterOversample(T* m, long) {
+    return 1;
+  }
+};
+
+#ifndef VENOM_HEADLESS
+template <class TModule, class TModuleWidget>
+Model* createVenomModel(std::string slug) {
+  return createModel<VenomMeteredModule<TModule>, TModuleWidget>(slug);
+}
+#endif
 
 struct FixedSwitchQuantity : SwitchQuantity {
   std::string getDisplayValueString() override {
@@ -525,6 +955,7 @@ struct FixedSwitchQuantity : SwitchQuantity {
   }
 };
 
+#ifndef VENOM_HEADLESS
 template <typename TBase>
 struct RotarySwitch : TBase {
   RotarySwitch() {
@@ -865,6 +1296,7 @@ struct GlowingTinyButtonLatchLockable : GlowingTinyButtonLockable {
     latch = true;
   }
 };
+#endif
  
 struct ShapeQuantity : ParamQuantity {
   std::string getUnit() override {
@@ -873,6 +1305,7 @@ struct ShapeQuantity : ParamQuantity {
   }  
 };
 
+#ifndef VENOM_HEADLESS
 struct PolyPJ301MPort : app::SvgPort {
   PolyPJ301MPort() {
     setSvg(Svg::load(asset::plugin( pluginInstance, "res/PJ301M-poly.svg")));
@@ -897,5 +1330,6 @@ struct PolyPort : VenomPort {
     setSvg(Svg::load(asset::plugin( pluginInstance, "res/PJ301M-poly.svg")));
   }
 };
+#endif
 
 }
\ No newline at end of file
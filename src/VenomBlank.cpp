@@ -23,4 +23,4 @@ struct VenomBlankWidget : VenomWidget {
 
 }
 
-Model* modelVenomBlank = createModel<Venom::VenomBlank, Venom::VenomBlankWidget>("VenomBlank");
+Model* modelVenomBlank = Venom::createVenomModel<Venom::VenomBlank, Venom::VenomBlankWidget>("VenomBlank");
@@ -4,10 +4,29 @@
 #include "Venom.hpp"
 #include "Filter.hpp"
 #include "math.hpp"
+#include "ADAA.hpp"
 //#include <float.h>
 
 namespace Venom {
 
+// Folds the first lanes of each oversample step of a block in place, each with its own fold gain,
+// followed by the soft clip. Each step holds 16 lanes.
+VENOM_KERNEL void foldBlockKernel(float* x, const float* gain, int steps, int lanes, int stages, float limit) {
+  for (int o=0; o<steps; o++, x+=16, gain+=16) {
+    for (int s=0; s<stages; s++) {
+      for (int l=0; l<lanes; l++) {
+        float y = x[l] * gain[l];
+        y = y < -5.f ? -5.f : y > 5.f ? 5.f : y;
+        x[l] = y * 2.f - x[l];
+      }
+    }
+    for (int l=0; l<lanes; l++)
+      x[l] = softClip(x[l] * limit) / limit;
+  }
+}
+VENOM_DISPATCH(foldBlock, (float* x, const float* gain, int steps, int lanes, int stages, float limit),
+               (x, gain, steps, lanes, stages, limit))
+
 struct WaveFolder : VenomModule {
 
   enum ParamId {
@@ -43,10 +62,26 @@ struct WaveFolder : VenomModule {
   
   int oversample = 0;
   int oversampleValues[6]{1,2,4,8,16,32};
-  OversampleFilter_4 preUpSample[4]{}, stageUpSample[4]{}, biasUpSample[4]{}, upSample[4]{}, downSample[4]{};
+  OversampleFilter_4 preUpSample[4]{}, stageUpSample[4]{}, biasUpSample[4]{}, upSample[4]{};
+  WideOversampleFilter downSample;
+  // Pre fold values and fold gains of each oversample step and SIMD group, folded and downsampled as a block
+  simd::float_4 block[32][4]{}, gainBlock[32][4]{};
   float stageRaw = -1.f;
   simd::float_4 stageParm{};
   bool disableOver[3]{}, bipolar[2]{};
+  int adaa = 0;
+  simd::float_4 adaaIn[2][4]{};
+
+  // The fold stages and soft clip as a waveshaper for antiderivative anti-aliasing
+  struct FoldShaper : ADAASoftClip {
+    float stage;
+    int stages;
+    void linear(ADAAPath& path) const {
+      float g = stage, bp[2]{-5.f / std::fabs(g), 5.f / std::fabs(g)};
+      for (int s=0; s<stages; s++)
+        path.apply([=](float y) {return clamp(y * g, -5.f, 5.f) * 2.f - y;}, bp, g ? 2 : 0);
+    }
+  };
 
 
   WaveFolder() {
@@ -80,18 +115,18 @@ struct WaveFolder : VenomModule {
     configBypass(POLY_INPUT, POLY_OUTPUT);
     
     oversampleStages = 5;
+    oversampleFIR = true;
+    quiescence = 1;
   }
   
   void setOversample() override {
-    if (oversample > 1) {
-      for (int i=0; i<4; i++){
-        preUpSample[i].setOversample(oversample, oversampleStages);
-        stageUpSample[i].setOversample(oversample, oversampleStages);
-        biasUpSample[i].setOversample(oversample, oversampleStages);
-        upSample[i].setOversample(oversample, oversampleStages);
-        downSample[i].setOversample(oversample, oversampleStages);
-      }
+    for (int i=0; i<4; i++){
+      preUpSample[i].setOversample(oversample, oversampleStages);
+      stageUpSample[i].setOversample(oversample, oversampleStages);
+      biasUpSample[i].setOversample(oversample, oversampleStages);
+      upSample[i].setOversample(oversample, oversampleStages);
     }
+    downSample.setOversample(oversample, oversampleStages, true);
   }
 
   void process(const ProcessArgs& args) override {
@@ -99,8 +134,8 @@ struct WaveFolder : VenomModule {
     
     using float_4 = simd::float_4;
     float limit = 10.f / 6.f;
-    if (oversample != oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]) {
-      oversample = oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())];
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())])) {
+      oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]);
       setOversample();
     }
     
@@ -116,13 +151,23 @@ struct WaveFolder : VenomModule {
     bool preOver = inputs[PRE_INPUT].isConnected() && !disableOver[PRE_INPUT] && oversample>1,
          stageOver = inputs[STAGE_INPUT].isConnected() && !disableOver[STAGE_INPUT] && oversample>1,
          biasOver = inputs[BIAS_INPUT].isConnected() && !disableOver[BIAS_INPUT] && oversample>1;
+    // Return the state of unused CV upsamplers to the arena
+    for (int i=0; i<4; i++) {
+      if (!preOver)
+        preUpSample[i].release();
+      if (!stageOver)
+        stageUpSample[i].release();
+      if (!biasOver)
+        biasUpSample[i].release();
+    }
     
     int stages = static_cast<int>(params[STAGES_PARAM].getValue())+2;
     int channels = 1;
     for (int i=0; i<INPUTS_LEN; i++)
       channels = std::max({channels, inputs[i].getChannels()});
+    int simdCnt = (channels+3)/4;
     
-    float_4 in[4]{}, out[4]{}, pre[4]{}, stage[4]{}, bias[4]{};
+    float_4 in[4]{}, pre[4]{}, stage[4]{}, bias[4]{};
     for (int o=0; o<oversample; o++) {
       for (int i=0, c=0; c<channels; i++, c+=4){
         if (!o) {
@@ -152,16 +197,30 @@ struct WaveFolder : VenomModule {
         }
         if (!o || biasOver)
           bias[i] = bias[i] * biasAmt + biasParm;
-        out[i] = (in[i] + bias[i]) * pre[i];
-        for (int s=0; s<stages; s++)
-          out[i] = simd::clamp( out[i] * stage[i], -5.f, 5.f) * 2.f - out[i];
-        out[i] = softClip(out[i]*limit) / limit;
-        if (oversample > 1)
-          out[i] = downSample[i].process(out[i]);
+        float_4 x = (in[i] + bias[i]) * pre[i];
+        if (adaa) {
+          FoldShaper shaper;
+          shaper.gain = limit;
+          shaper.stages = stages;
+          for (int j=0; j<4 && c+j<channels; j++) {
+            shaper.stage = stage[i][j];
+            block[o][i][j] = adaaProcess(shaper, adaa, adaaIn[0][i][j], adaaIn[1][i][j], x[j]);
+          }
+        } else {
+          block[o][i] = x;
+          gainBlock[o][i] = stage[i];
+        }
+        // The input history is kept while ADAA is off, so that turning it on does not click
+        adaaIn[0][i] = adaaIn[1][i];
+        adaaIn[1][i] = x;
       }
     }
+    if (!adaa)
+      foldBlock(reinterpret_cast<float*>(block), reinterpret_cast<float*>(gainBlock), oversample, simdCnt*4, stages, limit);
+    if (oversample > 1)
+      downSample.processBlock(block, oversample, simdCnt);
     for (int i=0, c=0; c<channels; i++, c+=4)
-      outputs[POLY_OUTPUT].setVoltageSimd(out[i], c);
+      outputs[POLY_OUTPUT].setVoltageSimd(block[oversample-1][i], c);
     outputs[POLY_OUTPUT].setChannels(channels);
   }
 
@@ -172,6 +231,7 @@ struct WaveFolder : VenomModule {
     json_object_set_new(rootJ, "stageAmpDisableOver", json_boolean(disableOver[STAGE_INPUT]));
     json_object_set_new(rootJ, "stageAmpBipolar", json_boolean(bipolar[STAGE_INPUT]));
     json_object_set_new(rootJ, "biasDisableOver", json_boolean(disableOver[BIAS_INPUT]));
+    json_object_set_new(rootJ, "adaa", json_integer(adaa));
     return rootJ;
   }
 
@@ -195,10 +255,14 @@ struct WaveFolder : VenomModule {
     if ((val = json_object_get(rootJ, "biasDisableOver"))) {
       disableOver[BIAS_INPUT] = json_boolean_value(val);
     }
+    if ((val = json_object_get(rootJ, "adaa"))) {
+      adaa = clamp(static_cast<int>(json_integer_value(val)), 0, 2);
+    }
   }
 
 };
 
+#ifndef VENOM_HEADLESS
 struct WaveFolderWidget : VenomWidget {
 
   struct StagesSwitch : GlowingSvgSwitchLockable {
@@ -272,6 +336,17 @@ struct WaveFolderWidget : VenomWidget {
     addOutput(createOutputCentered<PolyPort>(Vec(66.f, 335.5f), module, WaveFolder::POLY_OUTPUT));
   }
 
+  void appendContextMenu(Menu* menu) override {
+    WaveFolder* module = static_cast<WaveFolder*>(this->module);
+    menu->addChild(new MenuSeparator);
+    menu->addChild(createIndexPtrSubmenuItem(
+      "Antiderivative anti-aliasing",
+      {"Off", "First order", "Second order"},
+      &module->adaa
+    ));
+    VenomWidget::appendContextMenu(menu);
+  }
+
   void step() override {
     VenomWidget::step();
     if(this->module) {
@@ -291,7 +366,10 @@ struct WaveFolderWidget : VenomWidget {
     }
   }
 };
+#endif
 
 }
 
-Model* modelVenomWaveFolder = createModel<Venom::WaveFolder, Venom::WaveFolderWidget>("WaveFolder");
+#ifndef VENOM_HEADLESS
+Model* modelVenomWaveFolder = Venom::createVenomModel<Venom::WaveFolder, Venom::WaveFolderWidget>("WaveFolder");
+#endif
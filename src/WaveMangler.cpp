@@ -4,6 +4,7 @@
 #include "Venom.hpp"
 #include "Filter.hpp"
 #include "math.hpp"
+#include "ADAA.hpp"
 
 namespace Venom {
 
@@ -55,6 +56,45 @@ struct WaveMangler : VenomModule {
   int oversampleValues[6]{1,2,4,8,16,32};
   OversampleFilter_4 upSample[8][4]{}, downSample[4]{};
   DCBlockFilter_4 dcBlockInFilter[4]{}, dcBlockOutFilter[4]{};
+  int adaa = 0;
+  simd::float_4 adaaIn[2][4]{};
+
+  // The threshold shaping and output clipping as a waveshaper for antiderivative anti-aliasing
+  struct ManglerShaper : ADAASoftClip {
+    float loThresh, hiThresh, loAmp, midAmp, hiAmp;
+    int midClip, clip;
+    float shape(float x) const {
+      float out;
+      switch (midClip) {
+        case 0:
+          out = x * midAmp;
+          break;
+        case 1:
+          out = clamp(x, loThresh, hiThresh) * midAmp;
+          break;
+        case 2:
+          out = clamp(x * midAmp, loThresh, hiThresh);
+          break;
+        default:
+          out = clamp(clamp(x, loThresh, hiThresh) * midAmp, loThresh, hiThresh);
+      }
+      return out + (x>hiThresh ? (x-hiThresh) * hiAmp : x<loThresh ? (x-loThresh) * loAmp : 0.f);
+    }
+    void linear(ADAAPath& path) const {
+      float bp[4]{loThresh, hiThresh};
+      int n = 2;
+      if (midClip > 1 && midAmp) {
+        bp[n++] = loThresh / midAmp;
+        bp[n++] = hiThresh / midAmp;
+        std::sort(bp, bp+n);
+      }
+      path.apply([this](float x) {return shape(x);}, bp, n);
+      if (clip == 1) {
+        const float clipBP[2]{-5.f, 5.f};
+        path.apply([](float y) {return clamp(y, -5.f, 5.f);}, clipBP, 2);
+      }
+    }
+  };
 
   WaveMangler() {
     venomConfig(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -99,6 +139,8 @@ struct WaveMangler : VenomModule {
     configBypass(WAVE_INPUT, WAVE_OUTPUT);
     
     oversampleStages = 5;
+    oversampleFIR = true;
+    quiescence = 1;
   }
   
   void setOversample() override {
@@ -107,7 +149,7 @@ struct WaveMangler : VenomModule {
         for (int i=0; i<INPUTS_LEN; i++){
           upSample[i][s].setOversample(oversample, oversampleStages);
         }
-        downSample[s].setOversample(oversample, oversampleStages);
+        downSample[s].setOversample(oversample, oversampleStages, true);
       }
     }
   }
@@ -116,8 +158,8 @@ struct WaveMangler : VenomModule {
     VenomModule::process(args);
     using float_4 = simd::float_4;
     // update oversample configuration
-    if (oversample != oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]) {
-      oversample = oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())];
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())])) {
+      oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]);
       setOversample();
       sampleRate = 0.f;
     }
@@ -169,34 +211,52 @@ struct WaveMangler : VenomModule {
         loAmp = params[LO_AMP_PARAM].getValue() + in[LO_AMP_INPUT] * params[LO_AMP_AMT_PARAM].getValue();
         // offset input
         in[WAVE_INPUT] += inOff;
-        // compute output middle
-        switch (static_cast<int>(params[MID_CLIP_PARAM].getValue())) {
-          case 0: // clamp off
-            out = in[WAVE_INPUT] * midAmp;
-            break;
-          case 1: // clamp pre amp
-            out = clamp(in[WAVE_INPUT], loThresh, hiThresh) * midAmp;
-            break;
-          case 2: // clamp post amp
-            out = clamp(in[WAVE_INPUT] * midAmp, loThresh, hiThresh);
-            break;
-          default: // 3 clamp pre & post amp
-            out = simd::clamp(simd::clamp(in[WAVE_INPUT], loThresh, hiThresh) * midAmp, loThresh, hiThresh);
-        }
-        // add high and low output
-        out += ifelse(in[WAVE_INPUT]>hiThresh, (in[WAVE_INPUT]-hiThresh) * hiAmp, ifelse(in[WAVE_INPUT]<loThresh, (in[WAVE_INPUT]-loThresh) * loAmp, float_4::zero()));
-        // clamp output
-        switch (static_cast<int>(params[CLIP_PARAM].getValue())) {
-          case 1: // hard clip 5V
-            out = clamp(out, -5.f, 5.f);
-            break;
-          case 2: // soft clip 5V
-            out = softClip(out*2.f) / 2.f;
-            break;
-          case 3: // soft clip 6V
-            out = softClip(out*1.6667f) / 1.6667f;
-            break;
+        if (adaa) {
+          ManglerShaper shaper;
+          shaper.midClip = static_cast<int>(params[MID_CLIP_PARAM].getValue());
+          shaper.clip = static_cast<int>(params[CLIP_PARAM].getValue());
+          shaper.gain = shaper.clip == 2 ? 2.f : shaper.clip == 3 ? 1.6667f : 0.f;
+          for (int j=0; j<4 && c+j<channels; j++) {
+            shaper.loThresh = loThresh[j];
+            shaper.hiThresh = hiThresh[j];
+            shaper.loAmp = loAmp[j];
+            shaper.midAmp = midAmp[j];
+            shaper.hiAmp = hiAmp[j];
+            out[j] = adaaProcess(shaper, adaa, adaaIn[0][s][j], adaaIn[1][s][j], in[WAVE_INPUT][j]);
+          }
+        } else {
+          // compute output middle
+          switch (static_cast<int>(params[MID_CLIP_PARAM].getValue())) {
+            case 0: // clamp off
+              out = in[WAVE_INPUT] * midAmp;
+              break;
+            case 1: // clamp pre amp
+              out = clamp(in[WAVE_INPUT], loThresh, hiThresh) * midAmp;
+              break;
+            case 2: // clamp post amp
+              out = clamp(in[WAVE_INPUT] * midAmp, loThresh, hiThresh);
+              break;
+            default: // 3 clamp pre & post amp
+              out = simd::clamp(simd::clamp(in[WAVE_INPUT], loThresh, hiThresh) * midAmp, loThresh, hiThresh);
+          }
+          // add high and low output
+          out += ifelse(in[WAVE_INPUT]>hiThresh, (in[WAVE_INPUT]-hiThresh) * hiAmp, ifelse(in[WAVE_INPUT]<loThresh, (in[WAVE_INPUT]-loThresh) * loAmp, float_4::zero()));
+          // clamp output
+          switch (static_cast<int>(params[CLIP_PARAM].getValue())) {
+            case 1: // hard clip 5V
+              out = clamp(out, -5.f, 5.f);
+              break;
+            case 2: // soft clip 5V
+              out = softClip(out*2.f) / 2.f;
+              break;
+            case 3: // soft clip 6V
+              out = softClip(out*1.6667f) / 1.6667f;
+              break;
+          }
         }
+        // The input history is kept while ADAA is off, so that turning it on does not click
+        adaaIn[0][s] = adaaIn[1][s];
+        adaaIn[1][s] = in[WAVE_INPUT];
         // offset output
         out += outOff;
         // DC block output
@@ -213,8 +273,23 @@ struct WaveMangler : VenomModule {
     outputs[WAVE_OUTPUT].setChannels(channels);
   }
 
+  json_t* dataToJson() override {
+    json_t* rootJ = VenomModule::dataToJson();
+    json_object_set_new(rootJ, "adaa", json_integer(adaa));
+    return rootJ;
+  }
+
+  void dataFromJson(json_t* rootJ) override {
+    VenomModule::dataFromJson(rootJ);
+    json_t* val;
+    if ((val = json_object_get(rootJ, "adaa"))) {
+      adaa = clamp(static_cast<int>(json_integer_value(val)), 0, 2);
+    }
+  }
+
 };
 
+#ifndef VENOM_HEADLESS
 struct WaveManglerWidget : VenomWidget {
 
   struct DCSwitch : GlowingSvgSwitchLockable {
@@ -296,8 +371,22 @@ struct WaveManglerWidget : VenomWidget {
     addOutput(createOutputCentered<PolyPort>(Vec(72.5f, 341.5f), module, WaveMangler::WAVE_OUTPUT));
   }
 
+  void appendContextMenu(Menu* menu) override {
+    WaveMangler* module = static_cast<WaveMangler*>(this->module);
+    menu->addChild(new MenuSeparator);
+    menu->addChild(createIndexPtrSubmenuItem(
+      "Antiderivative anti-aliasing",
+      {"Off", "First order", "Second order"},
+      &module->adaa
+    ));
+    VenomWidget::appendContextMenu(menu);
+  }
+
 };
+#endif
 
 }
 
-Model* modelVenomWaveMangler = createModel<Venom::WaveMangler, Venom::WaveManglerWidget>("WaveMangler");
+#ifndef VENOM_HEADLESS
+Model* modelVenomWaveMangler = Venom::createVenomModel<Venom::WaveMangler, Venom::WaveManglerWidget>("WaveMangler");
+#endif
@@ -120,8 +120,8 @@ struct WaveMultiplier : VenomModule {
     
     using float_4 = simd::float_4;
     
-    if (oversample != oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]) {
-      oversample = oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())];
+    if (oversample != governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())])) {
+      oversample = governedOversample(oversampleValues[static_cast<int>(params[OVER_PARAM].getValue())]);
       setOversample();
       sampleRate = 0;
     }
@@ -308,4 +308,4 @@ struct WaveMultiplierWidget : VenomWidget {
 
 }
 
-Model* modelVenomWaveMultiplier = createModel<Venom::WaveMultiplier, Venom::WaveMultiplierWidget>("WaveMultiplier");
+Model* modelVenomWaveMultiplier = Venom::createVenomModel<Venom::WaveMultiplier, Venom::WaveMultiplierWidget>("WaveMultiplier");
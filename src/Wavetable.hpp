@@ -0,0 +1,170 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#pragma once
+#include "rack.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Venom {
+
+// Band limited mipmapped wavetable of one waveform family, rendered at evenly spaced shape amounts from -1 to 1.
+// Each shape point holds LEVELS single cycle tables, where level L keeps only the harmonics up to 512 >> L.
+// A level is stored with at least 8 samples per top harmonic (minimum 256), plus a guard sample that repeats the first
+// sample so linear interpolation never wraps.
+struct MipmapWavetable {
+  static const int SHAPES = 33, LEVELS = 10, TOP_HARMONIC = 512, RENDER_LEN = 8192;
+
+  static int levelLen(int level) {
+    return std::max(8 * (TOP_HARMONIC >> level), 256);
+  }
+  static int levelOffset(int level) {
+    int offset = 0;
+    for (int l=0; l<level; l++)
+      offset += levelLen(l) + 1;
+    return offset;
+  }
+
+  int shapeStride = levelOffset(LEVELS);
+  int offset[LEVELS], len[LEVELS];
+  std::vector<float> data;
+
+  MipmapWavetable() {
+    for (int l=0; l<LEVELS; l++) {
+      offset[l] = levelOffset(l);
+      len[l] = levelLen(l);
+    }
+    data.resize(SHAPES * shapeStride);
+  }
+
+  // Renders every shape point with render(shape, cycle, RENDER_LEN), which must fill one naive cycle of the waveform.
+  // The cycle is rendered at a high resolution so that the harmonics folded back by the naive rendering are negligible.
+  void build(const std::function<void(float, float*, int)>& render) {
+    float* cycle = (float*)pffft_aligned_malloc(RENDER_LEN * sizeof(float));
+    float* spectrum = (float*)pffft_aligned_malloc(RENDER_LEN * sizeof(float));
+    float* levelSpectrum = (float*)pffft_aligned_malloc(levelLen(0) * sizeof(float));
+    rack::dsp::RealFFT renderFFT(RENDER_LEN);
+    std::vector<rack::dsp::RealFFT*> levelFFT;
+    for (int l=0; l<LEVELS; l++)
+      levelFFT.push_back(l && len[l]==len[l-1] ? levelFFT.back() : new rack::dsp::RealFFT(len[l]));
+    for (int j=0; j<SHAPES; j++) {
+      render(j * 2.f / (SHAPES - 1) - 1.f, cycle, RENDER_LEN);
+      renderFFT.rfft(cycle, spectrum);
+      for (int l=0; l<LEVELS; l++) {
+        // ordered real spectrum: DC, Nyquist, then real and imaginary pairs for each harmonic
+        int harmonics = TOP_HARMONIC >> l;
+        std::fill(levelSpectrum, levelSpectrum + len[l], 0.f);
+        levelSpectrum[0] = spectrum[0];
+        std::copy(spectrum + 2, spectrum + 2 + 2 * harmonics, levelSpectrum + 2);
+        float* table = &data[j * shapeStride + offset[l]];
+        levelFFT[l]->irfft(levelSpectrum, cycle);
+        for (int i=0; i<len[l]; i++)
+          table[i] = cycle[i] / RENDER_LEN;
+        table[len[l]] = table[0];
+      }
+    }
+    for (int l=0; l<LEVELS; l++) {
+      if (!l || levelFFT[l] != levelFFT[l-1])
+        delete levelFFT[l];
+    }
+    pffft_aligned_free(levelSpectrum);
+    pffft_aligned_free(spectrum);
+    pffft_aligned_free(cycle);
+  }
+
+  // Mipmap level whose top harmonic stays below Nyquist for a phase change of delta cycles per sample
+  static int level(float delta) {
+    int exp;
+    std::frexp(delta * (2 * TOP_HARMONIC), &exp);
+    return std::max(std::min(exp, LEVELS - 1), 0);
+  }
+
+  // Interpolated value at phase 0 to 1 and shape -1 to 1 for a phase change of delta cycles per sample.
+  float lookup(float phase, float shape, float delta) const {
+    int l = level(std::fabs(delta));
+    float x = phase * len[l], s = (std::fmax(std::fmin(shape, 1.f), -1.f) + 1.f) * (0.5f * (SHAPES - 1));
+    int i = std::min(static_cast<int>(x), len[l] - 1), j = std::min(static_cast<int>(s), SHAPES - 2);
+    x -= i;
+    s -= j;
+    const float* a = &data[j * shapeStride + offset[l] + i];
+    const float* b = a + shapeStride;
+    float va = a[0] + (a[1] - a[0]) * x, vb = b[0] + (b[1] - b[0]) * x;
+    return va + (vb - va) * s;
+  }
+};
+
+// A set of mipmapped wavetables shared by all instances of a module. Each table is built by a background thread
+// the first time it is requested, and is kept until the plugin is unloaded.
+// render(table, shape, cycle, len) must fill one naive cycle of a table waveform, and must not depend on any module instance.
+struct WavetableBank {
+  typedef std::function<void(int, float, float*, int)> Renderer;
+
+  WavetableBank(int tableCnt, Renderer render) : tables(tableCnt), requested(tableCnt), render(render) {
+    for (int t=0; t<tableCnt; t++) {
+      tables[t] = NULL;
+      requested[t] = false;
+    }
+    pending.reserve(tableCnt);
+    worker = new std::thread(&WavetableBank::work, this);
+  }
+
+  ~WavetableBank() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running = false;
+    }
+    condVar.notify_one();
+    worker->join();
+    delete worker;
+    for (auto& t : tables)
+      delete t.load();
+  }
+
+  // Returns the table, or NULL while it is being built. Safe to call from the audio thread.
+  const MipmapWavetable* get(int table) {
+    const MipmapWavetable* t = tables[table].load(std::memory_order_acquire);
+    if (!t && !requested[table].exchange(true)) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(table);
+      }
+      condVar.notify_one();
+    }
+    return t;
+  }
+
+private:
+  std::vector<std::atomic<MipmapWavetable*>> tables;
+  std::vector<std::atomic<bool>> requested;
+  Renderer render;
+  std::vector<int> pending;
+  std::mutex mutex;
+  std::condition_variable condVar;
+  std::thread* worker;
+  bool running = true;
+
+  void work() {
+    while (true) {
+      int table;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condVar.wait(lock, [this]() {return !running || !pending.empty();});
+        if (!running)
+          return;
+        table = pending.back();
+        pending.pop_back();
+      }
+      MipmapWavetable* t = new MipmapWavetable;
+      t->build([&](float shape, float* cycle, int len) {render(table, shape, cycle, len);});
+      tables[table].store(t, std::memory_order_release);
+    }
+  }
+};
+
+}
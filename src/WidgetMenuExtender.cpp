@@ -443,4 +443,4 @@ struct WidgetMenuExtenderWidget : VenomWidget {
 
 }
 
-Model* modelVenomWidgetMenuExtender = createModel<Venom::WidgetMenuExtender, Venom::WidgetMenuExtenderWidget>("WidgetMenuExtender");
+Model* modelVenomWidgetMenuExtender = Venom::createVenomModel<Venom::WidgetMenuExtender, Venom::WidgetMenuExtenderWidget>("WidgetMenuExtender");
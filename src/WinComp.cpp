@@ -485,7 +485,7 @@ struct WinCompWidget : VenomWidget {
         },
       [=](int i) {
           module->oversample = module->oversampleValues[i];
-          module->setOversample();
+          module->oversampleChanged = true;
         }
     ));
     menu->addChild(createBoolPtrMenuItem("B normalled to A -1 sample", "", &module->bFromA));
@@ -496,4 +496,4 @@ struct WinCompWidget : VenomWidget {
 
 }
 
-Model* modelVenomWinComp = createModel<Venom::WinComp, Venom::WinCompWidget>("WinComp");
+Model* modelVenomWinComp = Venom::createVenomModel<Venom::WinComp, Venom::WinCompWidget>("WinComp");
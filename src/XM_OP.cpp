@@ -90,6 +90,11 @@ struct XM_OP : VenomModule {
           syncRtrg[4]{},
           vcoPhasor[4]{},
           prevVcoOut[4]{};
+  ControlRamp<float_4> ratioRamp[4]{},
+                       atkDelta[4]{},
+                       decDelta[4]{},
+                       relDelta[4]{};
+  bool envEdge[4]{};
   DCBlockFilter_4 xmodDcBlockFilter[4]{},
                   fdbkDcBlockFilter[4]{};
 
@@ -131,6 +136,7 @@ struct XM_OP : VenomModule {
     configParam(DIV_CV_PARAM, -1.f, 1.f, 0.f, "VCO frequency divisor mod amount", "%", 0.f, 100.f);
     configParam(DTUNE_CV_PARAM, -1.f, 1.f, 0.f, "VCO detune mod amount", "%", 0.f, 100.f);
     configInput(RMOD_INPUT, "frequency Ratio modulation");
+    configAudioRateInput(RMOD_INPUT);
 
     configSwitch<FixedSwitchQuantity>(LEVEL_ENV_PARAM, 0.f, 6.f, 0.f, "Level envelope", {"Off", "Knob", "CV", "Both", "Knob Inverted", "CV Inverted", "Both Inverted"});
     configSwitch<FixedSwitchQuantity>(DEPTH_ENV_PARAM, 0.f, 6.f, 0.f, "X-Mod depth envelope", {"Off", "Knob", "CV", "Both", "Knob Inverted", "CV Inverted", "Both Inverted"});
@@ -231,8 +237,8 @@ struct XM_OP : VenomModule {
     VenomModule::process(args);
 
     // update oversample
-    if (oversample != oversampleValues[params[OVER_PARAM].getValue()]) {
-      oversample = oversampleValues[params[OVER_PARAM].getValue()];
+    if (oversample != governedOversample(oversampleValues[params[OVER_PARAM].getValue()])) {
+      oversample = governedOversample(oversampleValues[params[OVER_PARAM].getValue()]);
       setOversample();
       sampleRate = 0;
     }
@@ -331,14 +337,29 @@ struct XM_OP : VenomModule {
           depthCVAmt = params[DEPTH_CV_PARAM].getValue(),
           fdbkCVAmt = params[FDBK_CV_PARAM].getValue(),
           k =  1000.f * args.sampleTime / oversample;          
+    // the mult/div frequency ratio and the envelope stage rates are control rate,
+    // except the ratio follows a connected ratio mod input at audio rate
+    bool tick = controlRateTick(),
+         ratioAudioRate = isAudioRateInput(RMOD_INPUT);
 
     for (int s=0, c=0; c<channels; s++, c+=4) {
       float_4 rmod = inputs[RMOD_INPUT].getPolyVoltageSimd<float_4>(c),
               smod = inputs[SMOD_INPUT].getPolyVoltageSimd<float_4>(c),
-              susLevel = clamp(susParam + smod*susCVAmt),
-              delta = ifelse(stage[s]==1.f, args.sampleTime / clamp(pow(2.f, smod*atkCVAmt + atkParam), minTime, maxTime),
-                        ifelse(stage[s]==2.f, args.sampleTime / clamp(pow(2.f, smod*decCVAmt + decParam), minTime, maxTime),
-                          ifelse(stage[s]==4.f, args.sampleTime / clamp(pow(2.f, smod*relCVAmt + relParam), minTime, maxTime), 0.f)));
+              susLevel = clamp(susParam + smod*susCVAmt);
+      // stage rates jump to new values right after a stage change so a new note uses its current stage mod
+      if (tick || envEdge[s] || atkDelta[s].unset()) {
+        int steps = envEdge[s] ? 1 : CONTROL_RATE_DIVISION;
+        atkDelta[s].set(args.sampleTime / clamp(pow(2.f, smod*atkCVAmt + atkParam), minTime, maxTime), steps);
+        decDelta[s].set(args.sampleTime / clamp(pow(2.f, smod*decCVAmt + decParam), minTime, maxTime), steps);
+        relDelta[s].set(args.sampleTime / clamp(pow(2.f, smod*relCVAmt + relParam), minTime, maxTime), steps);
+        envEdge[s] = false;
+      }
+      float_4 atk = atkDelta[s].process(),
+              dec = decDelta[s].process(),
+              rel = relDelta[s].process(),
+              delta = ifelse(stage[s]==1.f, atk,
+                        ifelse(stage[s]==2.f, dec,
+                          ifelse(stage[s]==4.f, rel, 0.f)));
       envPhasor[s] = clamp(envPhasor[s]+delta);
       float_4 curve = normSigmoid(envPhasor[s], shape),
               envOut = ifelse(stage[s]<=1.f, curve,
@@ -360,6 +381,7 @@ struct XM_OP : VenomModule {
                        ifelse(newStage==1.f, invNormSigmoid(envOut, shape),
                          ifelse((newStage==4.f) & (envOut<susLevel), invNormSigmoid((susLevel-envOut)/susLevel, shape), 0.f)));
       relStart[s] = ifelse((newStage!=stage[s]) & (newStage==4.f), envOut, relStart[s]);
+      envEdge[s] = simd::movemask(newStage!=stage[s]);
 
       float_4 baseFreq = inputs[VOCT_INPUT].getPolyVoltageSimd<float_4>(c)
                          + dtuneParam + rmod*dtuneCVAmt,
@@ -370,14 +392,21 @@ struct XM_OP : VenomModule {
               vcoOut{};
       computeVal(level, levelEnv, envOut, levelParam, levelCVAmt, LEVEL_INPUT, c);
       level = clamp(level);
-      if (expLvl)
-        level = pow(level,6);
+      if (expLvl) {
+        level *= level * level;
+        level *= level;
+      }
       computeVal(depth, depthEnv, envOut, depthParam, depthCVAmt, DEPTH_INPUT, c);
       computeVal(fdbk, fdbkEnv, envOut, fdbkParam, fdbkCVAmt, FDBK_INPUT, c);
-      if (quantize)
-        baseFreq += log2(fmax(round(multParam + rmod*10.f*multCVAmt), 1.f) / fmax(round(divParam + rmod*10.f*divCVAmt), 1.f));
-      else
-        baseFreq += log2(fmax(multParam + rmod*10.f*multCVAmt, 1.f) / fmax(divParam + rmod*10.f*divCVAmt, 1.f));
+      // quantized ratios jump so they never glide through non-integer ratios
+      if (ratioAudioRate || tick || envEdge[s] || ratioRamp[s].unset()) {
+        int steps = (envEdge[s] || ratioAudioRate || quantize) ? 1 : CONTROL_RATE_DIVISION;
+        if (quantize)
+          ratioRamp[s].set(log2(fmax(round(multParam + rmod*10.f*multCVAmt), 1.f) / fmax(round(divParam + rmod*10.f*divCVAmt), 1.f)), steps);
+        else
+          ratioRamp[s].set(log2(fmax(multParam + rmod*10.f*multCVAmt, 1.f) / fmax(divParam + rmod*10.f*divCVAmt, 1.f)), steps);
+      }
+      baseFreq += ratioRamp[s].process();
       baseFreq = dsp::exp2_taylor5(baseFreq);
       for (int o=0; o<oversample; o++) {
         if (oversample>1)
@@ -500,6 +529,7 @@ struct XM_OP : VenomModule {
     
 };
 
+#ifndef VENOM_HEADLESS
 struct XM_OPWidget : VenomWidget {
   
   struct WaveSwitch : GlowingSvgSwitchLockable {
@@ -644,7 +674,10 @@ struct XM_OPWidget : VenomWidget {
     VenomWidget::appendContextMenu(menu);
   }
 };
+#endif
 
 }
 
-Model* modelVenomXM_OP = createModel<Venom::XM_OP, Venom::XM_OPWidget>("XM_OP");
+#ifndef VENOM_HEADLESS
+Model* modelVenomXM_OP = Venom::createVenomModel<Venom::XM_OP, Venom::XM_OPWidget>("XM_OP");
+#endif
@@ -1,4 +1,6 @@
+#pragma once
 #include <array>
+#include "Dispatch.hpp"
 
 namespace Venom {
 
@@ -12,8 +14,9 @@ T tanh_rational5(T x) {
   );
 }
 
+// Always inline so that block kernels compiled for each instruction set (Dispatch.hpp) can vectorize it
 template <typename T>
-T softClip(T x, float drive = 0) {
+VENOM_KERNEL T softClip(T x, float drive = 0) {
   x /= (9.5f - drive * 9.f);
   T x2 = x * x;
   x = simd::ifelse(
@@ -24,6 +27,48 @@ T softClip(T x, float drive = 0) {
   return x * static_cast<T>(10.f);
 }
 
+// First and second antiderivatives of tanh_rational5, both 0 at x = 0, for antiderivative anti-aliasing
+template <typename T>
+T tanh_rational5_ad1(T x) {
+  T x2 = x * x;
+  T ax = simd::fabs(x);
+  return simd::ifelse(
+    ax >= static_cast<T>(3.f),
+    ax + static_cast<T>(-2.5f + 4.f / 3.f * std::log(4.f)),
+    x2 / static_cast<T>(18.f) + static_cast<T>(4.f / 3.f) * simd::log(static_cast<T>(1.f) + x2 / static_cast<T>(3.f))
+  );
+}
+
+template <typename T>
+T tanh_rational5_ad2(T x) {
+  const float sqrt3 = std::sqrt(3.f),
+              ad1At3 = 0.5f + 4.f / 3.f * std::log(4.f),
+              ad2At3 = 0.5f + 4.f / 3.f * (3.f * std::log(4.f) - 6.f + 2.f * sqrt3 * std::atan(sqrt3));
+  T x2 = x * x;
+  T ax = simd::fabs(x), over = ax - static_cast<T>(3.f);
+  return simd::ifelse(
+    ax >= static_cast<T>(3.f),
+    simd::sgn(x) * (static_cast<T>(ad2At3) + over * static_cast<T>(ad1At3) + over * over * static_cast<T>(0.5f)),
+    x2 * x / static_cast<T>(54.f) + static_cast<T>(4.f / 3.f) * (
+      x * simd::log(static_cast<T>(1.f) + x2 / static_cast<T>(3.f)) - static_cast<T>(2.f) * x
+      + static_cast<T>(2.f * sqrt3) * simd::atan(x / static_cast<T>(sqrt3))
+    )
+  );
+}
+
+// First and second antiderivatives of softClip
+template <typename T>
+T softClip_ad1(T x, float drive = 0) {
+  float scale = 9.5f - drive * 9.f;
+  return tanh_rational5_ad1(x / scale) * (scale * 10.f);
+}
+
+template <typename T>
+T softClip_ad2(T x, float drive = 0) {
+  float scale = 9.5f - drive * 9.f;
+  return tanh_rational5_ad2(x / scale) * (scale * scale * 10.f);
+}
+
 // fast sine calculation. modified from the Reaktor 6 core library.
 // takes a [0, 1] range and folds it to a triangle on a [0, 0.5] range.
 inline float sin_01(float t) {
@@ -42,6 +87,19 @@ inline float sin_01(float t) {
   return t;
 }
 
+// Sine and cosine of x for |x| <= pi/2 by Taylor polynomials, accurate to better than 1e-7 over that range
+template <typename T>
+T sin_taylor11(T x) {
+  T x2 = x * x;
+  return x * (1.f + x2 * (-1.f/6.f + x2 * (1.f/120.f + x2 * (-1.f/5040.f + x2 * (1.f/362880.f + x2 * (-1.f/39916800.f))))));
+}
+
+template <typename T>
+T cos_taylor12(T x) {
+  T x2 = x * x;
+  return 1.f + x2 * (-1.f/2.f + x2 * (1.f/24.f + x2 * (-1.f/720.f + x2 * (1.f/40320.f + x2 * (-1.f/3628800.f + x2 * (1.f/479001600.f))))));
+}
+
 // Normalized Tunable Sigmoid Function: see https://dhemery.github.io/DHE-Modules/technical/sigmoid/#function
 // phasor x and curve y always between -1 and 1 inclusive, shape k between -1 and 1 exclusive. Linear curve (y=x) if k=0
 template <typename T1, typename T2>
@@ -8,10 +8,12 @@ Plugin* pluginInstance;
 namespace Venom
 {
   void readDefaultThemes();
+  void initSimdDispatch();
 }
 
 void init(Plugin* p) {
   pluginInstance = p;
+  Venom::initSimdDispatch();
 
   // Add modules here
   p->addModel(modelVenomAD_ASR);
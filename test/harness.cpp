@@ -0,0 +1,385 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+// Runner of the headless scenarios and benchmarks.
+//   venom-test check [filter...]  compare every scenario with its reference render, exit status 1 on failure
+//   venom-test refs [filter...]   write the reference renders of the scenarios
+//   venom-test bench [filter...]  print ns per sample for each module, oversample factor and channel count as CSV
+// A filter selects the scenarios and benchmarks whose name starts with it.
+// Options: --ref DIR (default ref), --frames N (benchmark frames per run, default 9600)
+
+#include "harness.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace VenomTest {
+
+std::vector<Scenario>& scenarios() {
+  static std::vector<Scenario> list;
+  return list;
+}
+
+std::vector<Benchmark>& benchmarks() {
+  static std::vector<Benchmark> list;
+  return list;
+}
+
+void load(Module* m, json_t* json) {
+  m->dataFromJson(json);
+  json_decref(json);
+  static_cast<Venom::VenomModule*>(m)->drawn = true;
+}
+
+static void portChange(Module* m, Port::Type type, int id, bool connecting) {
+  Module::PortChangeEvent e;
+  e.connecting = connecting;
+  e.type = type;
+  e.portId = id;
+  m->onPortChange(e);
+}
+
+void connectInput(Module* m, int id, int channels) {
+  bool connecting = !m->inputs[id].isConnected();
+  m->inputs[id].channels = channels;
+  if (connecting)
+    portChange(m, Port::INPUT, id, true);
+}
+
+void disconnectInput(Module* m, int id) {
+  m->inputs[id].channels = 0;
+  for (int c=0; c<PORT_MAX_CHANNELS; c++)
+    m->inputs[id].voltages[c] = 0.f;
+  portChange(m, Port::INPUT, id, false);
+}
+
+void connectOutput(Module* m, int id) {
+  m->outputs[id].channels = 1;
+  portChange(m, Port::OUTPUT, id, true);
+}
+
+static double cycles(double freq, int64_t frame, float sampleRate, double phase) {
+  double t = freq * frame / sampleRate + phase;
+  return t - std::floor(t);
+}
+
+float sine(double freq, int64_t frame, float sampleRate, double phase) {
+  return 5.0 * std::sin(2.0 * M_PI * cycles(freq, frame, sampleRate, phase));
+}
+
+float saw(double freq, int64_t frame, float sampleRate, double phase) {
+  return 10.0 * cycles(freq, frame, sampleRate, phase) - 5.0;
+}
+
+float square(double freq, int64_t frame, float sampleRate, double phase) {
+  return cycles(freq, frame, sampleRate, phase) < 0.5 ? 5.f : -5.f;
+}
+
+float voct(double freq) {
+  return std::log2(freq / dsp::FREQ_C4);
+}
+
+void setPoly(Module* m, int id, const std::function<float(int)>& f) {
+  Input& in = m->inputs[id];
+  for (int c=0; c<in.getChannels(); c++)
+    in.setVoltage(f(c), c);
+}
+
+static Module::ProcessArgs processArgs(float sampleRate) {
+  Module::ProcessArgs args;
+  args.sampleRate = sampleRate;
+  args.sampleTime = 1.f / sampleRate;
+  args.frame = 0;
+  return args;
+}
+
+// The module of a scenario or benchmark, created with the engine random generator in a fixed state
+static Module* start(const std::function<Module*()>& create, float sampleRate) {
+  random::init();
+  APP->engine->sampleRate = sampleRate;
+  Module* m = create();
+  m->onAdd(Module::AddEvent());
+  Module::SampleRateChangeEvent e;
+  e.sampleRate = sampleRate;
+  e.sampleTime = 1.f / sampleRate;
+  m->onSampleRateChange(e);
+  return m;
+}
+
+// The channel count and voltages of each recorded output, frame by frame
+static std::vector<float> render(const Scenario& s, int frames) {
+  std::vector<float> data;
+  Module* m = start(s.create, s.sampleRate);
+  Module::ProcessArgs args = processArgs(s.sampleRate);
+  for (int f=0; f<frames; f++) {
+    args.frame = f;
+    if (s.drive)
+      s.drive(m, f);
+    // In Rack the module widgets refill the filter arenas on the UI thread
+    Venom::refillFilterArenas();
+    m->process(args);
+    for (int o : s.outputs) {
+      Output& out = m->outputs[o];
+      data.push_back(out.getChannels());
+      for (int c=0; c<out.getChannels(); c++)
+        data.push_back(out.getVoltage(c));
+    }
+  }
+  delete m;
+  return data;
+}
+
+// Mean, RMS and zero crossings per second of each recorded output channel, preceded by the channel count
+static std::vector<float> statistics(const Scenario& s, const std::vector<float>& data) {
+  std::vector<float> stats;
+  int outCnt = s.outputs.size();
+  size_t pos = 0;
+  std::vector<std::vector<std::vector<float>>> chan(outCnt);
+  while (pos < data.size()) {
+    for (int o=0; o<outCnt; o++) {
+      int cnt = data[pos++];
+      chan[o].resize(std::max(static_cast<int>(chan[o].size()), cnt));
+      for (int c=0; c<cnt; c++)
+        chan[o][c].push_back(data[pos++]);
+    }
+  }
+  for (int o=0; o<outCnt; o++) {
+    stats.push_back(chan[o].size());
+    for (std::vector<float>& v : chan[o]) {
+      double sum = 0.0, sq = 0.0;
+      for (float x : v) {
+        sum += x;
+        sq += x * x;
+      }
+      double mean = sum / v.size();
+      int cross = 0;
+      for (size_t i=1; i<v.size(); i++)
+        cross += (v[i-1] < mean) != (v[i] < mean);
+      stats.push_back(mean);
+      stats.push_back(std::sqrt(sq / v.size()));
+      stats.push_back(cross * s.sampleRate / v.size());
+    }
+  }
+  return stats;
+}
+
+// Largest spectral peak away from the harmonics of freq, in dB relative to the fundamental.
+// The tone is analysed after a settling time with a 4 term Blackman-Harris window, which leaks less
+// than -92 dB beyond 4 bins, and the bins within 6 bins of DC or a harmonic are excluded.
+static const int ALIAS_LEN = 16384;
+static float aliasFloor(const std::vector<float>& x, float freq, float sampleRate) {
+  std::vector<float> in(ALIAS_LEN), spec(ALIAS_LEN);
+  for (int i=0; i<ALIAS_LEN; i++) {
+    double p = 2.0 * M_PI * i / ALIAS_LEN;
+    double w = 0.35875 - 0.48829 * std::cos(p) + 0.14128 * std::cos(2.0 * p) - 0.01168 * std::cos(3.0 * p);
+    in[i] = x[x.size() - ALIAS_LEN + i] * w;
+  }
+  dsp::RealFFT fft(ALIAS_LEN);
+  fft.rfft(in.data(), spec.data());
+  int bins = ALIAS_LEN / 2;
+  std::vector<double> power(bins);
+  power[0] = spec[0] * spec[0];
+  for (int k=1; k<bins; k++)
+    power[k] = spec[2*k] * spec[2*k] + spec[2*k+1] * spec[2*k+1];
+  double binHz = sampleRate / ALIAS_LEN;
+  double fundamental = 0.0, alias = 1e-30;
+  for (int k=0; k<bins; k++) {
+    double h = k * binHz / freq;
+    double dist = std::fabs(h - std::round(h)) * freq / binHz;
+    if (dist > 6.0)
+      alias = std::max(alias, power[k]);
+    else if (std::round(h) == 1.0)
+      fundamental = std::max(fundamental, power[k]);
+  }
+  return 10.0 * std::log10(alias / fundamental);
+}
+
+static std::vector<float> result(const Scenario& s) {
+  if (s.kind == Scenario::ALIASING) {
+    std::vector<float> data = render(s, s.frames + ALIAS_LEN);
+    std::vector<float> tone;
+    size_t pos = 0;
+    while (pos < data.size()) {
+      for (size_t o=0; o<s.outputs.size(); o++) {
+        int cnt = data[pos];
+        if (o == 0)
+          tone.push_back(data[pos+1]);
+        pos += cnt + 1;
+      }
+    }
+    return {aliasFloor(tone, s.aliasFreq, s.sampleRate)};
+  }
+  std::vector<float> data = render(s, s.frames);
+  return s.kind == Scenario::STATISTICS ? statistics(s, data) : data;
+}
+
+static std::string refPath(const std::string& dir, const Scenario& s) {
+  return dir + "/" + s.name + ".f32";
+}
+
+static bool readRef(const std::string& path, std::vector<float>& ref) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file)
+    return false;
+  float buf[1024];
+  size_t cnt;
+  while ((cnt = fread(buf, sizeof(float), 1024, file)))
+    ref.insert(ref.end(), buf, buf + cnt);
+  fclose(file);
+  return true;
+}
+
+static bool writeRef(const std::string& path, const std::vector<float>& data) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file)
+    return false;
+  bool ok = fwrite(data.data(), sizeof(float), data.size(), file) == data.size();
+  return !fclose(file) && ok;
+}
+
+// Returns an empty string if out matches ref, or else the reason it does not
+static std::string compare(const Scenario& s, const std::vector<float>& out, const std::vector<float>& ref, float& worst) {
+  worst = 0.f;
+  for (float x : out) {
+    if (!std::isfinite(x))
+      return "non finite output";
+  }
+  if (s.kind == Scenario::ALIASING) {
+    worst = out[0];
+    if (ref.size() != 1)
+      return "malformed reference";
+    if (out[0] > s.aliasLimit)
+      return string::f("alias floor %.1f dBc exceeds the %.1f dBc limit", out[0], s.aliasLimit);
+    if (out[0] > ref[0] + s.tolerance)
+      return string::f("alias floor %.1f dBc rose from %.1f dBc", out[0], ref[0]);
+    return "";
+  }
+  if (out.size() != ref.size())
+    return string::f("%zu values, reference has %zu", out.size(), ref.size());
+  size_t pos = 0;
+  while (pos < out.size()) {
+    for (size_t o=0; o<s.outputs.size(); o++) {
+      if (out[pos] != ref[pos])
+        return string::f("output %d has %g channels, reference has %g", s.outputs[o], out[pos], ref[pos]);
+      int cnt = ref[pos++];
+      if (s.kind == Scenario::STATISTICS)
+        cnt *= 3;
+      for (int i=0; i<cnt; i++, pos++) {
+        float diff = std::fabs(out[pos] - ref[pos]);
+        if (s.kind == Scenario::STATISTICS)
+          diff /= 1.f + std::fabs(ref[pos]);
+        worst = std::max(worst, diff);
+      }
+    }
+    if (s.kind == Scenario::STATISTICS)
+      break;
+  }
+  if (worst > s.tolerance)
+    return string::f("difference %g exceeds the tolerance %g", worst, s.tolerance);
+  return "";
+}
+
+static bool selected(const std::string& name, const std::vector<std::string>& filters) {
+  if (filters.empty())
+    return true;
+  for (const std::string& f : filters) {
+    if (!name.compare(0, f.size(), f))
+      return true;
+  }
+  return false;
+}
+
+static int check(const std::string& refDir, const std::vector<std::string>& filters) {
+  int run = 0, failed = 0;
+  for (const Scenario& s : scenarios()) {
+    if (!selected(s.name, filters))
+      continue;
+    run++;
+    std::vector<float> ref, out = result(s);
+    float worst = 0.f;
+    std::string err = readRef(refPath(refDir, s), ref) ? compare(s, out, ref, worst) : "no reference render";
+    if (err.empty())
+      printf("PASS  %-44s %s %g\n", s.name.c_str(), s.kind == Scenario::ALIASING ? "dBc" : "diff", worst);
+    else {
+      printf("FAIL  %-44s %s\n", s.name.c_str(), err.c_str());
+      failed++;
+    }
+  }
+  printf("%d of %d scenarios passed\n", run - failed, run);
+  return failed ? 1 : 0;
+}
+
+static int refs(const std::string& refDir, const std::vector<std::string>& filters) {
+  for (const Scenario& s : scenarios()) {
+    if (!selected(s.name, filters))
+      continue;
+    if (!writeRef(refPath(refDir, s), result(s))) {
+      fprintf(stderr, "cannot write %s\n", refPath(refDir, s).c_str());
+      return 1;
+    }
+    printf("wrote %s\n", refPath(refDir, s).c_str());
+  }
+  return 0;
+}
+
+// Best of 3 timed runs after a warm up, so that the table reflects the DSP and not scheduling noise
+static int bench(int frames, const std::vector<std::string>& filters) {
+  printf("module,oversample,channels,ns_per_sample,ns_per_sample_per_channel\n");
+  for (const Benchmark& b : benchmarks()) {
+    if (!selected(b.module, filters))
+      continue;
+    for (int over : b.oversample) {
+      for (int channels : b.channels) {
+        Module* m = start(b.create, 48000.f);
+        b.setup(m, over, channels);
+        Module::ProcessArgs args = processArgs(48000.f);
+        double best = 1e30;
+        int64_t frame = 0;
+        for (int run=0; run<4; run++) {
+          Venom::refillFilterArenas();
+          std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+          for (int f=0; f<frames; f++, frame++) {
+            args.frame = frame;
+            if (b.drive)
+              b.drive(m, frame);
+            m->process(args);
+          }
+          double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / frames;
+          if (run)
+            best = std::min(best, ns);
+        }
+        delete m;
+        printf("%s,%d,%d,%.1f,%.2f\n", b.module.c_str(), over, channels, best, best / channels);
+        fflush(stdout);
+      }
+    }
+  }
+  return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+  using namespace VenomTest;
+  std::string cmd = argc > 1 ? argv[1] : "check", refDir = "ref";
+  int frames = 9600;
+  std::vector<std::string> filters;
+  for (int i=2; i<argc; i++) {
+    if (!strcmp(argv[i], "--ref") && i+1 < argc)
+      refDir = argv[++i];
+    else if (!strcmp(argv[i], "--frames") && i+1 < argc)
+      frames = std::max(atoi(argv[++i]), 1);
+    else
+      filters.push_back(argv[i]);
+  }
+  Venom::initSimdDispatch();
+  if (cmd == "check")
+    return check(refDir, filters);
+  if (cmd == "refs")
+    return refs(refDir, filters);
+  if (cmd == "bench")
+    return bench(frames, filters);
+  fprintf(stderr, "usage: %s check|refs|bench [--ref DIR] [--frames N] [filter...]\n", argv[0]);
+  return 2;
+}
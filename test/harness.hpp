@@ -0,0 +1,90 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+// Headless DSP regression suite and benchmark.
+// Each file in test/modules includes the source of one module and registers fixed seed scenarios for it.
+// A scenario renders the module with scripted parameters and inputs, and its result is compared with a
+// reference render stored in test/ref. See test/README.md.
+
+#pragma once
+#include "Venom.hpp"
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace VenomTest {
+
+using namespace rack;
+
+struct Scenario {
+  enum Kind {
+    WAVEFORM,   // every recorded sample must be within tolerance volts of the reference
+    STATISTICS, // per channel mean, RMS and zero crossing rate must be within tolerance (relative) of the reference;
+                // for chaotic modules whose waveform diverges from any float rounding change
+    ALIASING    // the alias floor in dBc of the first recorded output, channel 0, must not exceed aliasLimit,
+                // nor rise more than tolerance dB above the reference
+  };
+  std::string name; // module slug, a dot, and the case name; also the reference file name
+  Kind kind = WAVEFORM;
+  std::function<Module*()> create;
+  std::function<void(Module*, int64_t frame)> drive; // sets parameters and input voltages before each frame
+  std::vector<int> outputs; // recorded output ids
+  int frames = 1024;
+  float sampleRate = 48000.f;
+  float tolerance = 1e-4f;
+  float aliasFreq = 0.f;  // ALIASING: fundamental of the rendered tone in Hz
+  float aliasLimit = 0.f; // ALIASING: highest acceptable alias floor in dBc
+};
+
+struct Benchmark {
+  std::string module;
+  std::function<Module*()> create;
+  std::vector<int> oversample{1}; // factors offered by the module
+  std::vector<int> channels{1, 4, 8, 16}; // polyphony measured
+  std::function<void(Module*, int oversample, int channels)> setup; // connects inputs and selects the factor
+  std::function<void(Module*, int64_t frame)> drive;
+};
+
+std::vector<Scenario>& scenarios();
+std::vector<Benchmark>& benchmarks();
+
+// Registers the scenarios and benchmarks of a module file at static initialization
+struct Registrar {
+  Registrar(void (*reg)()) {reg();}
+};
+
+// Creates a module as createVenomModel() would, and marks it drawn so that parameter extensions initialize
+// as they do in Rack once the panel is shown.
+// The memory is filled with a fixed pattern first, so that a member the module forgets to initialize reads the
+// same value in every run instead of whatever an earlier scenario left on the heap.
+template <class TModule>
+TModule* create(Model* model) {
+  void* mem = ::operator new(sizeof(Venom::VenomMeteredModule<TModule>));
+  std::memset(mem, 0x7f, sizeof(Venom::VenomMeteredModule<TModule>));
+  Venom::VenomMeteredModule<TModule>* m = new (mem) Venom::VenomMeteredModule<TModule>;
+  m->model = model;
+  m->drawn = true;
+  return m;
+}
+
+// Patch state as dataFromJson() receives it from a patch file; keys absent from json keep old patch defaults
+void load(Module* m, json_t* json);
+
+void connectInput(Module* m, int id, int channels = 1);
+void disconnectInput(Module* m, int id);
+void connectOutput(Module* m, int id);
+
+// Test signals, all with amplitude 5 V, computed in double precision so they do not drift
+float sine(double freq, int64_t frame, float sampleRate = 48000.f, double phase = 0.0);
+float saw(double freq, int64_t frame, float sampleRate = 48000.f, double phase = 0.0);
+float square(double freq, int64_t frame, float sampleRate = 48000.f, double phase = 0.0);
+
+// V/Oct voltage of a frequency relative to C4
+float voct(double freq);
+
+// Sets each channel of an input with f(channel)
+void setPoly(Module* m, int id, const std::function<float(int)>& f);
+
+}
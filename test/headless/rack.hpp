@@ -0,0 +1,997 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+// Headless stand-in for the subset of the Rack SDK used by the DSP code of Venom modules.
+// It is found in place of <rack.hpp> by the headless test build (see test/Makefile), which also
+// defines VENOM_HEADLESS so that the module widgets and context menus are left out.
+// The engine, port, parameter, and DSP helper semantics follow the Rack 2 SDK. Rack's SIMD
+// transcendental functions are approximations, so lanes here use the standard library instead, and
+// renders may differ from a plugin running in Rack by float rounding in those functions.
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <immintrin.h>
+
+#define ENUMS(name, count) name, name ## _LAST = name + (count) - 1
+#define DEBUG(...) do {} while (0)
+#define INFO(...) do {} while (0)
+#define WARN(...) do {} while (0)
+
+// Minimal jansson replacement, enough for module dataToJson() and dataFromJson()
+typedef long long json_int_t;
+struct json_t {
+  enum Type {OBJECT, ARRAY, STRING, INTEGER, REAL, TRUE, FALSE, NUL} type;
+  json_int_t i = 0;
+  double r = 0.0;
+  std::string s;
+  std::vector<std::pair<std::string, json_t*>> obj;
+  std::vector<json_t*> arr;
+  explicit json_t(Type t) : type(t) {}
+  ~json_t() {
+    for (auto& p : obj)
+      delete p.second;
+    for (json_t* a : arr)
+      delete a;
+  }
+};
+struct json_error_t {};
+#define JSON_INDENT(n) (n)
+#define JSON_REAL_PRECISION(n) 0
+inline json_t* json_object() {return new json_t(json_t::OBJECT);}
+inline json_t* json_array() {return new json_t(json_t::ARRAY);}
+inline json_t* json_string(const char* s) {json_t* j = new json_t(json_t::STRING); j->s = s; return j;}
+inline json_t* json_integer(json_int_t i) {json_t* j = new json_t(json_t::INTEGER); j->i = i; return j;}
+inline json_t* json_real(double r) {json_t* j = new json_t(json_t::REAL); j->r = r; return j;}
+inline json_t* json_boolean(bool b) {return new json_t(b ? json_t::TRUE : json_t::FALSE);}
+inline json_t* json_true() {return json_boolean(true);}
+inline json_t* json_false() {return json_boolean(false);}
+inline json_t* json_null() {return new json_t(json_t::NUL);}
+inline void json_decref(json_t* j) {delete j;}
+inline json_t* json_object_get(const json_t* j, const char* key) {
+  if (!j || j->type != json_t::OBJECT)
+    return NULL;
+  for (auto& p : j->obj) {
+    if (p.first == key)
+      return p.second;
+  }
+  return NULL;
+}
+inline int json_object_set_new(json_t* j, const char* key, json_t* val) {
+  for (auto& p : j->obj) {
+    if (p.first == key) {
+      delete p.second;
+      p.second = val;
+      return 0;
+    }
+  }
+  j->obj.push_back(std::make_pair(std::string(key), val));
+  return 0;
+}
+inline size_t json_array_size(const json_t* j) {return j && j->type == json_t::ARRAY ? j->arr.size() : 0;}
+inline json_t* json_array_get(const json_t* j, size_t i) {return i < json_array_size(j) ? j->arr[i] : NULL;}
+inline int json_array_append_new(json_t* j, json_t* val) {j->arr.push_back(val); return 0;}
+inline bool json_is_true(const json_t* j) {return j && j->type == json_t::TRUE;}
+inline bool json_boolean_value(const json_t* j) {return json_is_true(j);}
+inline json_int_t json_integer_value(const json_t* j) {
+  return !j ? 0 : j->type == json_t::INTEGER ? j->i : j->type == json_t::REAL ? static_cast<json_int_t>(j->r) : 0;
+}
+inline double json_real_value(const json_t* j) {return j && j->type == json_t::REAL ? j->r : 0.0;}
+inline double json_number_value(const json_t* j) {
+  return !j ? 0.0 : j->type == json_t::REAL ? j->r : j->type == json_t::INTEGER ? static_cast<double>(j->i) : 0.0;
+}
+inline const char* json_string_value(const json_t* j) {return j && j->type == json_t::STRING ? j->s.c_str() : NULL;}
+inline json_t* json_loadf(FILE*, size_t, json_error_t*) {return NULL;}
+inline int json_dumpf(const json_t*, FILE*, size_t) {return 0;}
+#define json_array_foreach(array, index, value) \
+  for (index = 0; index < json_array_size(array) && (value = json_array_get(array, index)); index++)
+#define json_object_foreach(object, key, value) \
+  for (size_t json_i_ = 0; object && json_i_ < object->obj.size() && \
+       ((key = object->obj[json_i_].first.c_str()), (value = object->obj[json_i_].second), true); json_i_++)
+
+namespace rack {
+
+static const char APP_VERSION[] = "2.6.0";
+
+namespace string {
+inline std::string f(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  char buf[1024];
+  vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  return buf;
+}
+struct Version {
+  std::vector<int> parts;
+  Version(const std::string& s) {
+    int v = 0;
+    for (char c : s) {
+      if (c == '.') {
+        parts.push_back(v);
+        v = 0;
+      }
+      else
+        v = v * 10 + (c - '0');
+    }
+    parts.push_back(v);
+  }
+  bool operator<(const Version& other) const {return parts < other.parts;}
+};
+}
+
+namespace asset {
+inline std::string user(const std::string&) {return "";}
+inline std::string system(const std::string& f) {return f;}
+}
+
+namespace random {
+struct Xoroshiro128Plus {
+  uint64_t state[2] = {};
+  void seed(uint64_t s0, uint64_t s1) {
+    state[0] = s0;
+    state[1] = s1;
+    operator()();
+  }
+  bool isSeeded() {return state[0] || state[1];}
+  static uint64_t rotl(uint64_t x, int k) {return (x << k) | (x >> (64 - k));}
+  uint64_t operator()() {
+    uint64_t s0 = state[0];
+    uint64_t s1 = state[1];
+    uint64_t result = s0 + s1;
+    s1 ^= s0;
+    state[0] = rotl(s0, 55) ^ s1 ^ (s1 << 14);
+    state[1] = rotl(s1, 36);
+    return result;
+  }
+  constexpr uint64_t min() const {return 0;}
+  constexpr uint64_t max() const {return UINT64_MAX;}
+};
+// The test harness reseeds this before every scenario so that module constructors are reproducible
+inline Xoroshiro128Plus& local() {
+  static thread_local Xoroshiro128Plus rng;
+  return rng;
+}
+inline void init(uint64_t s0 = 1, uint64_t s1 = 2) {local().seed(s0, s1);}
+inline uint64_t u64() {return local()();}
+inline uint32_t u32() {return u64() >> 32;}
+inline float uniform() {return (u32() >> 8) * 5.9604645e-08f;}
+inline float normal() {
+  const float radius = std::sqrt(-2.f * std::log(1.f - uniform()));
+  const float theta = 2.f * M_PI * uniform();
+  return radius * std::sin(theta);
+}
+}
+
+namespace simd {
+struct float_4 {
+  union {
+    __m128 v;
+    float s[4];
+  };
+  float_4() = default;
+  float_4(__m128 v) : v(v) {}
+  float_4(float x) : v(_mm_set1_ps(x)) {}
+  float_4(float x1, float x2, float x3, float x4) : v(_mm_setr_ps(x1, x2, x3, x4)) {}
+  static constexpr int size = 4;
+  static float_4 zero() {return float_4(_mm_setzero_ps());}
+  static float_4 mask() {return float_4(_mm_castsi128_ps(_mm_set1_epi32(-1)));}
+  static float_4 load(const float* x) {return float_4(_mm_loadu_ps(x));}
+  void store(float* x) const {_mm_storeu_ps(x, v);}
+  float& operator[](int i) {return s[i];}
+  const float& operator[](int i) const {return s[i];}
+};
+
+#define VENOM_HEADLESS_OP(op, intrinsic) \
+  inline float_4 operator op(const float_4& a, const float_4& b) {return float_4(intrinsic(a.v, b.v));} \
+  inline float_4 operator op(const float_4& a, float b) {return a op float_4(b);} \
+  inline float_4 operator op(float a, const float_4& b) {return float_4(a) op b;}
+VENOM_HEADLESS_OP(+, _mm_add_ps)
+VENOM_HEADLESS_OP(-, _mm_sub_ps)
+VENOM_HEADLESS_OP(*, _mm_mul_ps)
+VENOM_HEADLESS_OP(/, _mm_div_ps)
+VENOM_HEADLESS_OP(==, _mm_cmpeq_ps)
+VENOM_HEADLESS_OP(!=, _mm_cmpneq_ps)
+VENOM_HEADLESS_OP(<, _mm_cmplt_ps)
+VENOM_HEADLESS_OP(>, _mm_cmpgt_ps)
+VENOM_HEADLESS_OP(<=, _mm_cmple_ps)
+VENOM_HEADLESS_OP(>=, _mm_cmpge_ps)
+VENOM_HEADLESS_OP(&, _mm_and_ps)
+VENOM_HEADLESS_OP(|, _mm_or_ps)
+VENOM_HEADLESS_OP(^, _mm_xor_ps)
+#undef VENOM_HEADLESS_OP
+#define VENOM_HEADLESS_ASSIGN(op) \
+  inline float_4& operator op##=(float_4& a, const float_4& b) {a = a op b; return a;} \
+  inline float_4& operator op##=(float_4& a, float b) {a = a op float_4(b); return a;}
+VENOM_HEADLESS_ASSIGN(+)
+VENOM_HEADLESS_ASSIGN(-)
+VENOM_HEADLESS_ASSIGN(*)
+VENOM_HEADLESS_ASSIGN(/)
+VENOM_HEADLESS_ASSIGN(&)
+VENOM_HEADLESS_ASSIGN(|)
+VENOM_HEADLESS_ASSIGN(^)
+#undef VENOM_HEADLESS_ASSIGN
+inline float_4 operator+(const float_4& a) {return a;}
+inline float_4 operator-(const float_4& a) {return 0.f - a;}
+inline float_4 operator~(const float_4& a) {return a ^ float_4::mask();}
+inline float_4& operator++(float_4& a) {a += 1.f; return a;}
+inline float_4& operator--(float_4& a) {a -= 1.f; return a;}
+
+inline float_4 ifelse(const float_4& mask, const float_4& a, const float_4& b) {
+  return float_4(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+}
+template <typename T>
+T ifelse(bool cond, T a, T b) {return cond ? a : b;}
+inline int movemask(const float_4& a) {return _mm_movemask_ps(a.v);}
+
+inline float_4 fmin(const float_4& a, const float_4& b) {return float_4(_mm_min_ps(a.v, b.v));}
+inline float_4 fmax(const float_4& a, const float_4& b) {return float_4(_mm_max_ps(a.v, b.v));}
+inline float_4 clamp(const float_4& x, const float_4& a = 0.f, const float_4& b = 1.f) {return fmin(fmax(x, a), b);}
+inline float_4 abs(const float_4& x) {return float_4(_mm_andnot_ps(_mm_set1_ps(-0.f), x.v));}
+inline float_4 fabs(const float_4& x) {return abs(x);}
+inline float_4 sgn(const float_4& x) {
+  float_4 signbit = x & -0.f;
+  float_4 nonzero = x != 0.f;
+  return signbit | (nonzero & 1.f);
+}
+inline float_4 floor(const float_4& x) {return float_4(_mm_floor_ps(x.v));}
+inline float_4 ceil(const float_4& x) {return float_4(_mm_ceil_ps(x.v));}
+inline float_4 trunc(const float_4& x) {return float_4(_mm_round_ps(x.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));}
+inline float_4 round(const float_4& x) {
+  float_4 sign = x & -0.f;
+  return trunc(x + (sign | 0.5f));
+}
+inline float_4 sqrt(const float_4& x) {return float_4(_mm_sqrt_ps(x.v));}
+inline float_4 fmod(const float_4& a, const float_4& b) {return a - trunc(a / b) * b;}
+inline float_4 rescale(const float_4& x, float xMin, float xMax, float yMin, float yMax) {
+  return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+}
+inline float_4 crossfade(const float_4& a, const float_4& b, const float_4& p) {return a + (b - a) * p;}
+
+#define VENOM_HEADLESS_LANES(name) \
+  inline float_4 name(const float_4& x) { \
+    float_4 y; \
+    for (int i=0; i<4; i++) \
+      y.s[i] = std::name(x.s[i]); \
+    return y; \
+  }
+VENOM_HEADLESS_LANES(sin)
+VENOM_HEADLESS_LANES(cos)
+VENOM_HEADLESS_LANES(tan)
+VENOM_HEADLESS_LANES(atan)
+VENOM_HEADLESS_LANES(exp)
+VENOM_HEADLESS_LANES(log)
+VENOM_HEADLESS_LANES(log2)
+VENOM_HEADLESS_LANES(log10)
+VENOM_HEADLESS_LANES(tanh)
+#undef VENOM_HEADLESS_LANES
+inline float_4 pow(const float_4& a, const float_4& b) {
+  float_4 y;
+  for (int i=0; i<4; i++)
+    y.s[i] = std::pow(a.s[i], b.s[i]);
+  return y;
+}
+inline float_4 pow(float a, const float_4& b) {return pow(float_4(a), b);}
+inline float_4 pow(const float_4& a, float b) {return pow(a, float_4(b));}
+
+// Scalar overloads, as in Rack, so that templates work for both float and float_4
+using std::fmin;
+using std::fmax;
+using std::fabs;
+using std::floor;
+using std::ceil;
+using std::trunc;
+using std::round;
+using std::sqrt;
+using std::fmod;
+using std::sin;
+using std::cos;
+using std::tan;
+using std::atan;
+using std::exp;
+using std::log;
+using std::log2;
+using std::log10;
+using std::tanh;
+using std::pow;
+inline float abs(float x) {return std::fabs(x);}
+inline float clamp(float x, float a = 0.f, float b = 1.f) {return std::fmax(std::fmin(x, b), a);}
+inline float sgn(float x) {return x > 0.f ? 1.f : x < 0.f ? -1.f : 0.f;}
+inline float rescale(float x, float xMin, float xMax, float yMin, float yMax) {
+  return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+}
+inline float crossfade(float a, float b, float p) {return a + (b - a) * p;}
+}
+
+namespace math {
+inline int clamp(int x, int a, int b) {return std::max(std::min(x, b), a);}
+inline float clamp(float x, float a = 0.f, float b = 1.f) {return std::fmax(std::fmin(x, b), a);}
+inline float clampSafe(float x, float a = 0.f, float b = 1.f) {return (a <= b) ? clamp(x, a, b) : clamp(x, b, a);}
+inline float sgn(float x) {return x > 0.f ? 1.f : x < 0.f ? -1.f : 0.f;}
+inline float log2(float x) {return std::log2(x);}
+inline int log2(int n) {
+  int i = 0;
+  while (n >>= 1)
+    i++;
+  return i;
+}
+inline bool isPow2(int n) {return n > 0 && (n & (n - 1)) == 0;}
+inline float rescale(float x, float xMin, float xMax, float yMin, float yMax) {
+  return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+}
+inline float crossfade(float a, float b, float p) {return a + (b - a) * p;}
+inline int eucMod(int a, int b) {
+  int mod = a % b;
+  return mod < 0 ? mod + b : mod;
+}
+inline float eucMod(float a, float b) {
+  float mod = std::fmod(a, b);
+  return mod < 0.f ? mod + b : mod;
+}
+inline bool isNear(float a, float b, float epsilon = 1e-6f) {return std::fabs(a - b) <= epsilon;}
+struct Vec {
+  float x = 0.f, y = 0.f;
+  Vec() {}
+  Vec(float x, float y) : x(x), y(y) {}
+};
+}
+
+namespace dsp {
+static const float FREQ_C4 = 261.6256f;
+
+template <typename T>
+T exp2_taylor5(T x) {
+  x = simd::clamp(x, -126.f, 126.f);
+  T xi = simd::floor(x);
+  T xf = x - xi;
+  T yi;
+  for (int i=0; i<T::size; i++)
+    yi.s[i] = std::ldexp(1.f, static_cast<int>(xi.s[i]));
+  T yf = 1.f + xf * (0.69315169353961f + xf * (0.2401595528668f + xf * (0.055817310687f
+         + xf * (0.008991835f + xf * 0.0018775767f))));
+  return yi * yf;
+}
+inline float exp2_taylor5(float x) {
+  x = math::clamp(x, -126.f, 126.f);
+  float xi = std::floor(x);
+  float xf = x - xi;
+  float yf = 1.f + xf * (0.69315169353961f + xf * (0.2401595528668f + xf * (0.055817310687f
+             + xf * (0.008991835f + xf * 0.0018775767f))));
+  return std::ldexp(1.f, static_cast<int>(xi)) * yf;
+}
+
+template <typename T = float>
+struct TBiquadFilter {
+  T x[2];
+  T y[2];
+  float b[3];
+  float a[2];
+  enum Type {LOWPASS_1POLE, HIGHPASS_1POLE, LOWPASS, HIGHPASS, LOWSHELF, HIGHSHELF, BANDPASS, PEAK, NOTCH, NUM_TYPES};
+  TBiquadFilter() {
+    setParameters(LOWPASS, 0.f, 0.f, 1.f);
+    reset();
+  }
+  void reset() {
+    x[0] = x[1] = y[0] = y[1] = T(0.f);
+  }
+  T process(T in) {
+    T out = b[0] * in + b[1] * x[0] + b[2] * x[1] - a[0] * y[0] - a[1] * y[1];
+    x[1] = x[0];
+    x[0] = in;
+    y[1] = y[0];
+    y[0] = out;
+    return out;
+  }
+  void setParameters(Type type, float f, float Q, float V) {
+    float K = std::tan(M_PI * f);
+    float norm = 1.f / (1.f + K / Q + K * K);
+    switch (type) {
+      case LOWPASS_1POLE:
+        a[0] = -std::exp(-2.f * M_PI * f);
+        a[1] = 0.f;
+        b[0] = 1.f + a[0];
+        b[1] = b[2] = 0.f;
+        break;
+      case HIGHPASS_1POLE:
+        a[0] = std::exp(-2.f * M_PI * (0.5f - f));
+        a[1] = 0.f;
+        b[0] = 1.f - a[0];
+        b[1] = b[2] = 0.f;
+        break;
+      case HIGHPASS:
+        b[0] = norm;
+        b[1] = -2.f * b[0];
+        b[2] = b[0];
+        a[0] = 2.f * (K * K - 1.f) * norm;
+        a[1] = (1.f - K / Q + K * K) * norm;
+        break;
+      case BANDPASS:
+        b[0] = K / Q * norm;
+        b[1] = 0.f;
+        b[2] = -b[0];
+        a[0] = 2.f * (K * K - 1.f) * norm;
+        a[1] = (1.f - K / Q + K * K) * norm;
+        break;
+      case NOTCH:
+        b[0] = (1.f + K * K) * norm;
+        b[1] = 2.f * (K * K - 1.f) * norm;
+        b[2] = b[0];
+        a[0] = b[1];
+        a[1] = (1.f - K / Q + K * K) * norm;
+        break;
+      default: // LOWPASS, and the shelf and peak types that Venom does not use
+        b[0] = K * K * norm;
+        b[1] = 2.f * b[0];
+        b[2] = b[0];
+        a[0] = 2.f * (K * K - 1.f) * norm;
+        a[1] = (1.f - K / Q + K * K) * norm;
+    }
+  }
+};
+typedef TBiquadFilter<> BiquadFilter;
+
+struct SchmittTrigger {
+  bool state = true;
+  enum Event {NONE = 0, TRIGGERED = 1, UNTRIGGERED = -1};
+  void reset() {state = true;}
+  bool process(float in, float lowThreshold = 0.f, float highThreshold = 1.f) {
+    if (state) {
+      if (in <= lowThreshold)
+        state = false;
+    }
+    else if (in >= highThreshold) {
+      state = true;
+      return true;
+    }
+    return false;
+  }
+  Event processEvent(float in, float lowThreshold = 0.f, float highThreshold = 1.f) {
+    if (state) {
+      if (in <= lowThreshold) {
+        state = false;
+        return UNTRIGGERED;
+      }
+    }
+    else if (in >= highThreshold) {
+      state = true;
+      return TRIGGERED;
+    }
+    return NONE;
+  }
+  bool isHigh() {return state;}
+};
+
+struct PulseGenerator {
+  float remaining = 0.f;
+  void reset() {remaining = 0.f;}
+  bool process(float deltaTime) {
+    if (remaining > 0.f) {
+      remaining -= deltaTime;
+      return true;
+    }
+    return false;
+  }
+  void trigger(float duration = 1e-3f) {
+    if (duration > remaining)
+      remaining = duration;
+  }
+};
+
+template <typename T = float>
+struct TSlewLimiter {
+  T out = 0.f;
+  T rise = 0.f;
+  T fall = 0.f;
+  void reset() {out = 0.f;}
+  void setRiseFall(T rise, T fall) {
+    this->rise = rise;
+    this->fall = fall;
+  }
+  T process(T deltaTime, T in) {
+    out = simd::clamp(in, out - fall * deltaTime, out + rise * deltaTime);
+    return out;
+  }
+};
+typedef TSlewLimiter<> SlewLimiter;
+
+struct ClockDivider {
+  uint32_t clock = 0;
+  uint32_t division = 1;
+  void reset() {clock = 0;}
+  void setDivision(uint32_t division) {this->division = division;}
+  uint32_t getDivision() {return division;}
+  uint32_t getClock() {return clock;}
+  bool process() {
+    clock++;
+    if (clock >= division) {
+      clock = 0;
+      return true;
+    }
+    return false;
+  }
+};
+
+// Same layout as Rack's pffft based RealFFT: the ordered spectrum holds DC, Nyquist, then real and
+// imaginary pairs, and neither direction is normalized
+struct RealFFT {
+  size_t length;
+  RealFFT(size_t length) : length(length) {}
+  static void fft(std::vector<std::complex<double>>& a, bool inverse) {
+    size_t n = a.size();
+    for (size_t i=1, j=0; i<n; i++) {
+      size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+        j ^= bit;
+      j ^= bit;
+      if (i < j)
+        std::swap(a[i], a[j]);
+    }
+    for (size_t len=2; len<=n; len<<=1) {
+      double ang = 2.0 * M_PI / len * (inverse ? 1.0 : -1.0);
+      std::complex<double> wl(std::cos(ang), std::sin(ang));
+      for (size_t i=0; i<n; i+=len) {
+        std::complex<double> w(1.0);
+        for (size_t j=0; j<len/2; j++) {
+          std::complex<double> u = a[i+j], v = a[i+j+len/2] * w;
+          a[i+j] = u + v;
+          a[i+j+len/2] = u - v;
+          w *= wl;
+        }
+      }
+    }
+  }
+  void rfft(const float* input, float* output) {
+    std::vector<std::complex<double>> a(input, input + length);
+    fft(a, false);
+    output[0] = a[0].real();
+    output[1] = a[length/2].real();
+    for (size_t k=1; k<length/2; k++) {
+      output[2*k] = a[k].real();
+      output[2*k+1] = a[k].imag();
+    }
+  }
+  void irfft(const float* input, float* output) {
+    std::vector<std::complex<double>> a(length);
+    a[0] = input[0];
+    a[length/2] = input[1];
+    for (size_t k=1; k<length/2; k++) {
+      a[k] = std::complex<double>(input[2*k], input[2*k+1]);
+      a[length-k] = std::conj(a[k]);
+    }
+    fft(a, true);
+    for (size_t i=0; i<length; i++)
+      output[i] = a[i].real();
+  }
+};
+}
+
+namespace engine {
+static const int PORT_MAX_CHANNELS = 16;
+
+struct Param {
+  float value = 0.f;
+  float getValue() {return value;}
+  void setValue(float value) {this->value = value;}
+};
+
+struct Light {
+  float value = 0.f;
+  void setBrightness(float brightness) {value = brightness;}
+  float getBrightness() {return value;}
+  void setBrightnessSmooth(float brightness, float deltaTime, float lambda = 30.f) {
+    if (brightness < value)
+      value += (brightness - value) * lambda * deltaTime;
+    else
+      value = brightness;
+  }
+};
+
+struct Port {
+  float voltages[PORT_MAX_CHANNELS] = {};
+  uint8_t channels = 0;
+  enum Type {INPUT, OUTPUT};
+
+  void setVoltage(float voltage, int channel = 0) {voltages[channel] = voltage;}
+  float getVoltage(int channel = 0) {return voltages[channel];}
+  float getPolyVoltage(int channel) {return isMonophonic() ? getVoltage(0) : getVoltage(channel);}
+  float getNormalVoltage(float normalVoltage, int channel = 0) {return isConnected() ? getVoltage(channel) : normalVoltage;}
+  float getNormalPolyVoltage(float normalVoltage, int channel) {return isConnected() ? getPolyVoltage(channel) : normalVoltage;}
+  float* getVoltages(int firstChannel = 0) {return &voltages[firstChannel];}
+  float getVoltageSum() {
+    float sum = 0.f;
+    for (int c=0; c<channels; c++)
+      sum += voltages[c];
+    return sum;
+  }
+  template <typename T>
+  T getVoltageSimd(int firstChannel) {return T::load(&voltages[firstChannel]);}
+  template <typename T>
+  T getPolyVoltageSimd(int firstChannel) {return isMonophonic() ? T(getVoltage(0)) : getVoltageSimd<T>(firstChannel);}
+  template <typename T>
+  T getNormalVoltageSimd(T normalVoltage, int firstChannel) {return isConnected() ? getVoltageSimd<T>(firstChannel) : normalVoltage;}
+  template <typename T>
+  T getNormalPolyVoltageSimd(T normalVoltage, int firstChannel) {return isConnected() ? getPolyVoltageSimd<T>(firstChannel) : normalVoltage;}
+  template <typename T>
+  void setVoltageSimd(T voltage, int firstChannel) {voltage.store(&voltages[firstChannel]);}
+  void setChannels(int channels) {
+    // a disconnected output keeps 0 channels
+    if (this->channels == 0)
+      return;
+    if (channels == 0)
+      channels = 1;
+    channels = std::min(std::max(channels, 1), PORT_MAX_CHANNELS);
+    for (int c=channels; c<this->channels; c++)
+      voltages[c] = 0.f;
+    this->channels = channels;
+  }
+  int getChannels() {return channels;}
+  bool isConnected() {return channels > 0;}
+  bool isMonophonic() {return channels == 1;}
+  bool isPolyphonic() {return channels > 1;}
+};
+struct Input : Port {};
+struct Output : Port {};
+
+struct Module;
+
+struct ParamQuantity {
+  Module* module = NULL;
+  int paramId = -1;
+  float minValue = 0.f;
+  float maxValue = 1.f;
+  float defaultValue = 0.f;
+  std::string name;
+  std::string unit;
+  float displayBase = 0.f;
+  float displayMultiplier = 1.f;
+  float displayOffset = 0.f;
+  int displayPrecision = 5;
+  std::string description;
+  bool resetEnabled = true;
+  bool randomizeEnabled = true;
+  bool smoothEnabled = false;
+  bool snapEnabled = false;
+  virtual ~ParamQuantity() {}
+  Param* getParam();
+  virtual void setValue(float value);
+  virtual float getValue();
+  void setImmediateValue(float value) {setValue(value);}
+  float getImmediateValue() {return getValue();}
+  float getMinValue() {return minValue;}
+  float getMaxValue() {return maxValue;}
+  float getDefaultValue() {return defaultValue;}
+  virtual float getDisplayValue() {return getValue() * displayMultiplier + displayOffset;}
+  virtual void setDisplayValue(float displayValue) {setValue((displayValue - displayOffset) / displayMultiplier);}
+  virtual std::string getDisplayValueString() {return string::f("%g", getDisplayValue());}
+  virtual void setDisplayValueString(std::string s) {setDisplayValue(std::atof(s.c_str()));}
+  virtual std::string getLabel() {return name;}
+  virtual std::string getUnit() {return unit;}
+  virtual std::string getString() {return getLabel() + ": " + getDisplayValueString() + getUnit();}
+  virtual std::string getDescription() {return description;}
+  virtual void reset() {setValue(defaultValue);}
+  virtual void randomize() {}
+};
+
+struct SwitchQuantity : ParamQuantity {
+  std::vector<std::string> labels;
+};
+
+struct PortInfo {
+  Module* module = NULL;
+  Port::Type type = Port::INPUT;
+  int portId = -1;
+  std::string name;
+  std::string description;
+  virtual ~PortInfo() {}
+  virtual std::string getName() {return name;}
+};
+
+struct LightInfo {
+  Module* module = NULL;
+  int lightId = -1;
+  std::string name;
+  std::string description;
+  virtual ~LightInfo() {}
+};
+}
+
+namespace plugin {
+struct Model {
+  std::string slug;
+  Model(const std::string& slug = "") : slug(slug) {}
+};
+struct Plugin {
+  std::string slug;
+};
+}
+
+namespace engine {
+struct Module {
+  plugin::Model* model = NULL;
+  int64_t id = -1;
+  std::vector<Param> params;
+  std::vector<Input> inputs;
+  std::vector<Output> outputs;
+  std::vector<Light> lights;
+  std::vector<ParamQuantity*> paramQuantities;
+  std::vector<PortInfo*> inputInfos;
+  std::vector<PortInfo*> outputInfos;
+  std::vector<LightInfo*> lightInfos;
+
+  struct Expander {
+    int64_t moduleId = -1;
+    Module* module = NULL;
+    void* producerMessage = NULL;
+    void* consumerMessage = NULL;
+    void requestMessageFlip() {std::swap(producerMessage, consumerMessage);}
+  };
+  Expander leftExpander;
+  Expander rightExpander;
+
+  struct BypassRoute {
+    int inputId = -1;
+    int outputId = -1;
+  };
+  std::vector<BypassRoute> bypassRoutes;
+  bool bypassed = false;
+
+  Module() {}
+  virtual ~Module() {
+    for (ParamQuantity* q : paramQuantities)
+      delete q;
+    for (PortInfo* i : inputInfos)
+      delete i;
+    for (PortInfo* o : outputInfos)
+      delete o;
+    for (LightInfo* l : lightInfos)
+      delete l;
+  }
+  Module(const Module&) = delete;
+  Module& operator=(const Module&) = delete;
+
+  void config(int numParams, int numInputs, int numOutputs, int numLights = 0) {
+    params.resize(numParams);
+    inputs.resize(numInputs);
+    outputs.resize(numOutputs);
+    lights.resize(numLights);
+    paramQuantities.resize(numParams);
+    for (int i=0; i<numParams; i++)
+      configParam(i, 0.f, 1.f, 0.f);
+    inputInfos.resize(numInputs);
+    for (int i=0; i<numInputs; i++)
+      configInput(i);
+    outputInfos.resize(numOutputs);
+    for (int i=0; i<numOutputs; i++)
+      configOutput(i);
+    lightInfos.resize(numLights);
+  }
+
+  template <class TParamQuantity = ParamQuantity>
+  TParamQuantity* configParam(int paramId, float minValue, float maxValue, float defaultValue, std::string name = "",
+                              std::string unit = "", float displayBase = 0.f, float displayMultiplier = 1.f,
+                              float displayOffset = 0.f) {
+    delete paramQuantities[paramId];
+    TParamQuantity* q = new TParamQuantity;
+    q->module = this;
+    q->paramId = paramId;
+    q->minValue = minValue;
+    q->maxValue = maxValue;
+    q->defaultValue = defaultValue;
+    q->name = name;
+    q->unit = unit;
+    q->displayBase = displayBase;
+    q->displayMultiplier = displayMultiplier;
+    q->displayOffset = displayOffset;
+    paramQuantities[paramId] = q;
+    params[paramId].value = q->getDefaultValue();
+    return q;
+  }
+
+  template <class TSwitchQuantity = SwitchQuantity>
+  TSwitchQuantity* configSwitch(int paramId, float minValue, float maxValue, float defaultValue, std::string name = "",
+                                std::vector<std::string> labels = {}) {
+    TSwitchQuantity* sq = configParam<TSwitchQuantity>(paramId, minValue, maxValue, defaultValue, name);
+    sq->snapEnabled = true;
+    sq->smoothEnabled = false;
+    sq->labels = labels;
+    return sq;
+  }
+
+  template <class TSwitchQuantity = SwitchQuantity>
+  TSwitchQuantity* configButton(int paramId, std::string name = "") {
+    TSwitchQuantity* sq = configParam<TSwitchQuantity>(paramId, 0.f, 1.f, 0.f, name);
+    sq->randomizeEnabled = false;
+    sq->snapEnabled = true;
+    return sq;
+  }
+
+  template <class TPortInfo = PortInfo>
+  TPortInfo* configInput(int portId, std::string name = "") {
+    delete inputInfos[portId];
+    TPortInfo* info = new TPortInfo;
+    info->module = this;
+    info->type = Port::INPUT;
+    info->portId = portId;
+    info->name = name;
+    inputInfos[portId] = info;
+    return info;
+  }
+
+  template <class TPortInfo = PortInfo>
+  TPortInfo* configOutput(int portId, std::string name = "") {
+    delete outputInfos[portId];
+    TPortInfo* info = new TPortInfo;
+    info->module = this;
+    info->type = Port::OUTPUT;
+    info->portId = portId;
+    info->name = name;
+    outputInfos[portId] = info;
+    return info;
+  }
+
+  template <class TLightInfo = LightInfo>
+  TLightInfo* configLight(int lightId, std::string name = "") {
+    delete lightInfos[lightId];
+    TLightInfo* info = new TLightInfo;
+    info->module = this;
+    info->lightId = lightId;
+    info->name = name;
+    lightInfos[lightId] = info;
+    return info;
+  }
+
+  void configBypass(int inputId, int outputId) {
+    BypassRoute br;
+    br.inputId = inputId;
+    br.outputId = outputId;
+    bypassRoutes.push_back(br);
+  }
+
+  int getNumParams() {return params.size();}
+  Param& getParam(int index) {return params[index];}
+  int getNumInputs() {return inputs.size();}
+  Input& getInput(int index) {return inputs[index];}
+  int getNumOutputs() {return outputs.size();}
+  Output& getOutput(int index) {return outputs[index];}
+  int getNumLights() {return lights.size();}
+  Light& getLight(int index) {return lights[index];}
+  ParamQuantity* getParamQuantity(int index) {return paramQuantities[index];}
+  PortInfo* getInputInfo(int index) {return inputInfos[index];}
+  PortInfo* getOutputInfo(int index) {return outputInfos[index];}
+  LightInfo* getLightInfo(int index) {return lightInfos[index];}
+  Expander& getLeftExpander() {return leftExpander;}
+  Expander& getRightExpander() {return rightExpander;}
+  int64_t getId() {return id;}
+  plugin::Model* getModel() {return model;}
+  bool isBypassed() {return bypassed;}
+
+  struct ProcessArgs {
+    float sampleRate = 48000.f;
+    float sampleTime = 1.f / 48000.f;
+    int64_t frame = 0;
+  };
+  virtual void process(const ProcessArgs& args) {}
+  virtual void processBypass(const ProcessArgs& args) {
+    for (BypassRoute& br : bypassRoutes) {
+      Input& in = inputs[br.inputId];
+      Output& out = outputs[br.outputId];
+      int channels = in.getChannels();
+      for (int c=0; c<channels; c++)
+        out.setVoltage(in.getVoltage(c), c);
+      out.setChannels(channels);
+    }
+  }
+
+  virtual json_t* toJson() {return dataToJson();}
+  virtual void fromJson(json_t* rootJ) {dataFromJson(rootJ);}
+  virtual json_t* dataToJson() {return NULL;}
+  virtual void dataFromJson(json_t* rootJ) {}
+
+  struct AddEvent {};
+  virtual void onAdd(const AddEvent& e) {onAdd();}
+  virtual void onAdd() {}
+  struct RemoveEvent {};
+  virtual void onRemove(const RemoveEvent& e) {onRemove();}
+  virtual void onRemove() {}
+  struct BypassEvent {};
+  virtual void onBypass(const BypassEvent& e) {}
+  struct UnBypassEvent {};
+  virtual void onUnBypass(const UnBypassEvent& e) {}
+  struct PortChangeEvent {
+    bool connecting;
+    Port::Type type;
+    int portId;
+  };
+  virtual void onPortChange(const PortChangeEvent& e) {}
+  struct SampleRateChangeEvent {
+    float sampleRate;
+    float sampleTime;
+  };
+  virtual void onSampleRateChange(const SampleRateChangeEvent& e) {onSampleRateChange();}
+  virtual void onSampleRateChange() {}
+  struct ExpanderChangeEvent {
+    uint8_t side;
+  };
+  virtual void onExpanderChange(const ExpanderChangeEvent& e) {}
+  struct ResetEvent {};
+  virtual void onReset(const ResetEvent& e) {
+    for (ParamQuantity* q : paramQuantities) {
+      if (q->resetEnabled)
+        q->reset();
+    }
+    onReset();
+  }
+  virtual void onReset() {}
+  struct RandomizeEvent {};
+  virtual void onRandomize(const RandomizeEvent& e) {onRandomize();}
+  virtual void onRandomize() {}
+  struct SaveEvent {};
+  virtual void onSave(const SaveEvent& e) {}
+};
+
+inline Param* ParamQuantity::getParam() {return module ? &module->params[paramId] : NULL;}
+inline void ParamQuantity::setValue(float value) {
+  if (!module)
+    return;
+  value = math::clampSafe(value, getMinValue(), getMaxValue());
+  if (snapEnabled)
+    value = std::round(value);
+  module->params[paramId].setValue(value);
+}
+inline float ParamQuantity::getValue() {return module ? module->params[paramId].getValue() : 0.f;}
+
+struct Engine {
+  float sampleRate = 48000.f;
+  float getSampleRate() {return sampleRate;}
+};
+}
+
+// Widgets are left out of the headless build, so a module's widget pointers stay NULL
+namespace app {
+struct Knob {
+  bool snap = false;
+  bool smooth = true;
+  engine::ParamQuantity* getParamQuantity() {return NULL;}
+};
+}
+
+struct Context {
+  engine::Engine* engine;
+};
+inline Context* contextGet() {
+  static engine::Engine engine;
+  static Context context{&engine};
+  return &context;
+}
+#define APP rack::contextGet()
+
+using namespace math;
+using namespace engine;
+using namespace app;
+using plugin::Model;
+using plugin::Plugin;
+using math::Vec;
+}
+
+inline void* pffft_aligned_malloc(size_t nb_bytes) {
+  void* p = NULL;
+  if (posix_memalign(&p, 64, nb_bytes))
+    return NULL;
+  return p;
+}
+inline void pffft_aligned_free(void* p) {free(p);}
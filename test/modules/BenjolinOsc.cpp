@@ -0,0 +1,58 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/BenjolinOsc.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::BenjolinOsc;
+
+// Benjolin Oscillator with the OVER option index over and channels of polyphony
+BenjolinOsc* benjolin(int over, int channels = 1) {
+  BenjolinOsc* m = create<BenjolinOsc>(modelVenomBenjolinOsc);
+  m->params[BenjolinOsc::OVER_PARAM].setValue(over);
+  m->params[BenjolinOsc::FREQ1_PARAM].setValue(1.f);
+  m->params[BenjolinOsc::FREQ2_PARAM].setValue(-2.f);
+  m->params[BenjolinOsc::RUNG1_PARAM].setValue(0.3f);
+  m->params[BenjolinOsc::RUNG2_PARAM].setValue(0.2f);
+  m->polyChannels = channels;
+  for (int o=0; o<BenjolinOsc::OUTPUTS_LEN; o++)
+    connectOutput(m, o);
+  return m;
+}
+
+// The rungler makes the waveform chaotic, so runs are compared by their statistics over half a second
+Scenario statistics(const std::string& name, std::function<Module*()> create) {
+  Scenario s;
+  s.name = "BenjolinOsc." + name;
+  s.kind = Scenario::STATISTICS;
+  s.create = create;
+  s.outputs = {BenjolinOsc::TRI1_OUTPUT, BenjolinOsc::TRI2_OUTPUT, BenjolinOsc::PULSE1_OUTPUT,
+               BenjolinOsc::XOR_OUTPUT, BenjolinOsc::PWM_OUTPUT, BenjolinOsc::RUNG_OUTPUT};
+  s.frames = 24000;
+  s.tolerance = 0.15f;
+  return s;
+}
+
+void registerBenjolinOsc() {
+  std::vector<Scenario>& list = scenarios();
+  list.push_back(statistics("x1", [] {return benjolin(0);}));
+  list.push_back(statistics("x4", [] {return benjolin(2);}));
+  list.push_back(statistics("x2-poly3", [] {return benjolin(1, 3);}));
+
+  Benchmark b;
+  b.module = "BenjolinOsc";
+  b.oversample = {1, 2, 4, 8, 16, 32};
+  b.create = [] {return benjolin(0);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[BenjolinOsc::OVER_PARAM].setValue(math::log2(over));
+    static_cast<BenjolinOsc*>(m)->polyChannels = channels;
+  };
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerBenjolinOsc);
+
+}
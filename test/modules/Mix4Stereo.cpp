@@ -0,0 +1,76 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/Mix4Stereo.cpp"
+
+// Defined by Mix4.cpp in the plugin; the mixer scenarios share it with VCAMix4Stereo
+namespace Venom {
+std::atomic<int> mixChainVersion{0};
+}
+
+namespace {
+
+using namespace VenomTest;
+using Venom::Mix4Stereo;
+
+// Mix 4 Stereo with the given clip option and DC blocking before and after clipping, mixing a hot sine,
+// saw and square pair of channels on each input
+Mix4Stereo* mixer(int clip, int channels = 1) {
+  Mix4Stereo* m = create<Mix4Stereo>(modelVenomMix4Stereo);
+  m->params[Mix4Stereo::CLIP_PARAM].setValue(clip);
+  m->params[Mix4Stereo::DCBLOCK_PARAM].setValue(2.f);
+  m->params[Mix4Stereo::MIX_LEVEL_PARAM].setValue(1.5f);
+  m->params[Mix4Stereo::LEVEL_PARAMS + 2].setValue(0.5f);
+  connectOutput(m, Mix4Stereo::LEFT_OUTPUT);
+  connectOutput(m, Mix4Stereo::RIGHT_OUTPUT);
+  for (int i=0; i<3; i++) {
+    connectInput(m, Mix4Stereo::LEFT_INPUT + i, channels);
+    connectInput(m, Mix4Stereo::RIGHT_INPUT + i, channels);
+  }
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  for (int i=0; i<3; i++) {
+    double freq = 110.0 * (i + 1.5);
+    setPoly(m, Mix4Stereo::LEFT_INPUT + i, [f, freq](int c) {return sine(freq * (1.0 + 0.07 * c), f) + 1.f;});
+    setPoly(m, Mix4Stereo::RIGHT_INPUT + i, [f, freq, i](int c) {return i ? square(freq * (1.0 + 0.07 * c), f) : saw(freq, f);});
+  }
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, int frames = 1024) {
+  Scenario s;
+  s.name = "Mix4Stereo." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = {Mix4Stereo::LEFT_OUTPUT, Mix4Stereo::RIGHT_OUTPUT};
+  s.frames = frames;
+  s.tolerance = 1e-3f;
+  return s;
+}
+
+void registerMix4Stereo() {
+  std::vector<Scenario>& list = scenarios();
+  list.push_back(waveform("hard-clip", [] {return mixer(1);}));
+  list.push_back(waveform("soft-clip-x4", [] {return mixer(3);}));
+  list.push_back(waveform("saturate-poly5", [] {return mixer(7, 5);}, 512));
+
+  // The oversampled clip options are fixed at x4
+  Benchmark b;
+  b.module = "Mix4Stereo";
+  b.oversample = {4};
+  b.create = [] {return mixer(3);};
+  b.setup = [](Module* m, int over, int channels) {
+    for (int i=0; i<3; i++) {
+      connectInput(m, Mix4Stereo::LEFT_INPUT + i, channels);
+      connectInput(m, Mix4Stereo::RIGHT_INPUT + i, channels);
+    }
+  };
+  b.drive = drive;
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerMix4Stereo);
+
+}
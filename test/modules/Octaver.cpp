@@ -0,0 +1,62 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/Octaver.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::Octaver;
+
+// Octaver at the OVER option index over, mixing every octave of a sine of channels at 220 Hz and up
+Octaver* octaver(int over, int mode = 0, int channels = 1) {
+  Octaver* m = create<Octaver>(modelVenomOctaver);
+  m->params[Octaver::OVER_PARAM].setValue(over);
+  m->params[Octaver::MODE_PARAM].setValue(mode);
+  m->params[Octaver::UP1_PARAM].setValue(0.5f);
+  m->params[Octaver::DRY_PARAM].setValue(0.5f);
+  m->params[Octaver::DOWN1_PARAM].setValue(0.5f);
+  m->params[Octaver::DOWN2_PARAM].setValue(0.3f);
+  m->params[Octaver::DRIVE_PARAM].setValue(2.f);
+  connectOutput(m, Octaver::SIGNAL_OUTPUT);
+  connectInput(m, Octaver::SIGNAL_INPUT, channels);
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  setPoly(m, Octaver::SIGNAL_INPUT, [f](int c) {return sine(220.0 * (1.0 + 0.17 * c), f);});
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, int frames = 1024) {
+  Scenario s;
+  s.name = "Octaver." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = {Octaver::SIGNAL_OUTPUT};
+  s.frames = frames;
+  s.tolerance = 1e-3f;
+  return s;
+}
+
+void registerOctaver() {
+  std::vector<Scenario>& list = scenarios();
+  list.push_back(waveform("x2", [] {return octaver(0);}));
+  list.push_back(waveform("square-x8", [] {return octaver(2, 1);}));
+  list.push_back(waveform("x4-poly5", [] {return octaver(1, 0, 5);}, 512));
+
+  Benchmark b;
+  b.module = "Octaver";
+  b.oversample = {2, 4, 8};
+  b.create = [] {return octaver(0);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[Octaver::OVER_PARAM].setValue(math::log2(over) - 1);
+    connectInput(m, Octaver::SIGNAL_INPUT, channels);
+  };
+  b.drive = drive;
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerOctaver);
+
+}
@@ -0,0 +1,194 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include <thread>
+#include "../../src/Oscillator.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::Oscillator;
+
+// VCO Lab in audio frequency mode with all outputs patched and a mono V/Oct input at freq.
+// over is the OVER option index, and the anti-aliasing method is DPW unless blep, table or naive is set.
+Oscillator* vco(int over, float freq, bool blep = false, bool table = false, bool naive = false) {
+  Oscillator* m = create<Oscillator>(modelVenomOscillator);
+  m->polyBLEP = blep;
+  m->disableDPW = naive;
+  m->setWavetable(table);
+  // The tables are built by a background thread, and the oscillator computes the shapes until they are ready
+  for (int w : {SIN, TRI, SAW}) {
+    while (table && !Oscillator::shapeTables().get(w*8))
+      std::this_thread::yield();
+  }
+  m->setMode();
+  m->params[Oscillator::OVER_PARAM].setValue(over);
+  for (int o=0; o<Oscillator::OUTPUTS_LEN; o++)
+    connectOutput(m, o);
+  connectInput(m, Oscillator::VOCT_INPUT);
+  m->inputs[Oscillator::VOCT_INPUT].setVoltage(voct(freq));
+  return m;
+}
+
+void driveSync(Module* m, int64_t f) {
+  m->inputs[Oscillator::SYNC_INPUT].setVoltage(square(97.3, f));
+}
+
+void driveRev(Module* m, int64_t f) {
+  m->inputs[Oscillator::REV_INPUT].setVoltage(square(71.9, f));
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, std::vector<int> outputs, int frames = 1024) {
+  Scenario s;
+  s.name = "Oscillator." + name;
+  s.create = create;
+  s.outputs = outputs;
+  s.frames = frames;
+  // DPW differentiates a polynomial of the phase, which amplifies float rounding most at high oversample rates
+  s.tolerance = 3e-2f;
+  return s;
+}
+
+// Saw or square at 1234.5 Hz, whose aliases land at least 55 Hz from any harmonic at every oversample rate
+Scenario aliasing(const std::string& name, int output, float limit, std::function<Module*()> create) {
+  Scenario s;
+  s.name = "Oscillator.alias-" + name;
+  s.kind = Scenario::ALIASING;
+  s.create = create;
+  s.outputs = {output};
+  s.aliasFreq = 1234.5f;
+  s.aliasLimit = limit;
+  s.tolerance = 1.f;
+  return s;
+}
+
+void registerOscillator() {
+  const std::vector<int> all = {Oscillator::SIN_OUTPUT, Oscillator::TRI_OUTPUT, Oscillator::SQR_OUTPUT,
+                                Oscillator::SAW_OUTPUT, Oscillator::MIX_OUTPUT};
+  std::vector<Scenario>& list = scenarios();
+
+  list.push_back(waveform("dpw-x4", [] {return vco(2, 220.f);}, all));
+
+  list.push_back(waveform("shapes-x2", [] {
+    Oscillator* m = vco(1, 330.f);
+    m->params[Oscillator::SINSHP_PARAM].setValue(2.f);
+    m->params[Oscillator::TRISHP_PARAM].setValue(5.f);
+    m->params[Oscillator::PW_PARAM].setValue(2.f);
+    m->params[Oscillator::SAWSHP_PARAM].setValue(5.f);
+    m->params[Oscillator::MIXSHP_PARAM].setValue(1.f);
+    m->params[Oscillator::SIN_SHAPE_PARAM].setValue(0.5f);
+    m->params[Oscillator::TRI_SHAPE_PARAM].setValue(-0.3f);
+    m->params[Oscillator::SQR_SHAPE_PARAM].setValue(0.4f);
+    m->params[Oscillator::SAW_SHAPE_PARAM].setValue(0.6f);
+    m->params[Oscillator::SAW_SHAPE_AMT_PARAM].setValue(0.5f);
+    m->params[Oscillator::TRI_PHASE_PARAM].setValue(0.25f);
+    connectInput(m, Oscillator::SAW_SHAPE_INPUT);
+    return m;
+  }, all));
+  list.back().drive = [](Module* m, int64_t f) {
+    m->inputs[Oscillator::SAW_SHAPE_INPUT].setVoltage(sine(23.f, f));
+  };
+
+  list.push_back(waveform("poly8-fm-x4", [] {
+    Oscillator* m = vco(2, 220.f);
+    connectInput(m, Oscillator::VOCT_INPUT, 8);
+    setPoly(m, Oscillator::VOCT_INPUT, [](int c) {return voct(110.0 * (c + 1) * 1.01);});
+    connectInput(m, Oscillator::EXP_INPUT, 8);
+    m->params[Oscillator::EXP_PARAM].setValue(0.3f);
+    connectInput(m, Oscillator::LIN_INPUT, 8);
+    m->params[Oscillator::LIN_PARAM].setValue(0.2f);
+    return m;
+  }, {Oscillator::SAW_OUTPUT, Oscillator::MIX_OUTPUT}, 512));
+  list.back().drive = [](Module* m, int64_t f) {
+    setPoly(m, Oscillator::EXP_INPUT, [f](int c) {return sine(150.0 + 40.0 * c, f);});
+    setPoly(m, Oscillator::LIN_INPUT, [f](int c) {return saw(90.0 + 13.0 * c, f);});
+  };
+
+  list.push_back(waveform("dpw-sync-x1", [] {
+    Oscillator* m = vco(0, 440.f);
+    connectInput(m, Oscillator::SYNC_INPUT);
+    return m;
+  }, all));
+  list.back().drive = driveSync;
+
+  list.push_back(waveform("blep-sync-x1", [] {
+    Oscillator* m = vco(0, 440.f, true);
+    connectInput(m, Oscillator::SYNC_INPUT);
+    return m;
+  }, all));
+  list.back().drive = driveSync;
+
+  list.push_back(waveform("blep-rev-x2", [] {
+    Oscillator* m = vco(1, 440.f, true);
+    connectInput(m, Oscillator::REV_INPUT);
+    return m;
+  }, all));
+  list.back().drive = driveRev;
+
+  list.push_back(waveform("table-x1", [] {return vco(0, 880.f, true, true);}, all));
+
+  list.push_back(waveform("table-sync-x1", [] {
+    Oscillator* m = vco(0, 440.f, true, true);
+    connectInput(m, Oscillator::SYNC_INPUT);
+    return m;
+  }, all));
+  list.back().drive = driveSync;
+
+  list.push_back(waveform("lfo", [] {
+    Oscillator* m = create<Oscillator>(modelVenomOscillator);
+    m->params[Oscillator::MODE_PARAM].setValue(1.f);
+    m->params[Oscillator::FREQ_PARAM].setValue(3.f);
+    for (int o=0; o<Oscillator::OUTPUTS_LEN; o++)
+      connectOutput(m, o);
+    return m;
+  }, all));
+
+  list.push_back(waveform("oneshot-x2", [] {
+    Oscillator* m = create<Oscillator>(modelVenomOscillator);
+    m->params[Oscillator::MODE_PARAM].setValue(4.f);
+    m->setMode();
+    m->params[Oscillator::OVER_PARAM].setValue(1.f);
+    m->params[Oscillator::OCTAVE_PARAM].setValue(1.f);
+    for (int o=0; o<Oscillator::OUTPUTS_LEN; o++)
+      connectOutput(m, o);
+    connectInput(m, Oscillator::SYNC_INPUT);
+    return m;
+  }, all));
+  list.back().drive = [](Module* m, int64_t f) {
+    m->inputs[Oscillator::SYNC_INPUT].setVoltage(square(41.f, f, 48000.f, 0.5));
+  };
+
+  list.push_back(aliasing("saw-naive-x1", Oscillator::SAW_OUTPUT, -23.f, [] {return vco(0, 1234.5f, false, false, true);}));
+  list.push_back(aliasing("saw-dpw-x1", Oscillator::SAW_OUTPUT, -32.f, [] {return vco(0, 1234.5f);}));
+  list.push_back(aliasing("saw-blep-x1", Oscillator::SAW_OUTPUT, -32.f, [] {return vco(0, 1234.5f, true);}));
+  list.push_back(aliasing("saw-table-x1", Oscillator::SAW_OUTPUT, -66.f, [] {return vco(0, 1234.5f, true, true);}));
+  // Synced to a 411.5 Hz sine, so that the output repeats at a third of 1234.5 Hz
+  list.push_back(aliasing("saw-table-sync-x1", Oscillator::SAW_OUTPUT, -41.f, [] {
+    Oscillator* m = vco(0, 975.3f, true, true);
+    connectInput(m, Oscillator::SYNC_INPUT);
+    return m;
+  }));
+  list.back().aliasFreq = 411.5f;
+  list.back().drive = [](Module* m, int64_t f) {
+    m->inputs[Oscillator::SYNC_INPUT].setVoltage(sine(411.5, f));
+  };
+  list.push_back(aliasing("saw-dpw-x4", Oscillator::SAW_OUTPUT, -48.f, [] {return vco(2, 1234.5f);}));
+  list.push_back(aliasing("sqr-blep-x1", Oscillator::SQR_OUTPUT, -33.f, [] {return vco(0, 1234.5f, true);}));
+  list.push_back(aliasing("sqr-dpw-x4", Oscillator::SQR_OUTPUT, -52.f, [] {return vco(2, 1234.5f);}));
+
+  Benchmark b;
+  b.module = "Oscillator";
+  b.oversample = {1, 2, 4, 8, 16, 32};
+  b.create = [] {return vco(0, 220.f);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[Oscillator::OVER_PARAM].setValue(math::log2(over));
+    connectInput(m, Oscillator::VOCT_INPUT, channels);
+    setPoly(m, Oscillator::VOCT_INPUT, [](int c) {return voct(110.0 * (1.0 + 0.13 * c));});
+  };
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerOscillator);
+
+}
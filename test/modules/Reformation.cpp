@@ -0,0 +1,63 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/Reformation.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::Reformation;
+
+// Reformation at the OVER option index over (Off, x4, x8) with soft audio clipping and a bent transfer map,
+// reshaping a bipolar sine of channels at 220 Hz and up
+Reformation* reformation(int over, int channels = 1) {
+  Reformation* m = create<Reformation>(modelVenomReformation);
+  m->params[Reformation::OVER_PARAM].setValue(over);
+  m->params[Reformation::CLIP_PARAM].setValue(2.f);
+  m->params[Reformation::IN_PARAM].setValue(1.f);
+  m->params[Reformation::OUT_PARAM].setValue(1.f);
+  m->params[Reformation::DRIVE_PARAM].setValue(4.f);
+  m->params[Reformation::MAP_PARAM + 1].setValue(0.9f);
+  m->params[Reformation::MAP_PARAM + 3].setValue(0.1f);
+  connectOutput(m, Reformation::OUT_OUTPUT);
+  connectInput(m, Reformation::IN_INPUT, channels);
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  setPoly(m, Reformation::IN_INPUT, [f](int c) {return sine(220.0 * (1.0 + 0.23 * c), f);});
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, int frames = 1024) {
+  Scenario s;
+  s.name = "Reformation." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = {Reformation::OUT_OUTPUT};
+  s.frames = frames;
+  s.tolerance = 1e-3f;
+  return s;
+}
+
+void registerReformation() {
+  std::vector<Scenario>& list = scenarios();
+  list.push_back(waveform("x1", [] {return reformation(0);}));
+  list.push_back(waveform("x8", [] {return reformation(2);}));
+  list.push_back(waveform("x4-poly7", [] {return reformation(1, 7);}, 512));
+
+  Benchmark b;
+  b.module = "Reformation";
+  b.oversample = {1, 4, 8};
+  b.create = [] {return reformation(0);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[Reformation::OVER_PARAM].setValue(over > 1 ? math::log2(over) - 1 : 0);
+    connectInput(m, Reformation::IN_INPUT, channels);
+  };
+  b.drive = drive;
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerReformation);
+
+}
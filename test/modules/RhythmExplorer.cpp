@@ -0,0 +1,68 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/RhythmExplorer.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::RhythmExplorer;
+
+// Rhythm Explorer running from a fast 24 PPQN clock with a fixed seed and mixed densities, so that the
+// random patterns and phrase logic advance through many bars in a short render
+RhythmExplorer* explorer(bool bipolar) {
+  RhythmExplorer* m = create<RhythmExplorer>(modelVenomRhythmExplorer);
+  m->params[RhythmExplorer::POLAR_PARAM].setValue(bipolar);
+  for (int i=0; i<SLIDER_COUNT; i++)
+    m->params[RhythmExplorer::DENSITY_PARAM + i].setValue(1.f + i);
+  for (int o : {RhythmExplorer::GATE_POLY_OUTPUT, RhythmExplorer::CLOCK_POLY_OUTPUT, RhythmExplorer::GATE_OR_OUTPUT,
+                RhythmExplorer::GATE_XOR_ODD_OUTPUT, RhythmExplorer::START_OF_BAR_OUTPUT})
+    connectOutput(m, o);
+  connectInput(m, RhythmExplorer::CLOCK_INPUT);
+  connectInput(m, RhythmExplorer::RUN_GATE_INPUT);
+  connectInput(m, RhythmExplorer::SEED_INPUT);
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  m->inputs[RhythmExplorer::SEED_INPUT].setVoltage(3.1415f);
+  m->inputs[RhythmExplorer::RUN_GATE_INPUT].setVoltage(f >= 10 ? 10.f : 0.f);
+  m->inputs[RhythmExplorer::CLOCK_INPUT].setVoltage(square(4800.0, f) + 5.f);
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create) {
+  Scenario s;
+  s.name = "RhythmExplorer." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = {RhythmExplorer::GATE_POLY_OUTPUT, RhythmExplorer::GATE_OR_OUTPUT,
+               RhythmExplorer::START_OF_BAR_OUTPUT};
+  s.frames = 2400;
+  return s;
+}
+
+void registerRhythmExplorer() {
+  std::vector<Scenario>& list = scenarios();
+  // Dice the pattern from the seed input before the run gate starts
+  list.push_back(waveform("unipolar", [] {return explorer(false);}));
+  list.push_back(waveform("bipolar", [] {return explorer(true);}));
+  for (Scenario* s : {&list[list.size() - 2], &list.back()})
+    s->drive = [](Module* m, int64_t f) {
+      drive(m, f);
+      m->inputs[RhythmExplorer::NEW_SEED_TRIGGER_INPUT].setVoltage(f == 2 ? 10.f : 0.f);
+    };
+
+  // Gates only, no oversampling or polyphony
+  Benchmark b;
+  b.module = "RhythmExplorer";
+  b.channels = {1};
+  b.create = [] {return explorer(false);};
+  b.setup = [](Module* m, int over, int channels) {};
+  b.drive = drive;
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerRhythmExplorer);
+
+}
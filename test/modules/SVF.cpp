@@ -0,0 +1,89 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/SVF.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::SVF;
+
+// Multimode Filter with the given core (0 Chamberlin, 1 zero delay feedback) and slope index, fed a saw of
+// channels at 110 Hz and up on the left input, and a square on the right input unless mono.
+SVF* filter(int core, int slope, int channels = 1, bool mono = false) {
+  SVF* m = create<SVF>(modelVenomSVF);
+  m->filterCore = core;
+  m->params[SVF::SLOPE_PARAM].setValue(slope);
+  m->params[SVF::FREQ_PARAM].setValue(1.5f);
+  m->params[SVF::RES_PARAM].setValue(0.6f);
+  for (int o=0; o<SVF::OUTPUTS_LEN; o++)
+    connectOutput(m, o);
+  connectInput(m, SVF::L_INPUT, channels);
+  if (!mono)
+    connectInput(m, SVF::R_INPUT, channels);
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  setPoly(m, SVF::L_INPUT, [f](int c) {return saw(110.0 * (1.0 + 0.31 * c), f);});
+  setPoly(m, SVF::R_INPUT, [f](int c) {return square(82.5 * (1.0 + 0.17 * c), f);});
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, std::vector<int> outputs, int frames = 1024) {
+  Scenario s;
+  s.name = "SVF." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = outputs;
+  s.frames = frames;
+  s.tolerance = 3e-3f;
+  return s;
+}
+
+void registerSVF() {
+  const std::vector<int> left = {SVF::L_MORPH_OUTPUT, SVF::L_LOW_OUTPUT, SVF::L_HIGH_OUTPUT, SVF::L_BAND_OUTPUT,
+                                 SVF::L_NOTCH_OUTPUT};
+  std::vector<Scenario>& list = scenarios();
+
+  list.push_back(waveform("chamberlin-12db", [] {return filter(0, 0);}, left));
+  list.push_back(waveform("chamberlin-48db-stereo", [] {
+    SVF* m = filter(0, 3);
+    m->params[SVF::SPREAD_PARAM].setValue(0.5f);
+    return m;
+  }, {SVF::L_MORPH_OUTPUT, SVF::R_MORPH_OUTPUT, SVF::L_LOW_OUTPUT, SVF::R_HIGH_OUTPUT}));
+  list.push_back(waveform("tpt-24db", [] {return filter(1, 1);}, left));
+  list.push_back(waveform("tpt-96db-fdbk-sweep", [] {
+    SVF* m = filter(1, 7);
+    m->params[SVF::FDBK_PARAM].setValue(-3.f);
+    m->params[SVF::FREQ_CV_PARAM].setValue(0.5f);
+    connectInput(m, SVF::FREQ_CV_INPUT);
+    return m;
+  }, left));
+  list.back().drive = [](Module* m, int64_t f) {
+    drive(m, f);
+    m->inputs[SVF::FREQ_CV_INPUT].setVoltage(sine(7.0, f));
+  };
+  list.push_back(waveform("chamberlin-mono-poly8", [] {return filter(0, 1, 8, true);},
+                          {SVF::L_MORPH_OUTPUT, SVF::R_MORPH_OUTPUT}, 512));
+  list.push_back(waveform("tpt-mono-poly8", [] {return filter(1, 1, 8, true);},
+                          {SVF::L_MORPH_OUTPUT, SVF::R_MORPH_OUTPUT}, 512));
+
+  // No OVER option: the Chamberlin core always oversamples the audio range by 4
+  for (int core=0; core<2; core++) {
+    Benchmark b;
+    b.module = core ? "SVF-tpt" : "SVF-chamberlin";
+    b.oversample = {core ? 1 : 4};
+    b.create = [core] {return filter(core, 1);};
+    b.setup = [](Module* m, int over, int channels) {
+      connectInput(m, SVF::L_INPUT, channels);
+      connectInput(m, SVF::R_INPUT, channels);
+    };
+    b.drive = drive;
+    benchmarks().push_back(b);
+  }
+}
+
+Registrar registrar(registerSVF);
+
+}
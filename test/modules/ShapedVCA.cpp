@@ -0,0 +1,67 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/ShapedVCA.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::ShapedVCA;
+
+// Shaped VCA at the OVER option index over (Off, x4, x8, x16, x32) with a bipolar range and soft clipping,
+// amplifying a stereo pair of sines of channels by a 30 Hz sine
+ShapedVCA* vca(int over, int channels = 1) {
+  ShapedVCA* m = create<ShapedVCA>(modelVenomShapedVCA);
+  m->params[ShapedVCA::OVER_PARAM].setValue(over);
+  m->params[ShapedVCA::RANGE_PARAM].setValue(4.f);
+  m->params[ShapedVCA::MODE_PARAM].setValue(1.f);
+  m->params[ShapedVCA::CLIP_PARAM].setValue(2.f);
+  m->params[ShapedVCA::CURVE_PARAM].setValue(0.5f);
+  connectOutput(m, ShapedVCA::LEFT_OUTPUT);
+  connectOutput(m, ShapedVCA::RIGHT_OUTPUT);
+  connectInput(m, ShapedVCA::LEFT_INPUT, channels);
+  connectInput(m, ShapedVCA::RIGHT_INPUT, channels);
+  connectInput(m, ShapedVCA::LEVEL_INPUT, channels);
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  setPoly(m, ShapedVCA::LEFT_INPUT, [f](int c) {return sine(440.0 * (1.0 + 0.11 * c), f);});
+  setPoly(m, ShapedVCA::RIGHT_INPUT, [f](int c) {return saw(330.0 * (1.0 + 0.11 * c), f);});
+  setPoly(m, ShapedVCA::LEVEL_INPUT, [f](int c) {return 2.f * sine(30.0 + c, f);});
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, int frames = 1024) {
+  Scenario s;
+  s.name = "ShapedVCA." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = {ShapedVCA::LEFT_OUTPUT, ShapedVCA::RIGHT_OUTPUT};
+  s.frames = frames;
+  s.tolerance = 1e-3f;
+  return s;
+}
+
+void registerShapedVCA() {
+  std::vector<Scenario>& list = scenarios();
+  list.push_back(waveform("x1", [] {return vca(0);}));
+  list.push_back(waveform("x8", [] {return vca(2);}));
+  list.push_back(waveform("x4-poly6", [] {return vca(1, 6);}, 512));
+
+  Benchmark b;
+  b.module = "ShapedVCA";
+  b.oversample = {1, 4, 8, 16, 32};
+  b.create = [] {return vca(0);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[ShapedVCA::OVER_PARAM].setValue(over > 1 ? math::log2(over) - 1 : 0);
+    for (int i : {ShapedVCA::LEFT_INPUT, ShapedVCA::RIGHT_INPUT, ShapedVCA::LEVEL_INPUT})
+      connectInput(m, i, channels);
+  };
+  b.drive = drive;
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerShapedVCA);
+
+}
@@ -0,0 +1,76 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/VCAMix4Stereo.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::VCAMix4Stereo;
+
+// VCA Mix 4 Stereo with the given VCA mode and clip option, mixing three stereo pairs of channels, each
+// amplified by a slow sine CV
+VCAMix4Stereo* mixer(int vcaMode, int clip, int channels = 1) {
+  VCAMix4Stereo* m = create<VCAMix4Stereo>(modelVenomVCAMix4Stereo);
+  m->params[VCAMix4Stereo::VCAMODE_PARAM].setValue(vcaMode);
+  m->params[VCAMix4Stereo::CLIP_PARAM].setValue(clip);
+  m->params[VCAMix4Stereo::DCBLOCK_PARAM].setValue(1.f);
+  connectOutput(m, VCAMix4Stereo::LEFT_MIX_OUTPUT);
+  connectOutput(m, VCAMix4Stereo::RIGHT_MIX_OUTPUT);
+  connectOutput(m, VCAMix4Stereo::LEFT_OUTPUTS + 1);
+  for (int i=0; i<3; i++) {
+    connectInput(m, VCAMix4Stereo::LEFT_INPUTS + i, channels);
+    connectInput(m, VCAMix4Stereo::RIGHT_INPUTS + i, channels);
+    connectInput(m, VCAMix4Stereo::CV_INPUTS + i, channels);
+  }
+  connectInput(m, VCAMix4Stereo::MIX_CV_INPUT);
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  for (int i=0; i<3; i++) {
+    double freq = 110.0 * (i + 1.5);
+    setPoly(m, VCAMix4Stereo::LEFT_INPUTS + i, [f, freq](int c) {return sine(freq * (1.0 + 0.07 * c), f);});
+    setPoly(m, VCAMix4Stereo::RIGHT_INPUTS + i, [f, freq](int c) {return saw(freq * (1.0 + 0.07 * c), f);});
+    setPoly(m, VCAMix4Stereo::CV_INPUTS + i, [f, i](int c) {return sine(9.0 + 3.0 * i + c, f) + 5.f;});
+  }
+  m->inputs[VCAMix4Stereo::MIX_CV_INPUT].setVoltage(sine(2.0, f) + 6.f);
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, int frames = 1024) {
+  Scenario s;
+  s.name = "VCAMix4Stereo." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = {VCAMix4Stereo::LEFT_MIX_OUTPUT, VCAMix4Stereo::RIGHT_MIX_OUTPUT, VCAMix4Stereo::LEFT_OUTPUTS + 1};
+  s.frames = frames;
+  s.tolerance = 1e-3f;
+  return s;
+}
+
+void registerVCAMix4Stereo() {
+  std::vector<Scenario>& list = scenarios();
+  list.push_back(waveform("linear", [] {return mixer(0, 0);}));
+  list.push_back(waveform("exp-soft-clip-x4", [] {return mixer(1, 3);}));
+  list.push_back(waveform("bandlimited-poly5", [] {return mixer(4, 2, 5);}, 512));
+
+  // The oversampled clip options are fixed at x4
+  Benchmark b;
+  b.module = "VCAMix4Stereo";
+  b.oversample = {4};
+  b.create = [] {return mixer(5, 3);};
+  b.setup = [](Module* m, int over, int channels) {
+    for (int i=0; i<3; i++) {
+      connectInput(m, VCAMix4Stereo::LEFT_INPUTS + i, channels);
+      connectInput(m, VCAMix4Stereo::RIGHT_INPUTS + i, channels);
+      connectInput(m, VCAMix4Stereo::CV_INPUTS + i, channels);
+    }
+  };
+  b.drive = drive;
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerVCAMix4Stereo);
+
+}
@@ -0,0 +1,108 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/VCOUnit.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::VCOUnit;
+
+// VCO Unit in audio frequency mode playing wave (0 sine to 3 saw) with a V/Oct input of channels at freq and up.
+// over is the OVER option index, and the anti-aliasing method is DPW unless blep is set.
+VCOUnit* vco(int wave, int over, float freq, int channels = 1, bool blep = false) {
+  VCOUnit* m = create<VCOUnit>(modelVenomVCOUnit);
+  m->polyBLEP = blep;
+  m->params[VCOUnit::WAVE_PARAM].setValue(wave);
+  m->setMode();
+  m->params[VCOUnit::OVER_PARAM].setValue(over);
+  connectOutput(m, VCOUnit::OUTPUT);
+  connectInput(m, VCOUnit::VOCT_INPUT, channels);
+  setPoly(m, VCOUnit::VOCT_INPUT, [freq](int c) {return voct(freq * (1.0 + 0.26 * c));});
+  return m;
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, int frames = 1024) {
+  Scenario s;
+  s.name = "VCOUnit." + name;
+  s.create = create;
+  s.outputs = {VCOUnit::OUTPUT};
+  s.frames = frames;
+  // DPW differentiates a polynomial of the phase, which amplifies float rounding most at high oversample rates
+  s.tolerance = 3e-2f;
+  return s;
+}
+
+Scenario aliasing(const std::string& name, float limit, std::function<Module*()> create) {
+  Scenario s;
+  s.name = "VCOUnit.alias-" + name;
+  s.kind = Scenario::ALIASING;
+  s.create = create;
+  s.outputs = {VCOUnit::OUTPUT};
+  s.aliasFreq = 1234.5f;
+  s.aliasLimit = limit;
+  s.tolerance = 1.f;
+  return s;
+}
+
+void registerVCOUnit() {
+  std::vector<Scenario>& list = scenarios();
+
+  list.push_back(waveform("sin-x4", [] {return vco(0, 2, 220.f);}));
+  list.push_back(waveform("tri-shape-x2", [] {
+    VCOUnit* m = vco(1, 1, 330.f);
+    m->params[VCOUnit::SHAPE_MODE_PARAM].setValue(5.f);
+    m->params[VCOUnit::SHAPE_PARAM].setValue(0.4f);
+    m->params[VCOUnit::PHASE_PARAM].setValue(0.3f);
+    return m;
+  }));
+  list.push_back(waveform("saw-poly4-fm-x4", [] {
+    VCOUnit* m = vco(3, 2, 110.f, 4);
+    connectInput(m, VCOUnit::EXP_INPUT, 4);
+    m->params[VCOUnit::EXP_PARAM].setValue(0.25f);
+    return m;
+  }, 512));
+  list.back().drive = [](Module* m, int64_t f) {
+    setPoly(m, VCOUnit::EXP_INPUT, [f](int c) {return sine(170.0 + 30.0 * c, f);});
+  };
+  list.push_back(waveform("sqr-blep-sync-x1", [] {
+    VCOUnit* m = vco(2, 0, 440.f, 1, true);
+    connectInput(m, VCOUnit::SYNC_INPUT);
+    return m;
+  }));
+  list.back().drive = [](Module* m, int64_t f) {
+    m->inputs[VCOUnit::SYNC_INPUT].setVoltage(square(97.3, f));
+  };
+  list.push_back(waveform("saw-unison5-x2", [] {
+    VCOUnit* m = vco(3, 1, 220.f, 2);
+    m->unisonCopies = 5;
+    return m;
+  }, 512));
+  // 7 copies leave room for 9 of the 12 input voices
+  list.push_back(waveform("saw-unison7-poly12-x1", [] {
+    VCOUnit* m = vco(3, 0, 110.f, 12);
+    m->unisonCopies = 7;
+    m->unisonDetune = 1;
+    return m;
+  }, 512));
+
+  list.push_back(aliasing("saw-dpw-x1", -32.f, [] {return vco(3, 0, 1234.5f);}));
+  list.push_back(aliasing("saw-blep-x1", -32.f, [] {return vco(3, 0, 1234.5f, 1, true);}));
+  list.push_back(aliasing("saw-dpw-x4", -48.f, [] {return vco(3, 2, 1234.5f);}));
+
+  Benchmark b;
+  b.module = "VCOUnit";
+  b.oversample = {1, 2, 4, 8, 16, 32};
+  b.create = [] {return vco(3, 0, 110.f);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[VCOUnit::OVER_PARAM].setValue(math::log2(over));
+    connectInput(m, VCOUnit::VOCT_INPUT, channels);
+    setPoly(m, VCOUnit::VOCT_INPUT, [](int c) {return voct(110.0 * (1.0 + 0.13 * c));});
+  };
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerVCOUnit);
+
+}
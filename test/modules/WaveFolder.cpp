@@ -0,0 +1,93 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/WaveFolder.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::WaveFolder;
+
+// Wave Folder with the OVER option index over and ADAA order adaa, folding a sine of channels at freq and up
+WaveFolder* folder(int over, int adaa, int channels = 1) {
+  WaveFolder* m = create<WaveFolder>(modelVenomWaveFolder);
+  m->params[WaveFolder::OVER_PARAM].setValue(over);
+  m->params[WaveFolder::PRE_PARAM].setValue(3.f);
+  m->params[WaveFolder::BIAS_PARAM].setValue(0.7f);
+  m->adaa = adaa;
+  connectOutput(m, WaveFolder::POLY_OUTPUT);
+  connectInput(m, WaveFolder::POLY_INPUT, channels);
+  return m;
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, double freq, int frames = 1024) {
+  Scenario s;
+  s.name = "WaveFolder." + name;
+  s.create = create;
+  s.drive = [freq](Module* m, int64_t f) {
+    setPoly(m, WaveFolder::POLY_INPUT, [freq, f](int c) {return sine(freq * (1.0 + 0.21 * c), f);});
+  };
+  s.outputs = {WaveFolder::POLY_OUTPUT};
+  s.frames = frames;
+  s.tolerance = 1e-3f;
+  return s;
+}
+
+Scenario aliasing(const std::string& name, float limit, std::function<Module*()> create) {
+  Scenario s = waveform(name, create, 1234.5);
+  s.name = "WaveFolder.alias-" + name;
+  s.kind = Scenario::ALIASING;
+  s.aliasFreq = 1234.5f;
+  s.aliasLimit = limit;
+  s.tolerance = 1.f;
+  return s;
+}
+
+void registerWaveFolder() {
+  std::vector<Scenario>& list = scenarios();
+
+  list.push_back(waveform("x1", [] {return folder(0, 0);}, 220.0));
+  list.push_back(waveform("x4", [] {return folder(2, 0);}, 220.0));
+  list.push_back(waveform("adaa1-x1", [] {return folder(0, 1);}, 220.0));
+  list.push_back(waveform("adaa2-x2-poly6", [] {return folder(1, 2, 6);}, 150.0, 512));
+  // Second order ADAA switched on mid-stream starts from the input history instead of zeros
+  list.push_back(waveform("adaa-on-x1", [] {return folder(0, 0);}, 220.0));
+  list.back().drive = [](Module* m, int64_t f) {
+    m->inputs[WaveFolder::POLY_INPUT].setVoltage(sine(220.0, f));
+    static_cast<WaveFolder*>(m)->adaa = f < 500 ? 0 : 2;
+  };
+  list.push_back(waveform("stage-cv-x2", [] {
+    WaveFolder* m = folder(1, 0);
+    m->params[WaveFolder::STAGES_PARAM].setValue(4.f);
+    m->params[WaveFolder::STAGE_AMT_PARAM].setValue(0.4f);
+    connectInput(m, WaveFolder::STAGE_INPUT);
+    return m;
+  }, 330.0));
+  list.back().drive = [](Module* m, int64_t f) {
+    m->inputs[WaveFolder::POLY_INPUT].setVoltage(sine(330.0, f));
+    m->inputs[WaveFolder::STAGE_INPUT].setVoltage(sine(11.0, f));
+  };
+
+  list.push_back(aliasing("x1", -29.f, [] {return folder(0, 0);}));
+  list.push_back(aliasing("adaa1-x1", -34.f, [] {return folder(0, 1);}));
+  list.push_back(aliasing("adaa2-x1", -38.f, [] {return folder(0, 2);}));
+  list.push_back(aliasing("x4", -57.f, [] {return folder(2, 0);}));
+
+  Benchmark b;
+  b.module = "WaveFolder";
+  b.oversample = {1, 2, 4, 8, 16, 32};
+  b.create = [] {return folder(0, 0);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[WaveFolder::OVER_PARAM].setValue(math::log2(over));
+    connectInput(m, WaveFolder::POLY_INPUT, channels);
+  };
+  b.drive = [](Module* m, int64_t f) {
+    setPoly(m, WaveFolder::POLY_INPUT, [f](int c) {return sine(110.0 * (1.0 + 0.13 * c), f);});
+  };
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerWaveFolder);
+
+}
@@ -0,0 +1,87 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/WaveMangler.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::WaveMangler;
+
+// Wave Mangler with the OVER option index over and ADAA order adaa, shaping a sine of channels at freq and up
+// with asymmetric high and low amplifiers and thresholds
+WaveMangler* mangler(int over, int adaa, int channels = 1) {
+  WaveMangler* m = create<WaveMangler>(modelVenomWaveMangler);
+  m->params[WaveMangler::OVER_PARAM].setValue(over);
+  m->params[WaveMangler::HI_THRESH_PARAM].setValue(2.f);
+  m->params[WaveMangler::HI_AMP_PARAM].setValue(-3.f);
+  m->params[WaveMangler::MID_AMP_PARAM].setValue(1.5f);
+  m->params[WaveMangler::LO_THRESH_PARAM].setValue(-1.f);
+  m->params[WaveMangler::LO_AMP_PARAM].setValue(4.f);
+  m->params[WaveMangler::CLIP_PARAM].setValue(2.f);
+  m->adaa = adaa;
+  connectOutput(m, WaveMangler::WAVE_OUTPUT);
+  connectInput(m, WaveMangler::WAVE_INPUT, channels);
+  return m;
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, double freq, int frames = 1024) {
+  Scenario s;
+  s.name = "WaveMangler." + name;
+  s.create = create;
+  s.drive = [freq](Module* m, int64_t f) {
+    setPoly(m, WaveMangler::WAVE_INPUT, [freq, f](int c) {return sine(freq * (1.0 + 0.21 * c), f);});
+  };
+  s.outputs = {WaveMangler::WAVE_OUTPUT};
+  s.frames = frames;
+  s.tolerance = 1e-3f;
+  return s;
+}
+
+Scenario aliasing(const std::string& name, float limit, std::function<Module*()> create) {
+  Scenario s = waveform(name, create, 1234.5);
+  s.name = "WaveMangler.alias-" + name;
+  s.kind = Scenario::ALIASING;
+  s.aliasFreq = 1234.5f;
+  s.aliasLimit = limit;
+  s.tolerance = 1.f;
+  return s;
+}
+
+void registerWaveMangler() {
+  std::vector<Scenario>& list = scenarios();
+
+  list.push_back(waveform("x1", [] {return mangler(0, 0);}, 220.0));
+  list.push_back(waveform("x8", [] {return mangler(3, 0);}, 220.0));
+  list.push_back(waveform("adaa1-x1", [] {return mangler(0, 1);}, 220.0));
+  list.push_back(waveform("adaa2-x2-poly6", [] {return mangler(1, 2, 6);}, 150.0, 512));
+  // Second order ADAA switched on mid-stream starts from the input history instead of zeros
+  list.push_back(waveform("adaa-on-x1", [] {return mangler(0, 0);}, 220.0));
+  list.back().drive = [](Module* m, int64_t f) {
+    m->inputs[WaveMangler::WAVE_INPUT].setVoltage(sine(220.0, f));
+    static_cast<WaveMangler*>(m)->adaa = f < 500 ? 0 : 2;
+  };
+
+  list.push_back(aliasing("x1", -31.f, [] {return mangler(0, 0);}));
+  list.push_back(aliasing("adaa1-x1", -36.f, [] {return mangler(0, 1);}));
+  list.push_back(aliasing("adaa2-x1", -40.f, [] {return mangler(0, 2);}));
+  list.push_back(aliasing("x4", -56.f, [] {return mangler(2, 0);}));
+
+  Benchmark b;
+  b.module = "WaveMangler";
+  b.oversample = {1, 2, 4, 8, 16, 32};
+  b.create = [] {return mangler(0, 0);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[WaveMangler::OVER_PARAM].setValue(math::log2(over));
+    connectInput(m, WaveMangler::WAVE_INPUT, channels);
+  };
+  b.drive = [](Module* m, int64_t f) {
+    setPoly(m, WaveMangler::WAVE_INPUT, [f](int c) {return sine(110.0 * (1.0 + 0.13 * c), f);});
+  };
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerWaveMangler);
+
+}
@@ -0,0 +1,70 @@
+// Venom Modules (c) 2023, 2024 Dave Benham
+// Licensed under GNU GPLv3
+
+#include "harness.hpp"
+#include "../../src/XM_OP.cpp"
+
+namespace {
+
+using namespace VenomTest;
+using Venom::XM_OP;
+
+// XM-OP at the OVER option index over with its envelope gated at 40 Hz, cross modulated by a sine
+XM_OP* op(int over, int channels = 1) {
+  XM_OP* m = create<XM_OP>(modelVenomXM_OP);
+  m->params[XM_OP::OVER_PARAM].setValue(over);
+  m->params[XM_OP::WAVE_PARAM].setValue(0.f);
+  m->params[XM_OP::LEVEL_ENV_PARAM].setValue(1.f);
+  m->params[XM_OP::DEPTH_PARAM].setValue(0.4f);
+  m->params[XM_OP::FDBK_PARAM].setValue(0.2f);
+  m->params[XM_OP::MULT_PARAM].setValue(1.f);
+  m->params[XM_OP::ATK_PARAM].setValue(-8.f);
+  m->params[XM_OP::DEC_PARAM].setValue(-5.f);
+  m->params[XM_OP::REL_PARAM].setValue(-5.f);
+  connectOutput(m, XM_OP::ENV_OUTPUT);
+  connectOutput(m, XM_OP::OSC_OUTPUT);
+  connectInput(m, XM_OP::VOCT_INPUT, channels);
+  setPoly(m, XM_OP::VOCT_INPUT, [](int c) {return voct(220.0 * (1.0 + 0.19 * c));});
+  connectInput(m, XM_OP::GATE_INPUT, channels);
+  connectInput(m, XM_OP::XMOD_INPUT, channels);
+  return m;
+}
+
+void drive(Module* m, int64_t f) {
+  setPoly(m, XM_OP::GATE_INPUT, [f](int c) {return square(40.0, f, 48000.f, 0.1 * c) + 5.f;});
+  setPoly(m, XM_OP::XMOD_INPUT, [f](int c) {return sine(330.0 + 20.0 * c, f);});
+}
+
+Scenario waveform(const std::string& name, std::function<Module*()> create, int frames = 2048) {
+  Scenario s;
+  s.name = "XM_OP." + name;
+  s.create = create;
+  s.drive = drive;
+  s.outputs = {XM_OP::ENV_OUTPUT, XM_OP::OSC_OUTPUT};
+  s.frames = frames;
+  s.tolerance = 2e-3f;
+  return s;
+}
+
+void registerXM_OP() {
+  std::vector<Scenario>& list = scenarios();
+  list.push_back(waveform("x1", [] {return op(0);}));
+  list.push_back(waveform("x4", [] {return op(2);}));
+  list.push_back(waveform("x2-poly4", [] {return op(1, 4);}, 512));
+
+  Benchmark b;
+  b.module = "XM_OP";
+  b.oversample = {1, 2, 4, 8, 16, 32};
+  b.create = [] {return op(0);};
+  b.setup = [](Module* m, int over, int channels) {
+    m->params[XM_OP::OVER_PARAM].setValue(math::log2(over));
+    for (int i : {XM_OP::VOCT_INPUT, XM_OP::GATE_INPUT, XM_OP::XMOD_INPUT})
+      connectInput(m, i, channels);
+  };
+  b.drive = drive;
+  benchmarks().push_back(b);
+}
+
+Registrar registrar(registerXM_OP);
+
+}